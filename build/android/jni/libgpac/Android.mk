@@ -252,6 +252,7 @@ LOCAL_SRC_FILES := \
 	../../../../src/filters/reframer.c \
 	../../../../src/filters/resample_audio.c \
 	../../../../src/filters/restamp.c \
+	../../../../src/filters/psplit.c \
 	../../../../src/filters/rewind.c \
 	../../../../src/filters/rewrite_adts.c \
 	../../../../src/filters/rewrite_mhas.c \
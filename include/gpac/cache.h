@@ -56,6 +56,9 @@ typedef struct __DownloadedCacheEntryStruct * DownloadedCacheEntry;
 /*! cache object*/
 typedef struct __CacheReaderStruct * GF_CacheReader;
 
+/*! cache index object, holding metadata of all entries of an on-disk cache directory*/
+typedef struct __CacheIndexStruct * GF_CacheIndex;
+
 /**
 
 Free The DownloadedCacheEntry handle
@@ -219,6 +222,34 @@ Delete all cached files in given directory starting with startpattern
  */
 GF_Err gf_cache_delete_all_cached_files(const char * directory);
 
+/*!
+Loads the cache index of a cache directory, creating an empty one if none is found. Files in a cache directory without index are deleted. Least recently used entries are evicted if the cache exceeds the maximum size
+\param directory cache directory, including trailing path separator
+\param max_size maximum size in bytes of the cache, 0 means no limit
+\return the new cache index or NULL if error
+ */
+GF_CacheIndex gf_cache_index_new(const char *directory, u64 max_size);
+
+/*!
+Saves and destroys a cache index
+\param index the target cache index
+ */
+void gf_cache_index_del(GF_CacheIndex index);
+
+/*!
+Writes the cache index to disk if modified since last save
+\param index the target cache index
+\return error if any
+ */
+GF_Err gf_cache_index_save(GF_CacheIndex index);
+
+/*!
+Gets the size of all files referenced in the cache index
+\param index the target cache index
+\return size in bytes
+ */
+u64 gf_cache_index_get_size(GF_CacheIndex index);
+
 
 /*!
 
@@ -133,6 +133,31 @@ GF_Err gf_crypt_get_IV(GF_Crypt *gfc, void *iv, u32 *size);
 */
 GF_Err gf_crypt_encrypt(GF_Crypt *gfc, void *plaintext, u32 size);
 
+/*! byte range in a payload*/
+typedef struct
+{
+	/*! offset of the range in the payload*/
+	u32 offset;
+	/*! size of the range*/
+	u32 size;
+} GF_CryptRange;
+
+/*! encrypts a set of ranges of a payload in a single call. The encryption is done inplace.
+Ranges are processed in order and share the same cipher state, i.e. the result is the same as calling \ref gf_crypt_encrypt on each range (and each encrypted block of the pattern) successively.
+
+When both crypt_block and skip_block are not 0, each range is encrypted using a pattern of crypt_block encrypted 16-byte blocks followed by skip_block clear 16-byte blocks; the last pattern may have less than crypt_block blocks.
+
+\param gfc the target crytpo context
+\param data the payload to encrypt
+\param ranges the ranges to encrypt in the payload
+\param nb_ranges the number of ranges
+\param crypt_block number of encrypted blocks in pattern, 0 if no pattern
+\param skip_block number of clear blocks in pattern, 0 if no pattern
+\param const_IV if not NULL, the IV (16 bytes) is reset to this value before each range
+\return error if any
+*/
+GF_Err gf_crypt_encrypt_ranges(GF_Crypt *gfc, u8 *data, const GF_CryptRange *ranges, u32 nb_ranges, u32 crypt_block, u32 skip_block, const u8 *const_IV);
+
 /*! decrypts a payload. The decryption is done inplace (ciphertext is replaced by the plaintext).
  The buffer size should be k*algorithms_block_size if used in a mode which operated in blocks (CBC) or whatever when used in CTR which operate in streams.
 
@@ -143,6 +168,20 @@ GF_Err gf_crypt_encrypt(GF_Crypt *gfc, void *plaintext, u32 size);
 */
 GF_Err gf_crypt_decrypt(GF_Crypt *gfc, void *ciphertext, u32 size);
 
+/*! decrypts a set of ranges of a payload in a single call. The decryption is done inplace.
+This is the counterpart of \ref gf_crypt_encrypt_ranges, with the same semantics for ranges, pattern and constant IV.
+
+\param gfc the target crytpo context
+\param data the payload to decrypt
+\param ranges the ranges to decrypt in the payload
+\param nb_ranges the number of ranges
+\param crypt_block number of encrypted blocks in pattern, 0 if no pattern
+\param skip_block number of clear blocks in pattern, 0 if no pattern
+\param const_IV if not NULL, the IV (16 bytes) is reset to this value before each range
+\return error if any
+*/
+GF_Err gf_crypt_decrypt_ranges(GF_Crypt *gfc, u8 *data, const GF_CryptRange *ranges, u32 nb_ranges, u32 crypt_block, u32 skip_block, const u8 *const_IV);
+
 
 /*! @} */
 
@@ -510,6 +510,17 @@ GF_Err gf_dash_group_get_next_segment_location(GF_DashClient *dash, u32 group_id
         s32 *switching_index, const char **switching_url, u64 *switching_start_range, u64 *switching_end_range,
         const char **original_url, Bool *has_next_segment, const char **key_url, bin128 *key_IV, u64 *utc);
 
+/*! gets the location of a segment already queued for playback, without consuming it. This is typically used to fetch upcoming segments in parallel, see \ref gf_dash_set_prefetch_depth
+\param dash the target dash client
+\param group_idx the 0-based index of the target group
+\param queue_idx the 0-based index in the group queue, 0 being the segment returned by \ref gf_dash_group_get_next_segment_location
+\param url set to the URL of the queued segment
+\param start_range set to the start byte offset in the segment (optional, may be NULL)
+\param end_range set to the end byte offset in the segment (optional, may be NULL). A value of (u64)-1 indicates an open byte range
+\return GF_BUFFER_TOO_SMALL if no segment is queued at this index, GF_URL_REMOVED if segment is disabled, or error if any
+*/
+GF_Err gf_dash_group_get_queued_segment_location(GF_DashClient *dash, u32 group_idx, u32 queue_idx, const char **url, u64 *start_range, u64 *end_range);
+
 /*! gets some info on the segment
 \param dash the target dash client
 \param group_idx the 0-based index of the target group
@@ -782,6 +793,12 @@ Errors will be thrown if these are not met on future parts and merging will be d
 */
 void gf_dash_enable_single_range_llhls(GF_DashClient *dash, Bool enable_single_range);
 
+/*! sets the number of segments to resolve ahead of the segment being played, so that the user may download them in parallel. This must be called before opening the session. Default is 0 (segments are resolved one at a time)
+\param dash the target dash client
+\param nb_segments number of segments to queue ahead of the current one, per group
+*/
+void gf_dash_set_prefetch_depth(GF_DashClient *dash, u32 nb_segments);
+
 /*! create a new DASH client
 \param dash the target dash cleint
 \param auto_switch_count forces representation switching (quality up if positive, down if negative) every auto_switch_count segments, set to 0 to disable
@@ -477,6 +477,16 @@ Sets ID of netcap rules for this session
 \param netcap_id ID of netcap configuration to use, may be null (see gpac -h netcap)
  */
 void gf_dm_sess_set_netcap_id(GF_DownloadSession *sess, const char *netcap_id);
+
+/*!
+\brief sets session priority
+
+Sets the priority of requests issued by the session. When the number of connections per origin is limited (see `-max-conn`), waiting requests with higher priority are sent first. For HTTP/2 sessions, the priority is mapped to the stream weight.
+\param sess the current session
+\param priority request priority, 0 being the lowest (default)
+ */
+void gf_dm_sess_set_priority(GF_DownloadSession *sess, u32 priority);
+
 /*!
 \brief sets download manager max rate per session
 
@@ -667,6 +677,7 @@ void gf_dm_set_data_rate(GF_DownloadManager *dm, u32 rate_in_bits_per_sec);
 GF_DownloadManager *gf_dm_new(GF_DownloadFilterSession *fsess);
 void gf_dm_del(GF_DownloadManager *dm);
 void gf_dm_sess_set_netcap_id(GF_DownloadSession *sess, const char *netcap_id);
+void gf_dm_sess_set_priority(GF_DownloadSession *sess, u32 priority);
 
 
 #endif //GPAC_CONFIG_EMSCRIPTEN
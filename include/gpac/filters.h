@@ -1719,6 +1719,8 @@ typedef struct
 	/*! GF_FEVT_PLAY only, indicates  that a demuxer must not forward this event as a source seek because seek has already been done
 	(typically this play request is a segment play and byte range access within the file has already been performed by DASH client)*/
 	u8 no_byterange_forward;
+	/*! GF_FEVT_PLAY only, indicates the consumer only uses packet properties and sizes, demuxers may skip loading sample data*/
+	u8 no_data;
 
 	/*! GF_FEVT_PLAY only, indicates playback should stop from given packet number - used by GHI when loading sources*/
 	u32 to_pck;
@@ -50,6 +50,8 @@ struct _gf_crypt_context
 	GF_Err(*_decrypt) (GF_Crypt*, u8 *buffer, u32 size);
 	GF_Err(*_set_state) (GF_Crypt*, const u8 *IV, u32 IV_size);
 	GF_Err(*_get_state) (GF_Crypt*, u8 *IV, u32 *IV_size);
+	//optional, batched processing of ranges - if NULL, _crypt/_decrypt is called for each range/pattern block
+	GF_Err(*_crypt_ranges) (GF_Crypt*, u8 *data, const GF_CryptRange *ranges, u32 nb_ranges, u32 crypt_block, u32 skip_block, const u8 *const_IV, Bool decrypt);
 };
 
 #ifdef GPAC_HAS_SSL
@@ -178,6 +178,11 @@ struct __tag_rtp_channel
 
 	GF_BitStream *bs_r, *bs_w;
 	Bool no_select;
+	/*batch reception: datagrams fetched but not yet processed*/
+	u8 *rcv_batch;
+	u32 *rcv_sizes;
+	u32 rcv_nb, rcv_idx;
+	Bool rcv_no_batch;
 
 	gf_rtp_tcp_callback send_interleave;
 	void *interleave_cbk1, *interleave_cbk2;
@@ -24,6 +24,9 @@
   ****************************************************************/
 #ifndef _ECC_H_
 #define _ECC_H_
+
+#include <gpac/tools.h>
+
 #define NPAR 64
 
 /****************************************************************/
@@ -75,4 +78,18 @@ void mult_polys(int dst[], int p1[], int p2[]);
 
 void copy_poly(int dst[], int src[]);
 void zero_poly(int poly[]);
+
+
+/* Systematic erasure code over GF(256) used for application-layer FEC (ROUTE)
+   A source block is made of k source symbols (ESI 0 to k-1) of symbol_size bytes, repair symbols use ESI k to 254 */
+
+/* FEC encoding ID signaling this code - the Cauchy generator matrix is not the one of RFC 5510 (ID 5), an unassigned ID is used */
+#define GF_RS_FEC_ENCODING_ID	255
+
+/* computes the repair symbol with the given ESI for the k source symbols */
+void gf_rs_fec_encode(u8 **src, u32 k, u32 esi, u8 *repair, u32 symbol_size);
+/* recovers source symbols not marked as present using nb_repair repair symbols with the given ESIs - repair symbols are modified
+returns GF_NOT_READY if not enough repair symbols are given */
+GF_Err gf_rs_fec_decode(u8 **src, Bool *present, u32 k, u8 **repair, u32 *esi, u32 nb_repair, u32 symbol_size);
+
 #endif //_ECC_H_
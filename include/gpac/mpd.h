@@ -582,6 +582,8 @@ typedef struct
 	char *hls_key_uri;
 	/*! HLS IV*/
 	bin128 hls_iv;
+	/*! HLS position of the serialized entry in the media playlist cache of the representation*/
+	u64 m3u8_cache_pos;
 } GF_DASH_SegmentContext;
 
 /*! Representation*/
@@ -652,6 +654,16 @@ typedef struct {
 	char *m3u8_var_name;
 	/*! temp file for m3u8 generation*/
 	FILE *m3u8_var_file;
+	/*! serialized entries of completed segments in the HLS media playlist, only appended to between playlist updates - not used for DASH manifests*/
+	char *m3u8_seg_cache;
+	/*! HLS size and allocated size of m3u8_seg_cache*/
+	u32 m3u8_seg_cache_size, m3u8_seg_cache_alloc;
+	/*! HLS position of the first byte of m3u8_seg_cache since cache creation*/
+	u64 m3u8_seg_cache_base;
+	/*! HLS segment number of first and last entries in m3u8_seg_cache*/
+	u32 m3u8_seg_cache_first, m3u8_seg_cache_last;
+	/*! HLS last segment context serialized in m3u8_seg_cache*/
+	const GF_DASH_SegmentContext *m3u8_seg_cache_sctx;
 
 	/*! for m3u8: 0: not encrypted, 1: full segment, 2: CENC*/
 	u8 crypto_type;
@@ -915,6 +927,10 @@ typedef struct {
 	Bool create_m3u8_files;
 	/*! indicates to insert clock reference in variant playlists*/
 	Bool m3u8_time;
+	/*! number of threads used to write variant playlists, playlists are written by the calling thread if 0 or 1*/
+	u32 m3u8_threads;
+	/*! internal pool of threads writing variant playlists, created at first parallel write and destroyed with the MPD*/
+	void *m3u8_pool;
 	/*! indicates  LL-HLS forced generation. 0: regular write, 1: write as byterange, 2: write as independent files*/
 	u32 force_llhls_mode;
 	/*! HLS extensions to append in the master playlist*/
@@ -1565,6 +1565,8 @@ typedef struct __m2ts_mux_stream {
 	u32 pid;
 	/*! CC of the stream*/
 	u8 continuity_counter;
+	/*! TS header template (sync byte and PID), start indicator, AF control and CC are patched per packet*/
+	u8 ts_hdr_tpl[3];
 	/*! parent program*/
 	struct __m2ts_mux_program *program;
 	/*! average stream bit-rate in bit/sec*/
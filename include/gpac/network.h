@@ -663,6 +663,58 @@ Fetches data on a socket without performing any select (wait), to be used with s
  */
 GF_Err gf_sk_receive_no_select(GF_Socket *sock, u8 *buffer, u32 length, u32 *read);
 
+/*!
+Fetches several datagrams on a socket without performing any select (wait), to be used with socket group on sockets that are set in the selected socket group. On Linux, this uses a single recvmmsg call.
+
+Datagram N is written at offset N*slot_size of the reception buffer. Datagrams larger than the slot size are truncated.
+\param sock the socket object
+\param buffer the reception buffer, at least slot_size*nb_slots bytes
+\param slot_size the maximum size of each datagram
+\param nb_slots the maximum number of datagrams to fetch
+\param sizes set to the size of each received datagram, must have at least nb_slots entries. A size may be 0
+\param nb_read set to the number of received datagrams
+\return error if any, GF_IP_NETWORK_EMPTY if nothing to read
+ */
+GF_Err gf_sk_receive_batch(GF_Socket *sock, u8 *buffer, u32 slot_size, u32 nb_slots, u32 *sizes, u32 *nb_read);
+
+/*!
+Sends several buffers on a socket, each buffer being sent as a single datagram for UDP sockets. On Linux, this uses sendmmsg calls. The socket must be in a bound or connected mode
+\param sock the socket object
+\param buffers the data buffers to send
+\param sizes the size of each data buffer
+\param nb_buffers the number of buffers to send
+\param nb_sent set to number of buffers sent - may be NULL
+\return error if any
+ */
+GF_Err gf_sk_send_batch(GF_Socket *sock, const u8 **buffers, const u32 *sizes, u32 nb_buffers, u32 *nb_sent);
+
+/*! socket pacing flags*/
+enum
+{
+	/*! also let the kernel pace the socket (SO_MAX_PACING_RATE on Linux, requires the fq qdisc)*/
+	GF_SK_PACING_KERNEL = 1,
+	/*! set a launch time on each datagram (SO_TXTIME on Linux, requires the fq or etf qdisc). Datagrams are then handed to the kernel slightly ahead of time*/
+	GF_SK_PACING_TXTIME = 1<<1,
+};
+
+/*!
+Sets packet pacing on a socket. A token bucket of burst bytes is filled at the given rate, and each send consumes the bucket. Sending is never blocked by the bucket, callers check \ref gf_sk_pacing_delay before sending.
+\param sock the socket object
+\param rate the pacing rate in bits per second, 0 disables pacing
+\param burst the bucket size in bytes. If 0, defaults to 1 ms of data at the given rate and at least 1500 bytes
+\param flags pacing flags, see GF_SK_PACING_*. Flags not supported by the platform are ignored with a warning
+\return error if any
+ */
+GF_Err gf_sk_set_pacing(GF_Socket *sock, u32 rate, u32 burst, u32 flags);
+
+/*!
+Gets the delay before a given amount of bytes can be sent on a paced socket
+\param sock the socket object
+\param size the number of bytes to send
+\return delay in microseconds, 0 if the bytes can be sent now or if pacing is disabled
+ */
+u32 gf_sk_pacing_delay(GF_Socket *sock, u32 size);
+
 /*!
 Checks if connection has been closed by remote peer
 \param sock the socket object
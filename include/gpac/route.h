@@ -294,6 +294,14 @@ u64 gf_route_dmx_get_nb_packets(GF_ROUTEDmx *routedmx);
  */
 u64 gf_route_dmx_get_recv_bytes(GF_ROUTEDmx *routedmx);
 
+/*! Gets AL-FEC statistics since start of the session, for all active services
+\param routedmx the ROUTE demultiplexer
+\param nb_recovered_objects set to the number of objects completed using repair symbols - may be NULL
+\param nb_recovered_symbols set to the number of source symbols recovered - may be NULL
+\param nb_repair_packets set to the number of repair packets received - may be NULL
+ */
+void gf_route_dmx_get_fec_stats(GF_ROUTEDmx *routedmx, u32 *nb_recovered_objects, u64 *nb_recovered_symbols, u64 *nb_repair_packets);
+
 /*! Gather only  objects with given TSI (for debug purposes)
 \param routedmx the ROUTE demultiplexer
 \param tsi the target TSI, 0 for no filtering
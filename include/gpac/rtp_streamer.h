@@ -299,6 +299,22 @@ GF_Err gf_rtp_streamer_init_rtsp(GF_RTPStreamer *streamer, u32 path_mtu, GF_RTSP
 */
 u16 gf_rtp_streamer_get_next_rtp_sn(GF_RTPStreamer *streamer);
 
+/*! sets packet pacing on the RTP socket of the streamer, see \ref gf_sk_set_pacing. Ignored for RTP over RTSP
+\param streamer the target RTP streamer
+\param rate the pacing rate in bits per second, 0 disables pacing
+\param burst the bucket size in bytes, 0 for default
+\param flags pacing flags, see GF_SK_PACING_*
+\return error if any
+*/
+GF_Err gf_rtp_streamer_set_pacing(GF_RTPStreamer *streamer, u32 rate, u32 burst, u32 flags);
+
+/*! gets the delay before a given amount of bytes can be sent on the RTP socket, see \ref gf_sk_pacing_delay
+\param streamer the target RTP streamer
+\param size the number of bytes to send
+\return delay in microseconds, 0 if no pacing or if bytes can be sent now
+*/
+u32 gf_rtp_streamer_get_pacing_delay(GF_RTPStreamer *streamer, u32 size);
+
 /*! sets callback functions for RTP over RTSP sending
 \param streamer the target RTP streamer
 \param RTP_TCPCallback the callback function
@@ -308,6 +324,22 @@ u16 gf_rtp_streamer_get_next_rtp_sn(GF_RTPStreamer *streamer);
 */
 GF_Err gf_rtp_streamer_set_interleave_callbacks(GF_RTPStreamer *streamer, GF_Err (*RTP_TCPCallback)(void *cbk1, void *cbk2, Bool is_rtcp, u8 *pck, u32 pck_size), void *cbk1, void *cbk2);
 
+/*! sets packet callback of the streamer. When set, packets produced by the packetizer are no longer sent on the streamer channel but passed to the callback, which can send them on one or more streamers using \ref gf_rtp_streamer_send_packet
+\param streamer the target RTP streamer
+\param on_packet the callback function, NULL to send packets on the streamer channel
+\param udta opaque data passed to callback function
+*/
+void gf_rtp_streamer_set_packet_callback(GF_RTPStreamer *streamer, void (*on_packet)(void *udta, GF_RTPHeader *hdr, u8 *payload, u32 size), void *udta);
+
+/*! sends an RTP packet on the streamer channel, using the channel SSRC. The 12 bytes before the payload are overwritten with the RTP header
+\param streamer the target RTP streamer
+\param hdr the RTP header of the packet
+\param payload the RTP payload
+\param size the RTP payload size
+\return error if any
+*/
+GF_Err gf_rtp_streamer_send_packet(GF_RTPStreamer *streamer, GF_RTPHeader *hdr, u8 *payload, u32 size);
+
 
 /*! callback function for procesing RTCP  receiver reports
 \param cbk user data passed to \ref  gf_rtp_streamer_read_rtcp
@@ -104,3 +104,53 @@ GF_Err gf_crypt_decrypt(GF_Crypt *td, void *ciphertext, u32 len)
 	if (!len) return GF_OK;
 	return td->_decrypt(td, ciphertext, len);
 }
+
+static GF_Err gf_crypt_ranges_generic(GF_Crypt *td, u8 *data, const GF_CryptRange *ranges, u32 nb_ranges, u32 crypt_block, u32 skip_block, const u8 *const_IV, Bool decrypt)
+{
+	u32 i;
+	GF_Err e = GF_OK;
+	GF_Err (*_crypt)(GF_Crypt*, u8 *, u32) = decrypt ? td->_decrypt : td->_crypt;
+
+	for (i=0; i<nb_ranges; i++) {
+		u8 *ptr = data + ranges[i].offset;
+		u32 res = ranges[i].size;
+		if (const_IV) {
+			e = td->_set_state(td, const_IV, 16);
+			if (e) return e;
+		}
+		if (!crypt_block || !skip_block) {
+			if (res) e = _crypt(td, ptr, res);
+			if (e) return e;
+			continue;
+		}
+		while (res) {
+			e = _crypt(td, ptr, (res >= 16*crypt_block) ? 16*crypt_block : res);
+			if (e) return e;
+			if (res < 16*(crypt_block + skip_block))
+				break;
+			ptr += 16*(crypt_block + skip_block);
+			res -= 16*(crypt_block + skip_block);
+		}
+	}
+	return GF_OK;
+}
+
+GF_EXPORT
+GF_Err gf_crypt_encrypt_ranges(GF_Crypt *td, u8 *data, const GF_CryptRange *ranges, u32 nb_ranges, u32 crypt_block, u32 skip_block, const u8 *const_IV)
+{
+	if (!td || !data || (nb_ranges && !ranges)) return GF_BAD_PARAM;
+	if (!nb_ranges) return GF_OK;
+	if (td->_crypt_ranges)
+		return td->_crypt_ranges(td, data, ranges, nb_ranges, crypt_block, skip_block, const_IV, GF_FALSE);
+	return gf_crypt_ranges_generic(td, data, ranges, nb_ranges, crypt_block, skip_block, const_IV, GF_FALSE);
+}
+
+GF_EXPORT
+GF_Err gf_crypt_decrypt_ranges(GF_Crypt *td, u8 *data, const GF_CryptRange *ranges, u32 nb_ranges, u32 crypt_block, u32 skip_block, const u8 *const_IV)
+{
+	if (!td || !data || (nb_ranges && !ranges)) return GF_BAD_PARAM;
+	if (!nb_ranges) return GF_OK;
+	if (td->_crypt_ranges)
+		return td->_crypt_ranges(td, data, ranges, nb_ranges, crypt_block, skip_block, const_IV, GF_TRUE);
+	return gf_crypt_ranges_generic(td, data, ranges, nb_ranges, crypt_block, skip_block, const_IV, GF_TRUE);
+}
@@ -29,17 +29,46 @@
 #ifdef GPAC_HAS_SSL
 #include <openssl/aes.h>
 #include <openssl/modes.h>
+#include <openssl/evp.h>
 
 #include <math.h>
 
+/*full blocks are processed through EVP, which uses the hardware AES implementation when available (AES-NI, ARMv8 crypto)
+and pipelines blocks for CTR and CBC decryption. The legacy AES_* API is only used for partial blocks*/
+
 typedef struct {
 	AES_KEY enc_key, dec_key;
+	EVP_CIPHER_CTX *evp_enc, *evp_dec;
 
 	u8 block[AES_BLOCK_SIZE];
 	u8 padded_input[AES_BLOCK_SIZE]; // use only when the input length is inferior to the algo block size
 	u8 previous_ciphertext[AES_BLOCK_SIZE];
 } Openssl_ctx_cbc;
 
+static EVP_CIPHER_CTX *openssl_evp_new(const EVP_CIPHER *cipher, const u8 *key, Bool enc)
+{
+	EVP_CIPHER_CTX *evp = EVP_CIPHER_CTX_new();
+	if (!evp) return NULL;
+	if (EVP_CipherInit_ex(evp, cipher, NULL, key, NULL, enc ? 1 : 0) != 1) {
+		EVP_CIPHER_CTX_free(evp);
+		return NULL;
+	}
+	EVP_CIPHER_CTX_set_padding(evp, 0);
+	return evp;
+}
+
+//processes full blocks only, returns number of bytes processed
+static u32 openssl_evp_process(EVP_CIPHER_CTX *evp, const u8 *iv, u8 *data, u32 len)
+{
+	int outl = 0;
+	len = (len / AES_BLOCK_SIZE) * AES_BLOCK_SIZE;
+	if (!evp || !len) return 0;
+	if (iv && (EVP_CipherInit_ex(evp, NULL, NULL, NULL, iv, -1) != 1)) return 0;
+	if (EVP_CipherUpdate(evp, data, &outl, data, (int) len) != 1) return 0;
+	if (outl != (int) len) return 0;
+	return len;
+}
+
 /** CBC STUFF **/
 
 GF_Err gf_crypt_init_openssl_cbc(GF_Crypt* td, void *key, const void *iv)
@@ -59,6 +88,11 @@ GF_Err gf_crypt_init_openssl_cbc(GF_Crypt* td, void *key, const void *iv)
 
 void gf_crypt_deinit_openssl_cbc(GF_Crypt* td)
 {
+	Openssl_ctx_cbc* ctx = (Openssl_ctx_cbc*)td->context;
+	if (!ctx) return;
+	if (ctx->evp_enc) EVP_CIPHER_CTX_free(ctx->evp_enc);
+	if (ctx->evp_dec) EVP_CIPHER_CTX_free(ctx->evp_dec);
+	ctx->evp_enc = ctx->evp_dec = NULL;
 }
 
 void gf_set_key_openssl_cbc(GF_Crypt* td, void *key)
@@ -66,6 +100,9 @@ void gf_set_key_openssl_cbc(GF_Crypt* td, void *key)
 	Openssl_ctx_cbc* ctx = (Openssl_ctx_cbc*)td->context;
 	AES_set_encrypt_key(key, 128, &(ctx->enc_key));
 	AES_set_decrypt_key(key, 128, &(ctx->dec_key));
+	gf_crypt_deinit_openssl_cbc(td);
+	ctx->evp_enc = openssl_evp_new(EVP_aes_128_cbc(), key, GF_TRUE);
+	ctx->evp_dec = openssl_evp_new(EVP_aes_128_cbc(), key, GF_FALSE);
 }
 
 GF_Err gf_crypt_set_IV_openssl_cbc(GF_Crypt* td, const u8 *iv, u32 iv_size)
@@ -83,11 +120,36 @@ GF_Err gf_crypt_get_IV_openssl_cbc(GF_Crypt* td, u8 *iv, u32 *iv_size)
 	return GF_OK;
 }
 
+//processes full blocks through EVP and updates chaining state, returns number of bytes processed
+static u32 gf_crypt_evp_openssl_cbc(Openssl_ctx_cbc* ctx, u8 *data, u32 len, u32 aes_crypt_type)
+{
+	u8 next_iv[AES_BLOCK_SIZE];
+	u32 done;
+	len = (len / AES_BLOCK_SIZE) * AES_BLOCK_SIZE;
+	if (!len) return 0;
+
+	if (aes_crypt_type) {
+		done = openssl_evp_process(ctx->evp_enc, ctx->previous_ciphertext, data, len);
+		if (done) memcpy(ctx->previous_ciphertext, data + done - AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+		return done;
+	}
+	memcpy(next_iv, data + len - AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+	done = openssl_evp_process(ctx->evp_dec, ctx->previous_ciphertext, data, len);
+	if (done) memcpy(ctx->previous_ciphertext, next_iv, AES_BLOCK_SIZE);
+	return done;
+}
+
 GF_Err gf_crypt_crypt_openssl_cbc(GF_Crypt* td, u8 *plaintext, u32 len, u32 aes_crypt_type) {
 	Openssl_ctx_cbc* ctx = (Openssl_ctx_cbc*)td->context;
 	u32 iteration;
 	AES_KEY *key = aes_crypt_type ? &ctx->enc_key : &ctx->dec_key;
-	u32 numberOfIterations = len / AES_BLOCK_SIZE;
+	u32 numberOfIterations;
+	u32 done = gf_crypt_evp_openssl_cbc(ctx, plaintext, len, aes_crypt_type);
+	if (done) {
+		plaintext += done;
+		len -= done;
+	}
+	numberOfIterations = len / AES_BLOCK_SIZE;
 	if (numberOfIterations * AES_BLOCK_SIZE < len) numberOfIterations++;
 
 	for (iteration = 0; iteration < numberOfIterations; ++iteration) {
@@ -113,14 +175,78 @@ GF_Err gf_crypt_decrypt_openssl_cbc(GF_Crypt* td, u8 *ciphertext, u32 len)
 	return gf_crypt_crypt_openssl_cbc(td, ciphertext, len, AES_DECRYPT);
 }
 
+static GF_Err gf_crypt_ranges_openssl_cbc(GF_Crypt* td, u8 *data, const GF_CryptRange *ranges, u32 nb_ranges, u32 crypt_block, u32 skip_block, const u8 *const_IV, Bool decrypt)
+{
+	Openssl_ctx_cbc* ctx = (Openssl_ctx_cbc*)td->context;
+	EVP_CIPHER_CTX *evp = decrypt ? ctx->evp_dec : ctx->evp_enc;
+	u32 aes_crypt_type = decrypt ? AES_DECRYPT : AES_ENCRYPT;
+	u32 i;
+
+	for (i=0; i<nb_ranges; i++) {
+		u8 *ptr = data + ranges[i].offset;
+		u32 res = ranges[i].size;
+		Bool iv_set = GF_FALSE;
+		if (const_IV)
+			memcpy(ctx->previous_ciphertext, const_IV, AES_BLOCK_SIZE);
+
+		if (!crypt_block || !skip_block) {
+			if (res) gf_crypt_crypt_openssl_cbc(td, ptr, res, aes_crypt_type);
+			continue;
+		}
+		//pattern encryption: the cipher chain only runs over encrypted blocks, so keep the EVP context
+		//across blocks and only set the IV once per range
+		while (res) {
+			u32 len = (res >= 16*crypt_block) ? 16*crypt_block : res;
+			u32 full = (len / AES_BLOCK_SIZE) * AES_BLOCK_SIZE;
+			u8 next_iv[AES_BLOCK_SIZE];
+			if (full && evp) {
+				int outl = 0;
+				if (decrypt) memcpy(next_iv, ptr + full - AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+				if (!iv_set) {
+					if (EVP_CipherInit_ex(evp, NULL, NULL, NULL, ctx->previous_ciphertext, -1) != 1) return GF_IO_ERR;
+					iv_set = GF_TRUE;
+				}
+				if ((EVP_CipherUpdate(evp, ptr, &outl, ptr, (int) full) != 1) || (outl != (int) full))
+					return GF_IO_ERR;
+				memcpy(ctx->previous_ciphertext, decrypt ? next_iv : (ptr + full - AES_BLOCK_SIZE), AES_BLOCK_SIZE);
+			} else {
+				full = 0;
+			}
+			if (len > full) {
+				gf_crypt_crypt_openssl_cbc(td, ptr + full, len - full, aes_crypt_type);
+				//chain state modified outside of EVP
+				iv_set = GF_FALSE;
+			}
+			if (res < 16*(crypt_block + skip_block))
+				break;
+			ptr += 16*(crypt_block + skip_block);
+			res -= 16*(crypt_block + skip_block);
+		}
+	}
+	return GF_OK;
+}
+
 typedef struct {
 	AES_KEY key;
+	EVP_CIPHER_CTX *evp;
 
 	u8 cyphered_iv[16];
 	u8 iv[16];
 	unsigned int c_counter_pos;
 } Openssl_ctx_ctr;
 
+//128-bit big endian counter increment, same as CRYPTO_ctr128_encrypt
+static void openssl_ctr_add(u8 *counter, u32 nb_blocks)
+{
+	s32 i;
+	u32 carry = nb_blocks;
+	for (i=15; (i>=0) && carry; i--) {
+		carry += counter[i];
+		counter[i] = (u8) (carry & 0xFF);
+		carry >>= 8;
+	}
+}
+
 
 /** CTR STUFF **/
 
@@ -128,6 +254,8 @@ void gf_set_key_openssl_ctr(GF_Crypt* td, void *key)
 {
 	Openssl_ctx_ctr* ctx = (Openssl_ctx_ctr*)td->context;
 	AES_set_encrypt_key(key, 128, &(ctx->key));
+	if (ctx->evp) EVP_CIPHER_CTX_free(ctx->evp);
+	ctx->evp = openssl_evp_new(EVP_aes_128_ctr(), key, GF_TRUE);
 }
 
 GF_Err gf_crypt_set_IV_openssl_ctr(GF_Crypt* td, const u8 *iv, u32 iv_size)
@@ -170,13 +298,35 @@ GF_Err gf_crypt_init_openssl_ctr(GF_Crypt* td, void *key, const void *iv)
 
 void gf_crypt_deinit_openssl_ctr(GF_Crypt* td)
 {
+	Openssl_ctx_ctr* ctx = (Openssl_ctx_ctr*)td->context;
+	if (ctx && ctx->evp) {
+		EVP_CIPHER_CTX_free(ctx->evp);
+		ctx->evp = NULL;
+	}
 }
 
 GF_Err gf_crypt_crypt_openssl_ctr(GF_Crypt* td, u8 *plaintext, u32 len)
 {
 	Openssl_ctx_ctr* ctx = (Openssl_ctx_ctr*)td->context;
-
-	CRYPTO_ctr128_encrypt(plaintext, plaintext, len, &ctx->key, ctx->iv, ctx->cyphered_iv, &ctx->c_counter_pos, (block128_f)AES_encrypt);
+	u32 done;
+
+	//consume remaining keystream of current block
+	if (ctx->c_counter_pos && len) {
+		u32 lead = AES_BLOCK_SIZE - ctx->c_counter_pos;
+		if (lead > len) lead = len;
+		CRYPTO_ctr128_encrypt(plaintext, plaintext, lead, &ctx->key, ctx->iv, ctx->cyphered_iv, &ctx->c_counter_pos, (block128_f)AES_encrypt);
+		plaintext += lead;
+		len -= lead;
+	}
+	//full blocks
+	done = openssl_evp_process(ctx->evp, ctx->iv, plaintext, len);
+	if (done) {
+		openssl_ctr_add(ctx->iv, done / AES_BLOCK_SIZE);
+		plaintext += done;
+		len -= done;
+	}
+	if (len)
+		CRYPTO_ctr128_encrypt(plaintext, plaintext, len, &ctx->key, ctx->iv, ctx->cyphered_iv, &ctx->c_counter_pos, (block128_f)AES_encrypt);
 
 	return GF_OK;
 }
@@ -271,6 +421,7 @@ GF_Err gf_crypt_open_open_openssl(GF_Crypt* td, GF_CRYPTO_MODE mode)
 		td->_decrypt = gf_crypt_decrypt_openssl_cbc;
 		td->_get_state = gf_crypt_get_IV_openssl_cbc;
 		td->_set_state = gf_crypt_set_IV_openssl_cbc;
+		td->_crypt_ranges = gf_crypt_ranges_openssl_cbc;
 		break;
 	case GF_CTR:
 		td->_init_crypt = gf_crypt_init_openssl_ctr;
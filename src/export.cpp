@@ -453,6 +453,7 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_sess_get_stats) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_sess_get_utc_start) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_sess_fetch_data) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_dm_sess_set_priority) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_sess_last_error) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_sess_get_resource_name) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_sess_mime_type) )
@@ -1262,6 +1263,8 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_streamer_send_rtcp) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_streamer_get_payload_type) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_streamer_set_interleave_callbacks) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_rtp_streamer_set_packet_callback) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_rtp_streamer_send_packet) )
 
 #endif
 
@@ -1543,7 +1546,9 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_crypt_close) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_crypt_init) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_crypt_decrypt) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_crypt_decrypt_ranges) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_crypt_encrypt) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_crypt_encrypt_ranges) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_crypt_set_key) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_crypt_set_IV) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_crypt_get_IV) )
@@ -2229,6 +2234,7 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_dash_is_in_setup) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dash_group_discard_segment) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dash_group_get_next_segment_location) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_dash_group_get_queued_segment_location) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dash_set_group_done) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dash_in_period_setup) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dash_seek) )
@@ -2250,6 +2256,7 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_dash_set_switching_probe_count) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dash_set_agressive_adaptation) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dash_enable_single_range_llhls) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_dash_set_prefetch_depth) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dash_get_period_start) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dash_get_period_duration) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dash_group_get_language) )
@@ -2314,6 +2321,7 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_route_dmx_get_last_packet_time) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_route_dmx_get_nb_packets) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_route_dmx_get_recv_bytes) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_route_dmx_get_fec_stats) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_route_dmx_set_service_udta) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_route_dmx_get_service_udta) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_route_dmx_debug_tsi) )
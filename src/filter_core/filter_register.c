@@ -177,6 +177,8 @@ REG_DEC(rftruehd)
 REG_DEC(cryptin)
 REG_DEC(cryptout)
 REG_DEC(restamp)
+REG_DEC(psplit)
+REG_DEC(pmerge)
 REG_DEC(oggmx)
 REG_DEC(vtt2tx3g)
 REG_DEC(rfsrt)
@@ -342,6 +344,8 @@ BuiltinReg BuiltinFilters [] = {
 	REG_IT(cryptin),
 	REG_IT(cryptout),
 	REG_IT(restamp),
+	REG_IT(psplit),
+	REG_IT(pmerge),
 	REG_IT(oggmx),
 	REG_IT(unframer),
 	REG_IT(writeuf),
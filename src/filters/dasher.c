@@ -176,6 +176,7 @@ typedef struct
 	s32 subs_sidx;
 	s32 buf, timescale;
 	Bool sfile, sseg, no_sar, mix_codecs, stl, tpl, align, sap, no_frag_def, sidx, split, hlsc, strict_cues, force_flush, last_seg_merge;
+	u32 hlsth;
 	u32 mha_compat;
 	u32 strict_sap;
 	u32 pssh;
@@ -216,6 +217,7 @@ typedef struct
 	Double ll_part_hb;
 	u32 hls_absu, seg_sync;
 	Bool hls_ap;
+	Bool dedup;
 
 	//internal
 	Bool in_error;
@@ -235,6 +237,8 @@ typedef struct
 	s32 period_idx;
 
 	GF_List *tpl_records;
+	//segments already produced in previous periods, for dedup mode
+	GF_List *dedup_entries;
 	Bool use_xlink, use_cenc, check_main_role, use_clearkey;
 
 	//options for muxers, constrained by profile
@@ -515,6 +519,11 @@ typedef struct _dash_stream
 
 	u64 frag_start_offset, frag_first_ftdt;
 	u32 tpl_use_time;
+
+	//dedup mode: content key of this stream in the current period, and previous segments reused if any
+	u8 dedup_key[GF_SHA1_DIGEST_SIZE];
+	Bool has_dedup_key;
+	struct _dasher_dedup_entry *dedup_src;
 } GF_DashStream;
 
 static void dasher_flush_segment(GF_DasherCtx *ctx, GF_DashStream *ds, Bool is_last_in_period);
@@ -523,6 +532,7 @@ static void dasher_reset_stream(GF_Filter *filter, GF_DashStream *ds, Bool is_de
 static void dasher_update_period_duration(GF_DasherCtx *ctx, Bool is_period_switch);
 static GF_Err dasher_setup_period(GF_Filter *filter, GF_DasherCtx *ctx, GF_DashStream *for_ds);
 static GF_Err dasher_setup_profile(GF_DasherCtx *ctx);
+static void dasher_setup_rep_hls_info(GF_DasherCtx *ctx, GF_DashStream *ds);
 
 static GF_DasherPeriod *dasher_new_period()
 {
@@ -1100,6 +1110,7 @@ static GF_Err dasher_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is
 
 			GF_FEVT_INIT(evt, GF_FEVT_PLAY, ds->ipid);
 			evt.play.speed = 1.0;
+			evt.play.no_data = ctx->sigfrag;
 			gf_filter_pid_send_event(ds->ipid, &evt);
 		}
 		//don't create pid at this time except in gencues mode
@@ -3589,6 +3600,241 @@ static u32 dasher_check_template_reuse(GF_DasherCtx *ctx, const char *tpl)
 	return 0;
 }
 
+typedef struct _dasher_dedup_entry
+{
+	//hash of source PID properties and period constraints
+	u8 key[GF_SHA1_DIGEST_SIZE];
+	//representation and parent set of the period in which segments were produced
+	GF_MPD_Representation *rep;
+	GF_MPD_AdaptationSet *set;
+	char *init_seg;
+	u64 max_period_dur;
+} DasherDedupEntry;
+
+static void dasher_dedup_compute_key(GF_DasherCtx *ctx, GF_DashStream *ds)
+{
+	u32 idx=0, p4cc;
+	const char *pname;
+	const GF_PropertyValue *p;
+	char szDump[GF_PROP_DUMP_ARG_SIZE];
+	GF_SHA1Context *sha = gf_sha1_starts();
+	if (!sha) return;
+
+	//source URL, codec config and all encoding parameters are exposed as PID properties
+	while ((p = gf_filter_pid_enum_properties(ds->ipid, &idx, &p4cc, &pname))) {
+		const char *val;
+		//period placement does not change segment content
+		if ((p4cc==GF_PROP_PID_PERIOD_ID) || (p4cc==GF_PROP_PID_PERIOD_START) || (p4cc==GF_PROP_PID_PERIOD_DESC))
+			continue;
+		if (p->type==GF_PROP_POINTER) continue;
+
+		if (pname) gf_sha1_update(sha, (u8 *) pname, (u32) strlen(pname));
+		else gf_sha1_update(sha, (u8 *) &p4cc, 4);
+
+		if ((p->type==GF_PROP_DATA) || (p->type==GF_PROP_DATA_NO_COPY) || (p->type==GF_PROP_CONST_DATA)) {
+			if (p->value.data.ptr) gf_sha1_update(sha, p->value.data.ptr, p->value.data.size);
+			continue;
+		}
+		val = gf_props_dump_val(p, szDump, GF_PROP_DUMP_DATA_NONE, NULL);
+		if (val) gf_sha1_update(sha, (u8 *) val, (u32) strlen(val));
+	}
+	//time range imposed by the period layout and segmentation
+	gf_sha1_update(sha, (u8 *) &ds->force_rep_end, sizeof(u64));
+	gf_sha1_update(sha, (u8 *) &ds->dash_dur, sizeof(GF_Fraction));
+	gf_sha1_finish(sha, ds->dedup_key);
+	ds->has_dedup_key = GF_TRUE;
+}
+
+static DasherDedupEntry *dasher_dedup_find(GF_DasherCtx *ctx, GF_DashStream *ds)
+{
+	u32 i, count = gf_list_count(ctx->dedup_entries);
+	for (i=0; i<count; i++) {
+		DasherDedupEntry *de = gf_list_get(ctx->dedup_entries, i);
+		if (!memcmp(de->key, ds->dedup_key, GF_SHA1_DIGEST_SIZE))
+			return de;
+	}
+	return NULL;
+}
+
+static GF_MPD_SegmentTemplate *dasher_dedup_clone_template(DasherDedupEntry *de)
+{
+	u32 i, count;
+	GF_MPD_SegmentTemplate *seg_template;
+	GF_MPD_SegmentTemplate *r_tpl = de->rep->segment_template;
+	GF_MPD_SegmentTemplate *s_tpl = de->set->segment_template;
+	GF_MPD_SegmentTimeline *stl;
+
+	GF_SAFEALLOC(seg_template, GF_MPD_SegmentTemplate);
+	if (!seg_template) return NULL;
+
+	//merge set and representation templates, representation one wins
+#define DEDUP_TPL_STR(_name) \
+	if (r_tpl && r_tpl->_name) seg_template->_name = gf_strdup(r_tpl->_name); \
+	else if (s_tpl && s_tpl->_name) seg_template->_name = gf_strdup(s_tpl->_name);
+#define DEDUP_TPL_VAL(_name, _unset) \
+	if (r_tpl && (r_tpl->_name != _unset)) seg_template->_name = r_tpl->_name; \
+	else if (s_tpl) seg_template->_name = s_tpl->_name; \
+	else seg_template->_name = _unset;
+
+	DEDUP_TPL_STR(media)
+	DEDUP_TPL_STR(index)
+	DEDUP_TPL_STR(initialization)
+	DEDUP_TPL_VAL(timescale, 0)
+	DEDUP_TPL_VAL(duration, 0)
+	DEDUP_TPL_VAL(start_number, (u32)-1)
+	DEDUP_TPL_VAL(presentation_time_offset, 0)
+	DEDUP_TPL_VAL(availability_time_offset, 0)
+
+#undef DEDUP_TPL_STR
+#undef DEDUP_TPL_VAL
+
+	seg_template->hls_init_name = de->init_seg;
+
+	stl = (r_tpl && r_tpl->segment_timeline) ? r_tpl->segment_timeline : (s_tpl ? s_tpl->segment_timeline : NULL);
+	if (!stl) return seg_template;
+
+	GF_SAFEALLOC(seg_template->segment_timeline, GF_MPD_SegmentTimeline);
+	if (!seg_template->segment_timeline) return seg_template;
+	seg_template->segment_timeline->entries = gf_list_new();
+	count = gf_list_count(stl->entries);
+	for (i=0; i<count; i++) {
+		GF_MPD_SegmentTimelineEntry *ent, *src = gf_list_get(stl->entries, i);
+		GF_SAFEALLOC(ent, GF_MPD_SegmentTimelineEntry);
+		if (!ent) break;
+		*ent = *src;
+		gf_list_add(seg_template->segment_timeline->entries, ent);
+	}
+	return seg_template;
+}
+
+static void dasher_dedup_clone_seg_states(GF_DashStream *ds, DasherDedupEntry *de)
+{
+	u32 i, count = gf_list_count(de->rep->state_seg_list);
+	if (!ds->rep->state_seg_list) ds->rep->state_seg_list = gf_list_new();
+
+	for (i=0; i<count; i++) {
+		GF_DASH_SegmentContext *sctx, *src = gf_list_get(de->rep->state_seg_list, i);
+		GF_SAFEALLOC(sctx, GF_DASH_SegmentContext);
+		if (!sctx) return;
+		*sctx = *src;
+		if (src->filename) sctx->filename = gf_strdup(src->filename);
+		if (src->filepath) sctx->filepath = gf_strdup(src->filepath);
+		if (src->hls_key_uri) sctx->hls_key_uri = gf_strdup(src->hls_key_uri);
+		if (src->frags) {
+			sctx->frags = gf_malloc(sizeof(GF_DASH_FragmentContext) * src->nb_frags);
+			if (sctx->frags) memcpy(sctx->frags, src->frags, sizeof(GF_DASH_FragmentContext) * src->nb_frags);
+			else sctx->nb_frags = 0;
+		}
+		gf_list_add(ds->rep->state_seg_list, sctx);
+	}
+}
+
+//check if all representations of the set were already produced in a previous period, and if so reference them
+static Bool dasher_dedup_setup_set(GF_DasherCtx *ctx, GF_MPD_AdaptationSet *set)
+{
+	u32 i, j, count, nb_streams;
+
+	if (!ctx->dedup || !ctx->tpl || ctx->sigfrag || ctx->forward_mode || ctx->state || ctx->gencues || ctx->do_index)
+		return GF_FALSE;
+	//segments are purged from the timeshift buffer and may no longer exist when reused
+	if ((ctx->dmode != GF_MPD_TYPE_STATIC) && (ctx->tsb>=0))
+		return GF_FALSE;
+
+	nb_streams = gf_list_count(ctx->current_period->streams);
+	count = gf_list_count(set->representations);
+	for (i=0; i<count; i++) {
+		GF_MPD_Representation *rep = gf_list_get(set->representations, i);
+		GF_DashStream *ds = rep->playback.udta;
+		ds->dedup_src = NULL;
+		ds->has_dedup_key = GF_FALSE;
+		//multiplexed, dependent or tiled streams are always produced
+		if (ds->muxed_base || ds->dep_id || ds->tile_base || gf_list_count(ds->complementary_streams) || (ds->codec_id==GF_CODECID_HEVC_TILES))
+			return GF_FALSE;
+		for (j=0; j<nb_streams; j++) {
+			GF_DashStream *a_ds = gf_list_get(ctx->current_period->streams, j);
+			if (a_ds->muxed_base == ds) return GF_FALSE;
+		}
+		dasher_dedup_compute_key(ctx, ds);
+	}
+	//the whole set must be available, we do not mix produced and referenced representations
+	for (i=0; i<count; i++) {
+		GF_MPD_Representation *rep = gf_list_get(set->representations, i);
+		GF_DashStream *ds = rep->playback.udta;
+		if (!ds->has_dedup_key) return GF_FALSE;
+		ds->dedup_src = dasher_dedup_find(ctx, ds);
+		if (!ds->dedup_src) {
+			for (j=0; j<i; j++) {
+				rep = gf_list_get(set->representations, j);
+				((GF_DashStream *)rep->playback.udta)->dedup_src = NULL;
+			}
+			return GF_FALSE;
+		}
+	}
+
+	for (i=0; i<count; i++) {
+		GF_FilterEvent evt;
+		GF_MPD_Representation *rep = gf_list_get(set->representations, i);
+		GF_DashStream *ds = rep->playback.udta;
+		DasherDedupEntry *de = ds->dedup_src;
+
+		GF_LOG(GF_LOG_INFO, GF_LOG_DASH, ("[Dasher] Representation %s in period %s reuses segments of representation %s\n", rep->id, ds->period_id, de->rep->id));
+
+		rep->segment_template = dasher_dedup_clone_template(de);
+		rep->bandwidth = de->rep->bandwidth;
+		rep->starts_with_sap = de->rep->starts_with_sap;
+		//SAP types and alignment are detected while segmenting
+		if (!i) {
+			set->starts_with_sap = de->set->starts_with_sap;
+			set->subsegment_starts_with_sap = de->set->subsegment_starts_with_sap;
+			set->segment_alignment = de->set->segment_alignment;
+			set->subsegment_alignment = de->set->subsegment_alignment;
+		}
+		ds->mpd_timescale = rep->segment_template ? rep->segment_template->timescale : ds->timescale;
+		ds->init_seg = gf_strdup(de->init_seg);
+		if (ctx->store_seg_states && de->rep->state_seg_list) {
+			dasher_dedup_clone_seg_states(ds, de);
+			dasher_setup_rep_hls_info(ctx, ds);
+			ds->rep->hls_max_seg_dur = de->rep->hls_max_seg_dur;
+		}
+		//no need for the source anymore
+		ds->done = 1;
+		GF_FEVT_INIT(evt, GF_FEVT_STOP, ds->ipid);
+		gf_filter_pid_send_event(ds->ipid, &evt);
+		gf_filter_pid_set_discard(ds->ipid, GF_TRUE);
+	}
+	//max segment duration already accounts for the reused segments
+	ctx->def_max_seg_dur = 0;
+	return GF_TRUE;
+}
+
+//record representations fully produced in the period ending
+static void dasher_dedup_store_period(GF_DasherCtx *ctx)
+{
+	u32 i, count;
+	if (!ctx->dedup_entries) return;
+
+	count = gf_list_count(ctx->current_period->streams);
+	for (i=0; i<count; i++) {
+		DasherDedupEntry *de;
+		GF_DashStream *ds = gf_list_get(ctx->current_period->streams, i);
+		if (!ds->has_dedup_key || ds->dedup_src) continue;
+		//only keep complete representations with all their segments
+		if ((ds->done != 1) || ds->subdur_done || ds->nb_segments_purged) continue;
+		if (!ds->rep || !ds->set || !ds->init_seg) continue;
+		if (!ds->rep->segment_template && !ds->set->segment_template) continue;
+		if (dasher_dedup_find(ctx, ds)) continue;
+
+		GF_SAFEALLOC(de, DasherDedupEntry);
+		if (!de) return;
+		memcpy(de->key, ds->dedup_key, GF_SHA1_DIGEST_SIZE);
+		de->rep = ds->rep;
+		de->set = ds->set;
+		de->init_seg = gf_strdup(ds->init_seg);
+		de->max_period_dur = ds->max_period_dur;
+		gf_list_add(ctx->dedup_entries, de);
+	}
+}
+
 static void dasher_setup_sources(GF_Filter *filter, GF_DasherCtx *ctx, GF_MPD_AdaptationSet *set)
 {
 	char szDASHTemplate[GF_MAX_PATH];
@@ -3849,6 +4095,10 @@ static void dasher_setup_sources(GF_Filter *filter, GF_DasherCtx *ctx, GF_MPD_Ad
 		set->content_protection = dasher_get_content_protection_desc(ctx, NULL, set);
 	}
 
+	//same content already segmented in a previous period, reference it
+	if (dasher_dedup_setup_set(ctx, set))
+		return;
+
 	for (i=0; i<count; i++) {
 		GF_Err e;
 		char szRawExt[20];
@@ -4476,8 +4726,9 @@ static void dasher_purge_segments(GF_DasherCtx *ctx, u64 *period_dur)
 		if (!ds->rep) continue;
 		if (!ds->rep->state_seg_list) continue;
 
-		ds->rep->tsb_first_entry = 0;
-		u32 state_idx=0;
+		//when keeping segments, entries before the current first entry are already out of the timeshift buffer
+		u32 state_idx = ctx->keep_segs ? ds->rep->tsb_first_entry : 0;
+		ds->rep->tsb_first_entry = state_idx;
 		while (1) {
 			Double time, dur;
 			Bool seg_url_found = GF_FALSE;
@@ -5233,6 +5484,7 @@ static GF_Err dasher_write_and_send_manifest(GF_DasherCtx *ctx, u64 last_period_
 		else if (ctx->from_index==IDXMODE_CHILD) mode = GF_M3U8_WRITE_CHILD;
 
 		ctx->mpd->m3u8_time = ctx->hlsc;
+		ctx->mpd->m3u8_threads = ctx->hlsth;
 		ctx->mpd->nb_hls_ext_master = ctx->hlsx.nb_items;
 		ctx->mpd->hls_ext_master = (const char **) ctx->hlsx.vals;
 		ctx->mpd->llhls_preload = ctx->ll_preload_hint;
@@ -5588,6 +5840,8 @@ static void dasher_reset_stream(GF_Filter *filter, GF_DashStream *ds, Bool is_de
 		ds->nb_sap_in_queue = 0;
 	}
 	ds->forced_period_switch = GF_FALSE;
+	ds->has_dedup_key = GF_FALSE;
+	ds->dedup_src = NULL;
 }
 
 void dasher_context_update_period_end(GF_DasherCtx *ctx)
@@ -6283,6 +6537,8 @@ static GF_Err dasher_switch_period(GF_Filter *filter, GF_DasherCtx *ctx)
 	ctx->is_period_restore = GF_FALSE;
 	ctx->is_empty_period = GF_FALSE;
 
+	dasher_dedup_store_period(ctx);
+
 	//safety check at period switch, probe each first packet in case we have a reconfigure pending
 	count = gf_list_count(ctx->pids);
 	for (i=0; i<count;i++) {
@@ -6411,6 +6667,7 @@ static GF_Err dasher_switch_period(GF_Filter *filter, GF_DasherCtx *ctx)
 
 				GF_FEVT_INIT(evt, GF_FEVT_PLAY, ds->ipid);
 				evt.play.speed = 1.0;
+				evt.play.no_data = ctx->sigfrag;
 				gf_filter_pid_send_event(ds->ipid, &evt);
 			}
 		}
@@ -7104,6 +7361,11 @@ static GF_Err dasher_setup_period(GF_Filter *filter, GF_DasherCtx *ctx, GF_DashS
 		ds->segment_started = GF_FALSE;
 		ds->seg_number = ds->startNumber;
 		ds->first_cts = ds->first_dts = ds->max_period_dur = 0;
+		//segments reused from a previous period, nothing will be produced
+		if (ds->dedup_src) {
+			ds->max_period_dur = ds->dedup_src->max_period_dur;
+			continue;
+		}
 
 		//simulate N loops of the source
 		if (ctx->nb_secs_to_discard) {
@@ -7690,6 +7952,43 @@ u64 dasher_translate_cts(GF_DashStream *ds, u64 cts)
 	return cts;
 }
 
+static void dasher_setup_rep_hls_info(GF_DasherCtx *ctx, GF_DashStream *ds)
+{
+	const GF_PropertyValue *p;
+	ds->rep->timescale = ds->timescale;
+	ds->rep->streamtype = ds->stream_type;
+	ds->rep->timescale_mpd = ds->mpd_timescale;
+	p = gf_filter_pid_get_property(ds->ipid, GF_PROP_PID_HLS_GROUPID);
+	if (p)
+		ds->rep->groupID = p->value.string;
+	p = gf_filter_pid_get_property(ds->ipid, GF_PROP_PID_HLS_FORCE_INF);
+	if (p)
+		ds->rep->hls_forced = p->value.string;
+
+	ds->rep->dash_dur = ds->dash_dur;
+	ds->rep->hls_max_seg_dur = ds->dash_dur;
+
+	if (!ds->rep->hls_single_file_name) {
+		switch (ctx->muxtype) {
+		case DASHER_MUX_TS:
+		case DASHER_MUX_OGG:
+		case DASHER_MUX_RAW:
+			break;
+		default:
+			if (ds->set->bitstream_switching && ds->set->segment_template)
+				ds->rep->hls_single_file_name = ds->set->segment_template->hls_init_name;
+			else
+				ds->rep->hls_single_file_name = ds->init_seg;
+		}
+	}
+	ds->rep->nb_chan = ds->nb_ch;
+	ds->rep->m3u8_name = ds->hls_vp_name;
+	if (ds->fps.den) {
+		ds->rep->fps = ds->fps.num;
+		ds->rep->fps /= ds->fps.den;
+	}
+}
+
 static void dasher_mark_segment_start(GF_DasherCtx *ctx, GF_DashStream *ds, GF_FilterPacket *pck, GF_FilterPacket *in_pck)
 {
 	Bool no_concat;
@@ -7805,40 +8104,9 @@ static void dasher_mark_segment_start(GF_DasherCtx *ctx, GF_DashStream *ds, GF_F
 		if (!ds->rep->state_seg_list) {
 			ds->rep->state_seg_list = gf_list_new();
 		}
-		if (!ds->rep->dash_dur.num) {
-			ds->rep->timescale = ds->timescale;
-			ds->rep->streamtype = ds->stream_type;
-			ds->rep->timescale_mpd = ds->mpd_timescale;
-			p = gf_filter_pid_get_property(ds->ipid, GF_PROP_PID_HLS_GROUPID);
-			if (p)
-				ds->rep->groupID = p->value.string;
-			p = gf_filter_pid_get_property(ds->ipid, GF_PROP_PID_HLS_FORCE_INF);
-			if (p)
-				ds->rep->hls_forced = p->value.string;
-
-			ds->rep->dash_dur = ds->dash_dur;
-			ds->rep->hls_max_seg_dur = ds->dash_dur;
-
-			if (!ds->rep->hls_single_file_name) {
-				switch (ctx->muxtype) {
-				case DASHER_MUX_TS:
-				case DASHER_MUX_OGG:
-				case DASHER_MUX_RAW:
-					break;
-				default:
-					if (ds->set->bitstream_switching && ds->set->segment_template)
-						ds->rep->hls_single_file_name = ds->set->segment_template->hls_init_name;
-					else
-						ds->rep->hls_single_file_name = ds->init_seg;
-				}
-			}
-			ds->rep->nb_chan = ds->nb_ch;
-			ds->rep->m3u8_name = ds->hls_vp_name;
-			if (ds->fps.den) {
-				ds->rep->fps = ds->fps.num;
-				ds->rep->fps /= ds->fps.den;
-			}
-		}
+		if (!ds->rep->dash_dur.num)
+			dasher_setup_rep_hls_info(ctx, ds);
+
 		GF_SAFEALLOC(seg_state, GF_DASH_SegmentContext);
 		if (!seg_state) return;
 		seg_state->time = ds->seg_start_time;
@@ -8272,6 +8540,7 @@ static Bool dasher_check_loop(GF_DasherCtx *ctx, GF_DashStream *ds)
 
 			GF_FEVT_INIT(evt, GF_FEVT_PLAY, a_ds->ipid);
 			evt.play.speed = 1.0;
+			evt.play.no_data = ctx->sigfrag;
 			gf_filter_pid_send_event(a_ds->ipid, &evt);
 		}
 	}
@@ -9810,6 +10079,7 @@ static void dasher_resume_subdur(GF_Filter *filter, GF_DasherCtx *ctx)
 		dasher_send_encode_hints(ctx, ds);
 		GF_FEVT_INIT(evt, GF_FEVT_PLAY, ds->ipid);
 		evt.play.speed = 1.0;
+		evt.play.no_data = ctx->sigfrag;
 		if (!ctx->subdur || !ctx->loop) {
 			ds->seek_to_pck = 0;
 		} else {
@@ -9939,6 +10209,18 @@ static Bool dasher_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 				gf_filter_pid_send_event(ds->ipid, &anevt);
 			}
 		}
+		//manifest generation only, sources don't need to load sample data: cancel the event and forward a modified copy to our input PIDs
+		if (ctx->sigfrag) {
+			GF_FilterEvent anevt = *evt;
+			anevt.play.no_data = GF_TRUE;
+			count = gf_list_count(ctx->pids);
+			for (i=0; i<count; i++) {
+				GF_DashStream *ds = gf_list_get(ctx->pids, i);
+				anevt.base.on_pid = ds->ipid;
+				gf_filter_pid_send_event(ds->ipid, &anevt);
+			}
+			return GF_TRUE;
+		}
 		return GF_FALSE;
 	}
 	if (evt->base.type == GF_FEVT_STOP) {
@@ -10279,6 +10561,8 @@ static GF_Err dasher_initialize(GF_Filter *filter)
 	ctx->pids = gf_list_new();
 	ctx->postponed_pids = gf_list_new();
 	ctx->tpl_records = gf_list_new();
+	if (ctx->dedup)
+		ctx->dedup_entries = gf_list_new();
 	if (!ctx->initext && (ctx->muxtype==DASHER_MUX_AUTO))
 		ctx->muxtype = DASHER_MUX_ISOM;
 
@@ -10373,6 +10657,13 @@ static void dasher_finalize(GF_Filter *filter)
 	}
 	gf_list_del(ctx->tpl_records);
 
+	while (gf_list_count(ctx->dedup_entries)) {
+		DasherDedupEntry *de = gf_list_pop_back(ctx->dedup_entries);
+		gf_free(de->init_seg);
+		gf_free(de);
+	}
+	gf_list_del(ctx->dedup_entries);
+
 	if (ctx->next_period->period) gf_mpd_period_free(ctx->next_period->period);
 	gf_list_del(ctx->current_period->streams);
 	gf_free(ctx->current_period);
@@ -10520,6 +10811,7 @@ static const GF_FilterArgs DasherArgs[] =
 	{ OFFS(loop), "loop sources when dashing with subdur and state. If not set, a new period is created once the sources are over", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(split), "enable cloning samples for text/metadata/scene description streams, marking further clones as redundant", GF_PROP_BOOL, "true", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(hlsc), "insert clock reference in variant playlist in live HLS", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(hlsth), "number of threads used to write HLS variant playlists at each manifest update (0 or 1 writes them sequentially)", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(cues), "set cue file", GF_PROP_STRING, NULL, NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(strict_cues), "strict mode for cues, complains if splitting is not on SAP type 1/2/3 or if unused cue is found", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(strict_sap), "strict mode for sap\n"
@@ -10601,6 +10893,7 @@ static const GF_FilterArgs DasherArgs[] =
 		"- auto: default KID only injected if no key roll is detected (as per DASH-IF guidelines)"
 		, GF_PROP_UINT, "auto", "off|on|auto", GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(tpl_force), "use template string as is without trying to add extension or solve conflicts in names", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(dedup), "reuse segments of a previous period for representations with identical source and encoding parameters (see filter help)", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
 
 	{0}
 };
@@ -10745,6 +11038,11 @@ GF_FilterRegister DasherRegister = {
 "This will fetch time from `http://time.akamai.com`, use it as the UTC reference for segment generation and insert in the MPD a UTCTiming descriptor containing the time server URL.\n"
 "Note: if not set as a global option using `--utcs=`, you must escape the url using double `::` or use other separators.\n"
 "\n"
+"Each representation is packaged by its own multiplexer instance, and these instances run concurrently when the session uses extra threads (see `gpac -h threads`). "
+"The dasher only synchronizes representations at segment boundaries and manifest updates.\n"
+"For large ladders in live HLS, the variant playlists can also be written in parallel at each manifest update using [-hlsth]().\n"
+"EX gpac -threads=-1 -i source.mp4 ... -o live.m3u8:segdur=2:dmode=dynamic:hlsth=4\n"
+"\n"
 "## Cue-driven segmentation\n"
 "The segmenter can take a list of instructions, or Cues, to use for the segmentation process, in which case only these are used to derive segment boundaries. Cues can be set through XML files or injected in input packets.\n"
 "\n"
@@ -10781,6 +11079,7 @@ GF_FilterRegister DasherRegister = {
 "- if [-template]() is provided, it shall be correct: the filter will not try to guess one from the input file names and will not validate it either.\n"
 "\n"
 "The manifest generation-only mode supports both MPD and HLS generation.\n"
+"In this mode, sources are requested not to load sample data: only sample tables and fragment headers are read, which allows generating manifests of large catalogs in a few milliseconds per title.\n"
 "\n"
 "EX gpac -i ondemand_src.mp4 -o dash.mpd:sigfrag:profile=onDemand\n"
 "This will generate a DASH manifest for onDemand Profile based on the input file.\n"
@@ -10812,6 +11111,14 @@ GF_FilterRegister DasherRegister = {
 "- second period clear\n"
 "- third period crypted with another key\n"
 "\n"
+"## Segment reuse across periods\n"
+"When [-dedup]() is set, the segmenter identifies each representation by a hash of its source PID properties (source URL, codec configuration, bitrate, dimensions, period duration, ...), of the segment duration and of the time range imposed by the period layout.\n"
+"If all representations of an adaptation set were already segmented in a previous period with identical hashes, the source is not segmented again and the manifest references the segments (and init segments) produced for the first period.\n"
+"This is typically used for repeated content such as slates, pre-rolls or ad breaks inserted several times in a multi-period session.\n"
+"EX gpac -i main1.mp4:#Period=1 -i ad.mp4:#Period=2 -i main2.mp4:#Period=3 -i ad.mp4:#Period=4 -o live.mpd:dedup\n"
+"This will only produce segments for `ad.mp4` once and reference them in periods 2 and 4.\n"
+"Note: Reuse is only done in template mode, and is disabled for multiplexed, dependent or tiled representations, as well as in [-state](), [-sigfrag]() and forward modes, and in dynamic mode with a timeshift buffer ([-tsb]() not negative).\n"
+"\n"
 "## Forced-Template mode\n"
 "When [-tpl_force]() is set, the [-template]() string is not analyzed nor modified for missing elements.\n"
 "This is typically used to redirect segments to a given destination regardless of the dash profile.\n"
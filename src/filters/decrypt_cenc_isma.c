@@ -30,6 +30,7 @@
 #include <gpac/base_coding.h>
 #include <gpac/download.h>
 #include <gpac/network.h>
+#include <gpac/thread.h>
 #include <gpac/internal/media_dev.h>
 
 #if !defined(GPAC_DISABLE_CRYPTO) && !defined(GPAC_DISABLE_CDCRYPT)
@@ -60,9 +61,57 @@ typedef struct
 	GF_Crypt *crypt;
 	bin128 key;
 	u32 key_valid;
+	//key used when initializing crypt
+	bin128 init_key;
+
+	//encrypted ranges of the current sample
+	GF_CryptRange *ranges;
+	u32 nb_ranges, nb_alloc_ranges;
+	//constant IV to restore at each range
+	Bool use_const_IV;
+	u8 const_IV[16];
 } CENCDecKey;
 
+//max number of samples in flight per stream and per decryption thread
+#define CENC_DEC_JOBS_PER_THREAD	2
+
+//sample decryption job, processed by decryption threads
 typedef struct
+{
+	GF_FilterPacket *out_pck;
+	u8 *data;
+
+	//no ranges if the packet is only waiting for previous packets to be sent
+	Bool is_cbc;
+	bin128 key;
+	u8 IV[17];
+	u32 IV_size;
+	Bool use_const_IV;
+	u8 const_IV[16];
+	u32 crypt_block, skip_block;
+	GF_CryptRange *ranges;
+	u32 nb_ranges, nb_alloc_ranges;
+
+	//set by decryption thread under job mutex
+	Bool done;
+	GF_Err e;
+	//notified by decryption thread once done, wait_signal is set until the notification is consumed
+	GF_Semaphore *sema;
+	Bool wait_signal;
+} CENCDecJob;
+
+typedef struct __cenc_dec_ctx GF_CENCDecCtx;
+
+typedef struct
+{
+	GF_CENCDecCtx *ctx;
+	GF_Thread *th;
+	//per-thread crypto contexts, reinitialized when key changes
+	GF_Crypt *ctr, *cbc;
+	bin128 ctr_key, cbc_key;
+} CENCDecWorker;
+
+struct __cenc_dec_ctx
 {
 	const char *cfile;
 	u32 decrypt;
@@ -71,6 +120,7 @@ typedef struct
 	GF_PropStringList keys;
 	GF_CryptInfo *cinfo;
 	Bool hls_cenc_patch_iv;
+	u32 nbth;
 
 	GF_Filter *filter;
 	GF_List *streams;
@@ -79,7 +129,13 @@ typedef struct
 	GF_DownloadManager *dm;
 	u32 pending_keys;
 
-} GF_CENCDecCtx;
+	//decryption threads
+	GF_List *workers;
+	Bool run_workers;
+	GF_Mutex *job_mx;
+	GF_Semaphore *job_sema;
+	GF_List *job_queue, *job_reservoir;
+};
 
 typedef struct
 {
@@ -139,6 +195,9 @@ typedef struct
 
 
 	u32 rep_crc, per_crc, as_id;
+
+	//samples being decrypted by threads or waiting for them, in decode order
+	GF_List *jobs;
 } GF_CENCDecStream;
 
 
@@ -1561,6 +1620,7 @@ static GF_Err cenc_dec_push_iv(GF_CENCDecStream *cstr, u32 key_idx, u8 *IV, u32
 			GF_LOG(GF_LOG_ERROR, GF_LOG_MEDIA, ("[CENC] Cannot initialize AES-128 AES-128 %s (%s)\n", cstr->is_cenc ? "CTR" : "CBC", gf_error_to_string(e)) );
 			return GF_IO_ERR;
 		}
+		memcpy(cstr->crypts[key_idx].init_key, cstr->crypts[key_idx].key, sizeof(bin128));
 	} else {
 		//always restore IV at beginning of sample regardless of the mode (const IV or IV CBC or CTR)
 		if (!cstr->is_cbc) {
@@ -1588,6 +1648,262 @@ static GF_Err cenc_dec_push_iv(GF_CENCDecStream *cstr, u32 key_idx, u8 *IV, u32
 	return GF_OK;
 }
 
+static GF_Err cenc_dec_push_range(CENCDecKey *dkey, u32 offset, u32 size)
+{
+	if (!size) return GF_OK;
+	if (dkey->nb_ranges == dkey->nb_alloc_ranges) {
+		dkey->nb_alloc_ranges = dkey->nb_alloc_ranges ? 2*dkey->nb_alloc_ranges : 10;
+		dkey->ranges = gf_realloc(dkey->ranges, sizeof(GF_CryptRange) * dkey->nb_alloc_ranges);
+		if (!dkey->ranges) {
+			dkey->nb_alloc_ranges = dkey->nb_ranges = 0;
+			return GF_OUT_OF_MEM;
+		}
+	}
+	dkey->ranges[dkey->nb_ranges].offset = offset;
+	dkey->ranges[dkey->nb_ranges].size = size;
+	dkey->nb_ranges++;
+	return GF_OK;
+}
+
+static CENCDecJob *cenc_dec_new_job(GF_CENCDecCtx *ctx, GF_FilterPacket *out_pck)
+{
+	CENCDecJob *job = gf_list_pop_back(ctx->job_reservoir);
+	if (!job) {
+		GF_SAFEALLOC(job, CENCDecJob);
+		if (!job) return NULL;
+		job->sema = gf_sema_new(1, 0);
+		if (!job->sema) {
+			gf_free(job);
+			return NULL;
+		}
+	}
+	job->out_pck = out_pck;
+	job->nb_ranges = 0;
+	job->done = GF_FALSE;
+	job->wait_signal = GF_FALSE;
+	job->e = GF_OK;
+	return job;
+}
+
+//send packet or queue it if previous packets are still being decrypted
+static GF_Err cenc_dec_send_packet(GF_CENCDecCtx *ctx, GF_CENCDecStream *cstr, GF_FilterPacket *out_pck)
+{
+	CENCDecJob *job;
+	if (!cstr->jobs || !gf_list_count(cstr->jobs)) {
+		gf_filter_pck_send(out_pck);
+		return GF_OK;
+	}
+	job = cenc_dec_new_job(ctx, out_pck);
+	if (!job) {
+		gf_filter_pck_discard(out_pck);
+		return GF_OUT_OF_MEM;
+	}
+	job->done = GF_TRUE;
+	gf_list_add(cstr->jobs, job);
+	return GF_OK;
+}
+
+//hand sample decryption over to decryption threads, using ranges of first key (single key only)
+static GF_Err cenc_dec_queue_job(GF_CENCDecCtx *ctx, GF_CENCDecStream *cstr, GF_FilterPacket *out_pck, u8 *out_data, u32 crypt_block, u32 skip_block)
+{
+	GF_CryptRange *ranges;
+	u32 nb_alloc;
+	CENCDecKey *dkey = &cstr->crypts[0];
+	CENCDecJob *job = cenc_dec_new_job(ctx, out_pck);
+	if (!job) return GF_OUT_OF_MEM;
+
+	job->data = out_data;
+	job->is_cbc = cstr->is_cbc;
+	memcpy(job->key, dkey->init_key, sizeof(bin128));
+	job->IV_size = 17;
+	gf_crypt_get_IV(dkey->crypt, job->IV, &job->IV_size);
+	job->use_const_IV = dkey->use_const_IV;
+	memcpy(job->const_IV, dkey->const_IV, 16);
+	job->crypt_block = crypt_block;
+	job->skip_block = skip_block;
+	//swap range buffers
+	ranges = job->ranges;
+	nb_alloc = job->nb_alloc_ranges;
+	job->ranges = dkey->ranges;
+	job->nb_ranges = dkey->nb_ranges;
+	job->nb_alloc_ranges = dkey->nb_alloc_ranges;
+	dkey->ranges = ranges;
+	dkey->nb_alloc_ranges = nb_alloc;
+	dkey->nb_ranges = 0;
+
+	gf_filter_pck_set_property(out_pck, GF_PROP_PCK_CENC_SAI, NULL);
+	gf_filter_pck_set_crypt_flags(out_pck, 0);
+	gf_list_add(cstr->jobs, job);
+
+	//nothing to decrypt
+	if (!job->nb_ranges) {
+		job->done = GF_TRUE;
+		return GF_OK;
+	}
+	job->wait_signal = GF_TRUE;
+	gf_mx_p(ctx->job_mx);
+	gf_list_add(ctx->job_queue, job);
+	gf_mx_v(ctx->job_mx);
+	gf_sema_notify(ctx->job_sema, 1);
+	return GF_OK;
+}
+
+//wait for the decryption thread to be done with the job
+static void cenc_dec_wait_job(CENCDecJob *job)
+{
+	if (!job->wait_signal) return;
+	gf_sema_wait(job->sema);
+	job->wait_signal = GF_FALSE;
+}
+
+//send decrypted packets in order, waiting for decryption threads if wait is set
+static GF_Err cenc_dec_flush_jobs(GF_CENCDecCtx *ctx, GF_CENCDecStream *cstr, Bool wait, Bool discard)
+{
+	GF_Err e = GF_OK;
+	CENCDecJob *job;
+	if (!cstr->jobs) return GF_OK;
+
+	while ((job = gf_list_get(cstr->jobs, 0))) {
+		if (!wait) {
+			Bool done;
+			gf_mx_p(ctx->job_mx);
+			done = job->done;
+			gf_mx_v(ctx->job_mx);
+			if (!done) break;
+		}
+		//consume the completion notification, blocking until done if waiting
+		cenc_dec_wait_job(job);
+		gf_list_rem(cstr->jobs, 0);
+		if (job->e) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_MEDIA, ("[CENC] Failed to decrypt sample: %s\n", gf_error_to_string(job->e) ));
+			if (!e) e = job->e;
+		}
+		if (discard || job->e)
+			gf_filter_pck_discard(job->out_pck);
+		else
+			gf_filter_pck_send(job->out_pck);
+		job->out_pck = NULL;
+		gf_list_add(ctx->job_reservoir, job);
+	}
+	return e;
+}
+
+static void cenc_dec_run_job(CENCDecWorker *w, CENCDecJob *job)
+{
+	GF_Crypt **crypt = job->is_cbc ? &w->cbc : &w->ctr;
+	u8 *key = job->is_cbc ? w->cbc_key : w->ctr_key;
+
+	if (! *crypt) {
+		*crypt = gf_crypt_open(GF_AES_128, job->is_cbc ? GF_CBC : GF_CTR);
+		if (! *crypt) {
+			job->e = GF_OUT_OF_MEM;
+			return;
+		}
+		job->e = gf_crypt_init(*crypt, job->key, NULL);
+		if (job->e) {
+			//crypt is destroyed by gf_crypt_init upon failure
+			*crypt = NULL;
+			return;
+		}
+		memcpy(key, job->key, sizeof(bin128));
+	} else if (memcmp(key, job->key, sizeof(bin128))) {
+		gf_crypt_set_key(*crypt, job->key);
+		memcpy(key, job->key, sizeof(bin128));
+	}
+	job->e = gf_crypt_set_IV(*crypt, job->IV, job->IV_size);
+	if (job->e) return;
+	job->e = gf_crypt_decrypt_ranges(*crypt, job->data, job->ranges, job->nb_ranges, job->crypt_block, job->skip_block, job->use_const_IV ? job->const_IV : NULL);
+}
+
+static u32 cenc_dec_worker_run(void *par)
+{
+	CENCDecWorker *w = (CENCDecWorker *)par;
+	GF_CENCDecCtx *ctx = w->ctx;
+
+	while (ctx->run_workers) {
+		CENCDecJob *job;
+		gf_mx_p(ctx->job_mx);
+		job = gf_list_pop_front(ctx->job_queue);
+		gf_mx_v(ctx->job_mx);
+		if (!job) {
+			gf_sema_wait_for(ctx->job_sema, 100);
+			continue;
+		}
+		cenc_dec_run_job(w, job);
+
+		gf_mx_p(ctx->job_mx);
+		job->done = GF_TRUE;
+		gf_mx_v(ctx->job_mx);
+		gf_sema_notify(job->sema, 1);
+		gf_filter_post_process_task(ctx->filter);
+	}
+	return 0;
+}
+
+static void cenc_dec_del_workers(GF_CENCDecCtx *ctx)
+{
+	ctx->run_workers = GF_FALSE;
+	while (gf_list_count(ctx->workers)) {
+		CENCDecWorker *w = gf_list_pop_back(ctx->workers);
+		if (w->th) {
+			if (ctx->job_sema) gf_sema_notify(ctx->job_sema, 1);
+			gf_th_stop(w->th);
+			gf_th_del(w->th);
+		}
+		if (w->ctr) gf_crypt_close(w->ctr);
+		if (w->cbc) gf_crypt_close(w->cbc);
+		gf_free(w);
+	}
+	gf_list_del(ctx->workers);
+	ctx->workers = NULL;
+
+	while (gf_list_count(ctx->job_reservoir)) {
+		CENCDecJob *job = gf_list_pop_back(ctx->job_reservoir);
+		if (job->ranges) gf_free(job->ranges);
+		if (job->sema) gf_sema_del(job->sema);
+		gf_free(job);
+	}
+	gf_list_del(ctx->job_reservoir);
+	ctx->job_reservoir = NULL;
+	//jobs are moved back to reservoir when streams are destroyed
+	gf_list_del(ctx->job_queue);
+	ctx->job_queue = NULL;
+	if (ctx->job_sema) gf_sema_del(ctx->job_sema);
+	ctx->job_sema = NULL;
+	if (ctx->job_mx) gf_mx_del(ctx->job_mx);
+	ctx->job_mx = NULL;
+}
+
+static GF_Err cenc_dec_create_workers(GF_CENCDecCtx *ctx)
+{
+	u32 i;
+	ctx->workers = gf_list_new();
+	ctx->job_queue = gf_list_new();
+	ctx->job_reservoir = gf_list_new();
+	ctx->job_mx = gf_mx_new("CENCDecJobs");
+	ctx->job_sema = gf_sema_new(GF_INT_MAX, 0);
+	if (!ctx->workers || !ctx->job_queue || !ctx->job_reservoir || !ctx->job_mx || !ctx->job_sema)
+		return GF_OUT_OF_MEM;
+
+	ctx->run_workers = GF_TRUE;
+	for (i=0; i<ctx->nbth; i++) {
+		CENCDecWorker *w;
+		GF_SAFEALLOC(w, CENCDecWorker);
+		if (!w) return GF_OUT_OF_MEM;
+		gf_list_add(ctx->workers, w);
+		w->ctx = ctx;
+		w->th = gf_th_new("CENCDecWorker");
+		if (!w->th) return GF_OUT_OF_MEM;
+		if (gf_th_run(w->th, cenc_dec_worker_run, w) != GF_OK) {
+			gf_th_del(w->th);
+			w->th = NULL;
+			return GF_IO_ERR;
+		}
+	}
+	GF_LOG(GF_LOG_INFO, GF_LOG_MEDIA, ("[CENC] Using %d decryption threads\n", ctx->nbth));
+	return GF_OK;
+}
+
 u8 key_info_get_iv_size(const u8 *key_info, u32 nb_keys, u32 idx, u8 *const_iv_size, const u8 **const_iv);
 
 
@@ -1605,6 +1921,12 @@ static GF_Err cenc_dec_process_cenc(GF_CENCDecCtx *ctx, GF_CENCDecStream *cstr,
 	u32 skey_const_iv_size = 0;
 	Bool has_subsamples = GF_FALSE;
 	const u8 *skey_const_iv = NULL;
+	u32 i, crypt_block=0, skip_block=0;
+
+	for (i=0; i<cstr->nb_crypts; i++) {
+		cstr->crypts[i].nb_ranges = 0;
+		cstr->crypts[i].use_const_IV = GF_FALSE;
+	}
 
 	//packet has been fetched, we now MUST have a key info
 	if (!cstr->cenc_ki) {
@@ -1624,8 +1946,7 @@ static GF_Err cenc_dec_process_cenc(GF_CENCDecCtx *ctx, GF_CENCDecStream *cstr,
 		gf_filter_pck_merge_properties(in_pck, out_pck);
 		gf_filter_pck_set_property(out_pck, GF_PROP_PCK_CENC_SAI, NULL);
 		gf_filter_pck_set_crypt_flags(out_pck, 0);
-		gf_filter_pck_send(out_pck);
-		return GF_OK;
+		return cenc_dec_send_packet(ctx, cstr, out_pck);
 	}
 
 
@@ -1750,7 +2071,13 @@ static GF_Err cenc_dec_process_cenc(GF_CENCDecCtx *ctx, GF_CENCDecStream *cstr,
 		goto send_packet;
 	}
 
+	if (cstr->cenc_pattern) {
+		crypt_block = cstr->cenc_pattern->value.frac.den;
+		skip_block = cstr->cenc_pattern->value.frac.num;
+	}
+
 	//sub-sample encryption, always on for multikey
+	//ranges are gathered per key and decrypted once the sample is parsed
 	if (subsample_count || cstr->multikey) {
 		u32 cur_pos = 0;
 
@@ -1800,8 +2127,8 @@ static GF_Err cenc_dec_process_cenc(GF_CENCDecCtx *ctx, GF_CENCDecStream *cstr,
 			subsample_count--;
 
 			//const IV is applied at each subsample
-			if (const_iv_size) {
-				u8 IV[17];
+			if (const_iv_size && !cstr->crypts[kidx].use_const_IV) {
+				u8 *IV = cstr->crypts[kidx].const_IV;
 				memcpy(IV, const_iv, const_iv_size);
 				if (const_iv_size == 8)
 					memset(IV+8, 0, sizeof(char)*8);
@@ -1809,7 +2136,7 @@ static GF_Err cenc_dec_process_cenc(GF_CENCDecCtx *ctx, GF_CENCDecStream *cstr,
 				if (cstr->force_hls_iv)
 					memcpy(IV, cstr->hls_IV, sizeof(bin128));
 
-				gf_crypt_set_IV(cstr->crypts[kidx].crypt, IV, 16);
+				cstr->crypts[kidx].use_const_IV = GF_TRUE;
 			}
 			if (cur_pos + bytes_clear_data + bytes_encrypted_data > data_size) {
 				GF_LOG(GF_LOG_ERROR, GF_LOG_MEDIA, ("[CENC] Corrupted CENC sai, subsample info describe more bytes (%d) than in packet (%d)\n", cur_pos + bytes_clear_data + bytes_encrypted_data , data_size ));
@@ -1824,41 +2151,23 @@ static GF_Err cenc_dec_process_cenc(GF_CENCDecCtx *ctx, GF_CENCDecStream *cstr,
 				continue;
 			}
 
-			//pattern decryption
-			if (cstr->cenc_pattern) {
-				u32 pos = cur_pos;
-				u32 res = bytes_encrypted_data;
-				u32 cryp_block = 16 * cstr->cenc_pattern->value.frac.den;
-				u32 full_block = 16 * (cstr->cenc_pattern->value.frac.den + cstr->cenc_pattern->value.frac.num);
-
-				if (cstr->is_cbc) {
-					u32 clear_trailing = res % 16;
-					res -= clear_trailing;
-				}
-
-				while (res) {
-					gf_crypt_decrypt(cstr->crypts[kidx].crypt, out_data + pos, (res >= cryp_block) ? cryp_block : res);
-					if (res >= full_block) {
-						pos += full_block;
-						gf_assert(res>=full_block);
-						res -= full_block;
-					} else {
-						res = 0;
-					}
-				}
+			//pattern with no encrypted block
+			if (cstr->cenc_pattern && !crypt_block) {
+				cur_pos += bytes_encrypted_data;
+				continue;
 			}
-			//full subsample decryption
-			else {
+			{
 				u32 res = bytes_encrypted_data;
 				//trailing will be 0 in cbc1 (as cbc1 mandates bytes_encrypted_data % 16 == 0)
-				//but can be non-0 in cbcs NALU-based without pattern (not defined in CENC)
+				//but can be non-0 in cbcs NALU-based (with or without pattern)
 				//in this case, we must only decrypt a multiple of 16-byte blocks
 				//note that vpX cbcs mandates bytes_encrypted_data % 16 == 0, as cbc1
 				if (cstr->is_cbc) {
 					u32 clear_trailing = res % 16;
 					res -= clear_trailing;
 				}
-				gf_crypt_decrypt(cstr->crypts[kidx].crypt, out_data+cur_pos, res);
+				e = cenc_dec_push_range(&cstr->crypts[kidx], cur_pos, res);
+				if (e) goto exit;
 			}
 			cur_pos += bytes_encrypted_data;
 		}
@@ -1866,20 +2175,38 @@ static GF_Err cenc_dec_process_cenc(GF_CENCDecCtx *ctx, GF_CENCDecStream *cstr,
 	//full sample encryption in single key mode
 	else {
 		if (cstr->is_cenc) {
-			gf_crypt_decrypt(cstr->crypts[0].crypt, out_data, data_size);
+			e = cenc_dec_push_range(&cstr->crypts[0], 0, data_size);
 		} else {
 			u32 ret = data_size % 16;
 			if (data_size >= 16) {
-				gf_crypt_decrypt(cstr->crypts[0].crypt, out_data, data_size-ret);
+				e = cenc_dec_push_range(&cstr->crypts[0], 0, data_size-ret);
 			}
 		}
+		if (e) goto exit;
+		//pattern does not apply to full sample encryption
+		crypt_block = skip_block = 0;
+	}
+
+	//hand sample over to decryption threads, single key only
+	if (ctx->workers && !cstr->multikey) {
+		e = cenc_dec_queue_job(ctx, cstr, out_pck, out_data, crypt_block, skip_block);
+		if (e) goto exit;
+		return GF_OK;
+	}
+
+	for (i=0; i<cstr->nb_crypts; i++) {
+		CENCDecKey *dkey = &cstr->crypts[i];
+		if (!dkey->nb_ranges) continue;
+		e = gf_crypt_decrypt_ranges(dkey->crypt, out_data, dkey->ranges, dkey->nb_ranges, crypt_block, skip_block, dkey->use_const_IV ? dkey->const_IV : NULL);
+		dkey->nb_ranges = 0;
+		if (e) goto exit;
 	}
 
 send_packet:
 	gf_filter_pck_set_property(out_pck, GF_PROP_PCK_CENC_SAI, NULL);
 	gf_filter_pck_set_crypt_flags(out_pck, 0);
 
-	gf_filter_pck_send(out_pck);
+	return cenc_dec_send_packet(ctx, cstr, out_pck);
 
 exit:
 	if (e && out_pck) {
@@ -2126,10 +2453,15 @@ static GF_Err cenc_dec_process_adobe(GF_CENCDecCtx *ctx, GF_CENCDecStream *cstr,
 
 static void cenc_dec_stream_del(GF_CENCDecStream *cstr)
 {
+	if (cstr->jobs) {
+		cenc_dec_flush_jobs(cstr->ctx, cstr, GF_TRUE, GF_TRUE);
+		gf_list_del(cstr->jobs);
+	}
 	if (cstr->crypts) {
 		u32 i;
 		for (i=0; i<cstr->nb_crypts; i++) {
 			if (cstr->crypts[i].crypt) gf_crypt_close(cstr->crypts[i].crypt);
+			if (cstr->crypts[i].ranges) gf_free(cstr->crypts[i].ranges);
 		}
 		gf_free(cstr->crypts);
 	}
@@ -2181,6 +2513,10 @@ static GF_Err cenc_dec_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool
 		cstr->ipid = pid;
 		cstr->ctx = ctx;
 		gf_list_add(ctx->streams, cstr);
+		if (ctx->workers) {
+			cstr->jobs = gf_list_new();
+			if (!cstr->jobs) return GF_OUT_OF_MEM;
+		}
 		gf_filter_pid_set_udta(pid, cstr);
 		gf_filter_pid_set_udta(cstr->opid, cstr);
 		//we need full sample
@@ -2344,8 +2680,11 @@ static Bool cenc_dec_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 		} else {
 			cenc_dec_access_isma(ctx, cstr, is_play);
 		}
-		if (!is_play)
+		if (!is_play) {
 			cstr->crypt_init = GF_FALSE;
+			//drop samples still being decrypted
+			cenc_dec_flush_jobs(ctx, cstr, GF_TRUE, GF_TRUE);
+		}
 		break;
 	default:
 		break;
@@ -2356,17 +2695,33 @@ static GF_Err cenc_dec_process(GF_Filter *filter)
 {
 	GF_CENCDecCtx *ctx = (GF_CENCDecCtx *)gf_filter_get_udta(filter);
 	u32 i, nb_eos, count = gf_list_count(ctx->streams);
+	Bool has_jobs, has_input;
 
 	if (ctx->pending_keys)
 		return GF_OK;
 
+restart:
 	nb_eos = 0;
+	has_jobs = has_input = GF_FALSE;
 	for (i=0; i<count; i++) {
 		GF_Err e;
+		GF_FilterPacket *pck;
 		GF_CENCDecStream *cstr = gf_list_get(ctx->streams, i);
-		GF_FilterPacket *pck = gf_filter_pid_get_packet(cstr->ipid);
+
+		//send samples decrypted by threads
+		if (cstr->jobs) {
+			e = cenc_dec_flush_jobs(ctx, cstr, GF_FALSE, GF_FALSE);
+			if (e) return e;
+			if (gf_list_count(cstr->jobs)) has_jobs = GF_TRUE;
+		}
+
+next_packet:
+		pck = gf_filter_pid_get_packet(cstr->ipid);
 		if (!pck) {
 			if (gf_filter_pid_is_eos(cstr->ipid)) {
+				//wait for threads to be done before signaling eos
+				if (cstr->jobs && gf_list_count(cstr->jobs))
+					continue;
 				nb_eos++;
 				gf_filter_pid_set_eos(cstr->opid);
 			}
@@ -2391,6 +2746,29 @@ static GF_Err cenc_dec_process(GF_Filter *filter)
 		}
 		gf_filter_pid_drop_packet(cstr->ipid);
 		if (e) return e;
+
+		//decrypt several samples in parallel
+		if (cstr->jobs && gf_list_count(cstr->jobs)) {
+			has_jobs = GF_TRUE;
+			if (gf_list_count(cstr->jobs) < CENC_DEC_JOBS_PER_THREAD*ctx->nbth)
+				goto next_packet;
+			if (gf_filter_pid_get_packet(cstr->ipid)) has_input = GF_TRUE;
+		}
+	}
+	//job queue full or no more input, wait for the oldest sample being decrypted instead of polling
+	//if input is pending we will be called again, otherwise loop until all jobs are done
+	//since the session would end if no task is pending when the last jobs are done
+	if (has_jobs) {
+		for (i=0; i<count; i++) {
+			GF_CENCDecStream *cstr = gf_list_get(ctx->streams, i);
+			CENCDecJob *job = cstr->jobs ? gf_list_get(cstr->jobs, 0) : NULL;
+			if (job) {
+				cenc_dec_wait_job(job);
+				break;
+			}
+		}
+		if (has_input) return GF_OK;
+		goto restart;
 	}
 	if (nb_eos && (nb_eos==count)) return GF_EOS;
 	return GF_OK;
@@ -2419,6 +2797,14 @@ static GF_Err cenc_dec_initialize(GF_Filter *filter)
 		}
 	}
 	ctx->bs_r = gf_bs_new((char *) ctx, 1, GF_BITSTREAM_READ);
+
+	if (ctx->nbth) {
+		GF_Err e = cenc_dec_create_workers(ctx);
+		if (e) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_MEDIA, ("[CENCCrypt] Failed to create decryption threads: %s\n", gf_error_to_string(e) ));
+			return e;
+		}
+	}
 	return GF_OK;
 }
 
@@ -2431,6 +2817,8 @@ static void cenc_dec_finalize(GF_Filter *filter)
 		cenc_dec_stream_del(cstr);
 	}
 	gf_list_del(ctx->streams);
+	//after streams, since destroying streams waits for pending samples
+	if (ctx->workers) cenc_dec_del_workers(ctx);
 
 	if (ctx->bs_r) gf_bs_del(ctx->bs_r);
 	if (ctx->cinfo) gf_crypt_info_del(ctx->cinfo);
@@ -2470,6 +2858,7 @@ static const GF_FilterArgs GF_CENCDecArgs[] =
 	{ OFFS(kids), "define KIDs. If `keys` is empty, consider keys with given KID (as hex string) as not available (debug)", GF_PROP_STRING_LIST, NULL, NULL, GF_ARG_HINT_EXPERT},
 	{ OFFS(keys), "define key values for each of the specified KID", GF_PROP_STRING_LIST, NULL, NULL, GF_ARG_HINT_EXPERT},
 	{ OFFS(hls_cenc_patch_iv), "ignore IV updates in some broken HLS+CENC streams", GF_PROP_BOOL, "false", NULL, GF_ARG_HINT_EXPERT},
+	{ OFFS(nbth), "number of decryption threads for single-key CENC streams, 0 decrypts on the filter thread (see filter help)", GF_PROP_UINT, "0", NULL, GF_ARG_HINT_EXPERT},
 	{0}
 };
 
@@ -2485,6 +2874,9 @@ GF_FilterRegister CENCDecRegister = {
 	"or set at the filter level using [-cfile]() (lowest priority).\n"
 	"When the file is set per PID, the first `CryptInfo` with the same ID is used, otherwise the first `CryptInfo` is used."
 	"When the file is set globally (not per PID), the first `CrypTrack` in the DRM config file with the same ID is used, otherwise the first `CrypTrack` with ID 0 or not set is used.\n"
+	"\n"
+	"When [-nbth]() is set, CENC samples using a single key are decrypted by a pool of threads, several samples being decrypted in parallel. "
+	"The sample auxiliary information is still parsed on the filter thread, and packets are output in their original order.\n"
 	)
 	.private_size = sizeof(GF_CENCDecCtx),
 	.flags = GF_FS_REG_USE_SYNC_READ,
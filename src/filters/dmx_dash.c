@@ -79,7 +79,7 @@ typedef struct
 	u32 use_bmin;
 	char *query;
 	Bool noxlink, split_as, noseek, groupsel, bsmerge;
-	u32 lowlat;
+	u32 lowlat, prefetch;
 
 	GF_FilterPid *mpd_pid;
 	GF_Filter *filter;
@@ -137,6 +137,17 @@ typedef struct
 	GF_FilterPacket *mpd_pck_ref;
 } GF_DASHDmxCtx;
 
+#ifdef GPAC_USE_DOWNLOADER
+//download of an upcoming segment, issued in parallel with the one being played
+typedef struct
+{
+	GF_DownloadSession *sess;
+	char *url;
+	u64 start_range, end_range;
+	Bool in_use;
+} GF_DASHPrefetch;
+#endif
+
 typedef struct
 {
 	GF_DASHDmxCtx *ctx;
@@ -155,6 +166,9 @@ typedef struct
 
 #ifdef GPAC_USE_DOWNLOADER
 	GF_DownloadSession *sess;
+	//list of GF_DASHPrefetch, and prefetch entry of the segment being played if any
+	GF_List *prefetch;
+	GF_DASHPrefetch *cur_prefetch;
 #endif
 	Bool is_timestamp_based, pto_setup;
 	Bool prev_is_init_segment, init_from_media;
@@ -603,6 +617,11 @@ static GF_Err dashdmx_load_source(GF_DASHDmxCtx *ctx, u32 group_index, const cha
 			if (!has_sep) { gf_dynstrcat(&sURL, "gpac", szSep); has_sep = GF_TRUE; }
 			gf_dynstrcat(&sURL, szOpt, szSep);
 		}
+		//audio first then video then others (subtitles, metadata) when connections per origin are limited
+		if (mime && (!strnicmp(mime, "audio/", 6) || !strnicmp(mime, "video/", 6))) {
+			sprintf(szOpt, "prio%c%d", sep_name, !strnicmp(mime, "audio/", 6) ? 2 : 1);
+			gf_dynstrcat(&sURL, szOpt, szSep);
+		}
 	}
 
 	if (start_range || end_range) {
@@ -874,6 +893,148 @@ u32 dashdmx_io_get_bytes_done(GF_DASHFileIO *dashio, GF_DASHFileIOSession sessio
 }
 #endif
 
+#ifdef GPAC_USE_DOWNLOADER
+static void dashdmx_prefetch_del(GF_DASHPrefetch *pf, Bool purge_cache)
+{
+	if (pf->sess) {
+		//not consumed by the segment source, purge it from the cache (otherwise done by the source upon switching)
+		if (purge_cache)
+			gf_dm_delete_cached_file_entry_session(pf->sess, pf->url, GF_FALSE);
+		gf_dm_sess_del(pf->sess);
+	}
+	gf_free(pf->url);
+	gf_free(pf);
+}
+
+static void dashdmx_prefetch_reset(GF_DASHGroup *group)
+{
+	while (gf_list_count(group->prefetch)) {
+		GF_DASHPrefetch *pf = gf_list_pop_back(group->prefetch);
+		dashdmx_prefetch_del(pf, (pf==group->cur_prefetch) ? GF_FALSE : GF_TRUE);
+	}
+	gf_list_del(group->prefetch);
+	group->prefetch = NULL;
+	group->cur_prefetch = NULL;
+}
+
+static GF_DASHPrefetch *dashdmx_prefetch_find(GF_DASHGroup *group, const char *url, u64 start_range, u64 end_range)
+{
+	u32 i, count = gf_list_count(group->prefetch);
+	for (i=0; i<count; i++) {
+		GF_DASHPrefetch *pf = gf_list_get(group->prefetch, i);
+		if (strcmp(pf->url, url)) continue;
+		if ((pf->start_range != start_range) || (pf->end_range != end_range)) continue;
+		return pf;
+	}
+	return NULL;
+}
+
+static Bool dashdmx_prefetch_done(GF_DASHPrefetch *pf)
+{
+	GF_NetIOStatus status;
+	GF_Err e = gf_dm_sess_get_stats(pf->sess, NULL, NULL, NULL, NULL, NULL, &status);
+	if (status==GF_NETIO_DATA_TRANSFERED) return GF_TRUE;
+	//session may move to disconnect state upon completion
+	if ((status==GF_NETIO_DISCONNECTED) && (e>=GF_OK)) return GF_TRUE;
+	return GF_FALSE;
+}
+
+//issue downloads for the segments queued after the one being played, dropping the ones no longer queued
+static void dashdmx_prefetch_update(GF_DASHDmxCtx *ctx, GF_DASHGroup *group)
+{
+	u32 i, count;
+
+	if (!group->is_playing) {
+		if (group->prefetch) dashdmx_prefetch_reset(group);
+		return;
+	}
+	if (!ctx->prefetch || !group->segment_sent || group->in_is_cryptfile || group->nb_group_deps)
+		return;
+
+	if (!group->prefetch) {
+		group->prefetch = gf_list_new();
+		if (!group->prefetch) return;
+	}
+	count = gf_list_count(group->prefetch);
+	for (i=0; i<count; i++) {
+		GF_DASHPrefetch *pf = gf_list_get(group->prefetch, i);
+		pf->in_use = (pf==group->cur_prefetch) ? GF_TRUE : GF_FALSE;
+	}
+
+	//queue index 0 is the segment being played
+	for (i=1; i<=ctx->prefetch; i++) {
+		GF_Err e;
+		u32 flags;
+		const char *url;
+		u64 start_range, end_range;
+		GF_DASHPrefetch *pf;
+
+		e = gf_dash_group_get_queued_segment_location(ctx->dash, group->idx, i, &url, &start_range, &end_range);
+		if (e==GF_BUFFER_TOO_SMALL) break;
+		if (e || !url) continue;
+		if (strnicmp(url, "http://", 7) && strnicmp(url, "https://", 8)) continue;
+		//open byte range (merged LL-HLS parts), the resource is still being produced
+		if (end_range == (u64) -1) continue;
+
+		pf = dashdmx_prefetch_find(group, url, start_range, end_range);
+		if (pf) {
+			pf->in_use = GF_TRUE;
+			continue;
+		}
+
+		flags = GF_NETIO_SESSION_NO_BLOCK | GF_NETIO_SESSION_PERSISTENT;
+		if (!ctx->segstore) flags |= GF_NETIO_SESSION_MEMORY_CACHE;
+
+		GF_SAFEALLOC(pf, GF_DASHPrefetch);
+		if (!pf) return;
+		pf->sess = gf_dm_sess_new(ctx->dm, url, flags, NULL, NULL, &e);
+		if (!pf->sess) {
+			gf_free(pf);
+			continue;
+		}
+		gf_dm_sess_set_netcap_id(pf->sess, gf_filter_get_netcap_id(ctx->filter));
+		if (start_range || end_range)
+			gf_dm_sess_set_range(pf->sess, start_range, end_range, GF_TRUE);
+		pf->url = gf_strdup(url);
+		pf->start_range = start_range;
+		pf->end_range = end_range;
+		pf->in_use = GF_TRUE;
+		gf_list_add(group->prefetch, pf);
+
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_DASH, ("[DASHDmx] group %d prefetching segment %s\n", group->idx, url));
+		gf_dm_sess_process(pf->sess);
+	}
+
+	count = gf_list_count(group->prefetch);
+	for (i=0; i<count; i++) {
+		GF_DASHPrefetch *pf = gf_list_get(group->prefetch, i);
+		if (pf->in_use) continue;
+		gf_list_rem(group->prefetch, i);
+		i--;
+		count--;
+		dashdmx_prefetch_del(pf, GF_TRUE);
+	}
+}
+
+//download rate of a prefetched segment, including the rate of the other prefetches still in flight for this group
+static u32 dashdmx_prefetch_rate(GF_DASHGroup *group, GF_DASHPrefetch *cur_pf, u64 *file_size)
+{
+	u32 i, count, bytes_per_sec=0, rate=0;
+	gf_dm_sess_get_stats(cur_pf->sess, NULL, NULL, file_size, NULL, &bytes_per_sec, NULL);
+
+	count = gf_list_count(group->prefetch);
+	for (i=0; i<count; i++) {
+		GF_NetIOStatus status;
+		GF_DASHPrefetch *pf = gf_list_get(group->prefetch, i);
+		if (pf == cur_pf) continue;
+		gf_dm_sess_get_stats(pf->sess, NULL, NULL, NULL, NULL, &rate, &status);
+		if (status==GF_NETIO_DATA_EXCHANGE)
+			bytes_per_sec += rate;
+	}
+	return bytes_per_sec;
+}
+#endif
+
 #ifdef GPAC_HAS_QJS
 #include <gpac/mpd.h>
 void dashdmx_js_declare_group(GF_DASHDmxCtx *ctx, u32 group_idx)
@@ -1199,6 +1360,9 @@ GF_Err dashdmx_io_on_dash_event(GF_DASHFileIO *dashio, GF_DASHEventType dash_evt
 			}
 			if (group->template) gf_free(group->template);
 			if (group->current_url) gf_free(group->current_url);
+#ifdef GPAC_USE_DOWNLOADER
+			if (group->prefetch) dashdmx_prefetch_reset(group);
+#endif
 			gf_free(group);
 			gf_dash_set_group_udta(ctx->dash, i, NULL);
 		}
@@ -2392,6 +2556,7 @@ static GF_Err dashdmx_initialize(GF_Filter *filter)
 	gf_dash_set_switching_probe_count(ctx->dash, ctx->switch_count);
 	gf_dash_set_agressive_adaptation(ctx->dash, ctx->aggressive);
 	gf_dash_enable_single_range_llhls(ctx->dash, ctx->llhls_merge);
+	gf_dash_set_prefetch_depth(ctx->dash, ctx->prefetch);
 	gf_dash_debug_groups(ctx->dash, ctx->debug_as.vals, ctx->debug_as.nb_items);
 	gf_dash_disable_speed_adaptation(ctx->dash, !ctx->speedadapt);
 	gf_dash_ignore_xlink(ctx->dash, ctx->noxlink);
@@ -2884,6 +3049,12 @@ static void dashdmx_update_group_stats(GF_DASHDmxCtx *ctx, GF_DASHGroup *group)
 	if (p && p->value.string && !strcmp(p->value.string, "yes")) {
 		broadcast_flag = GF_TRUE;
 	}
+#ifdef GPAC_USE_DOWNLOADER
+	//segment was fetched ahead of time, the source only read it from cache: use the prefetch rate
+	if (group->cur_prefetch && dashdmx_prefetch_done(group->cur_prefetch)) {
+		bytes_per_sec = dashdmx_prefetch_rate(group, group->cur_prefetch, &file_size);
+	}
+#endif
 	if (group->nb_group_deps)
 		dep_rep_idx = group->current_group_dep ? (group->current_group_dep-1) : group->nb_group_deps;
 	else
@@ -3107,7 +3278,17 @@ fetch_next:
 	evt.seek.start_offset = start_range;
 	evt.seek.end_offset = end_range;
 	evt.seek.is_init_segment = GF_FALSE;
+#ifdef GPAC_USE_DOWNLOADER
+	group->cur_prefetch = group->prefetch ? dashdmx_prefetch_find(group, next_url, start_range, end_range) : NULL;
+	//prefetch done, use cache entry without revalidation - if still in progress, the source will attach to the pending download
+	if (group->cur_prefetch && dashdmx_prefetch_done(group->cur_prefetch))
+		evt.seek.skip_cache_expiration = GF_TRUE;
+#endif
 	gf_filter_send_event(group->seg_filter_src, &evt, GF_FALSE);
+
+#ifdef GPAC_USE_DOWNLOADER
+	dashdmx_prefetch_update(ctx, group);
+#endif
 }
 
 static GF_Err dashin_abort(GF_DASHDmxCtx *ctx)
@@ -3210,6 +3391,17 @@ GF_Err dashdmx_process(GF_Filter *filter)
 	if (next_time_ms>1000)
 		next_time_ms=1000;
 
+#ifdef GPAC_USE_DOWNLOADER
+	//more segments may have been queued by the dash client
+	if (ctx->prefetch) {
+		count = gf_dash_get_group_count(ctx->dash);
+		for (i=0; i<count; i++) {
+			GF_DASHGroup *group = gf_dash_get_group_udta(ctx->dash, i);
+			if (group) dashdmx_prefetch_update(ctx, group);
+		}
+	}
+#endif
+
 	count = gf_filter_get_ipid_count(filter);
 
 	if (ctx->compute_min_dts)
@@ -3566,6 +3758,7 @@ static const GF_FilterArgs DASHDmxArgs[] =
 
 	{ OFFS(skip_lqt), "disable decoding of tiles with highest degradation hints (not visible, not gazed at) for debug purposes", GF_PROP_BOOL, "no", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(llhls_merge), "merge LL-HLS byte range parts into a single open byte range request", GF_PROP_BOOL, "yes", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(prefetch), "number of upcoming segments to download in parallel with the segment being played, for HTTP(S) sessions. LL-HLS parts are prefetched as separate byte range requests only if [-llhls_merge]() is not set", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(groupsel), "select groups based on language (by default all playable groups are exposed)", GF_PROP_BOOL, "no", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(chain_mode), "MPD chaining mode\n"
 	"- off: do not use MPD chaining\n"
@@ -30,6 +30,7 @@
 #include <gpac/bitstream.h>
 #include <gpac/base_coding.h>
 #include <gpac/network.h>
+#include <gpac/thread.h>
 
 #ifndef GPAC_DISABLE_GHIDMX
 
@@ -85,18 +86,45 @@ enum
 	GHI_GM_INIT,
 };
 
+typedef struct
+{
+	const char *rep_id;
+	u32 sn;
+} GHISegJob;
+
+typedef struct
+{
+	char *src_args, *dst;
+	const char *dst_opts;
+	GF_PropStringList *filters;
+	GHISegJob *jobs;
+	u32 nb_jobs, next_job, nb_done, nb_errors;
+	GF_Mutex *mx;
+	GF_Thread **threads;
+	u32 nb_threads;
+	u64 clock;
+} GHISegGen;
+
 typedef struct
 {
 	//options
 	u32 gm;
 	Bool force;
 	GF_PropStringList mux;
-	char *rep, *out;
+	char *rep, *out, *seg;
 	u32 sn;
+	u32 segth;
+	GF_PropStringList segf;
+	char *segopts;
 
 	//internal
 	GF_FilterPid *ipid;
 	Bool init;
+	GHISegGen *seg_gen;
+	Bool segs_started;
+	//output PIDs waiting for segment generation to be done before signaling end of stream
+	GF_List *seg_eos_pids;
+	GF_Err seg_err;
 	GF_List *streams;
 
 	u32 segment_duration;
@@ -222,6 +250,12 @@ static void ghi_dmx_send_seg_times(GHIDmxCtx *ctx, GHIStream *st, GF_FilterPid *
 		gf_filter_pck_set_seek_flag(pck, GF_TRUE);
 		gf_filter_pck_send(pck);
 	}
+	//segments being generated, end of stream is signaled once done
+	if (ctx->seg_gen) {
+		if (!ctx->seg_eos_pids) ctx->seg_eos_pids = gf_list_new();
+		gf_list_add(ctx->seg_eos_pids, opid);
+		return;
+	}
 	gf_filter_pid_set_eos(opid);
 }
 
@@ -298,6 +332,192 @@ GF_Err ghi_dmx_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remov
 	return GF_OK;
 }
 
+static GF_Err ghi_dmx_run_seg_job(GHISegGen *gen, GHISegJob *job)
+{
+	GF_Err e;
+	u32 i;
+	char szSN[50];
+	char *args=NULL;
+	GF_Filter *src, *prev, *dst=NULL;
+	GF_FilterSession *fsess = gf_fs_new_defaults(0);
+	if (!fsess) return GF_OUT_OF_MEM;
+
+	gf_dynstrcat(&args, gen->src_args, NULL);
+	gf_dynstrcat(&args, ":rep=", NULL);
+	gf_dynstrcat(&args, job->rep_id, NULL);
+	sprintf(szSN, ":sn=%u", job->sn);
+	gf_dynstrcat(&args, szSN, NULL);
+	src = gf_fs_load_source(fsess, args, NULL, NULL, &e);
+	gf_free(args);
+
+	prev = src;
+	for (i=0; prev && (i<gen->filters->nb_items); i++) {
+		GF_Filter *f = gf_fs_load_filter(fsess, gen->filters->vals[i], &e);
+		if (f) gf_filter_set_source(f, prev, NULL);
+		prev = f;
+	}
+	if (prev) {
+		//the manifest is not written when generating a segment, it only sets the output directory
+		dst = gf_fs_load_destination(fsess, gen->dst, gen->dst_opts, NULL, &e);
+		if (dst && (prev != src))
+			gf_filter_set_source(dst, prev, NULL);
+	}
+	if (dst) {
+		e = gf_fs_run(fsess);
+		if (e>GF_OK) e = GF_OK;
+		if (!e) e = gf_fs_get_last_connect_error(fsess);
+		if (!e) e = gf_fs_get_last_process_error(fsess);
+	}
+	gf_fs_del(fsess);
+	return e;
+}
+
+static u32 ghi_dmx_seg_worker(void *par)
+{
+	GHISegGen *gen = (GHISegGen *)par;
+	while (1) {
+		GF_Err e;
+		GHISegJob *job;
+		gf_mx_p(gen->mx);
+		job = (gen->next_job < gen->nb_jobs) ? &gen->jobs[gen->next_job] : NULL;
+		gen->next_job++;
+		gf_mx_v(gen->mx);
+		if (!job) break;
+
+		e = ghi_dmx_run_seg_job(gen, job);
+		if (e) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[GHIX] Failed to generate segment %d of representation %s: %s\n", job->sn, job->rep_id, gf_error_to_string(e) ));
+		}
+		gf_mx_p(gen->mx);
+		gen->nb_done++;
+		if (e) gen->nb_errors++;
+		gf_mx_v(gen->mx);
+	}
+	return 0;
+}
+
+static u32 ghi_dmx_get_nb_segs(GHIStream *st)
+{
+	//muxed streams are generated with their base representation
+	if (st->inactive || st->mux_dst.nb_items) return 0;
+#ifndef GPAC_DISABLE_MPD
+	if (st->segs_xml) return gf_list_count(st->segs_xml);
+#endif
+	return st->nb_segs;
+}
+
+static GF_Err ghi_dmx_stop_segments(GHIDmxCtx *ctx, Bool abort)
+{
+	u32 i;
+	GF_Err e = GF_OK;
+	GHISegGen *gen = ctx->seg_gen;
+	if (!gen) return GF_OK;
+	//session aborted, cancel pending jobs and only wait for the ones being generated
+	if (abort) {
+		if (gen->mx) gf_mx_p(gen->mx);
+		gen->next_job = gen->nb_jobs;
+		if (gen->mx) gf_mx_v(gen->mx);
+	}
+	//process remaining jobs in the calling thread, if any (e.g. threads could not be created)
+	else if (gen->jobs) {
+		ghi_dmx_seg_worker(gen);
+	}
+
+	for (i=0; i<gen->nb_threads; i++) {
+		gf_th_stop(gen->threads[i]);
+		gf_th_del(gen->threads[i]);
+	}
+	if (gen->nb_jobs) {
+		GF_LOG(gen->nb_errors ? GF_LOG_ERROR : GF_LOG_INFO, GF_LOG_DASH, ("[GHIX] Generated %d segments (%d errors) in "LLU" ms\n", gen->nb_done - gen->nb_errors, gen->nb_errors, (gf_sys_clock_high_res() - gen->clock)/1000));
+	}
+	if (gen->nb_errors) e = GF_SERVICE_ERROR;
+	if (gen->threads) gf_free(gen->threads);
+	if (gen->mx) gf_mx_del(gen->mx);
+	if (gen->jobs) gf_free(gen->jobs);
+	gf_free(gen->dst);
+	if (gen->src_args) gf_free(gen->src_args);
+	gf_free(gen);
+	ctx->seg_gen = NULL;
+	return e;
+}
+
+/*segments only depend on the index and the sources, generate them in parallel in independent sessions while the main session
+generates manifests and init segments*/
+static void ghi_dmx_start_segments(GF_Filter *filter, GHIDmxCtx *ctx, GF_FilterPid *opid)
+{
+	u32 i, j, nb_segs, nb_threads;
+	GHISegGen *gen;
+	const GF_PropertyValue *p;
+	char *dst = gf_filter_pid_get_destination(opid);
+	ctx->segs_started = GF_TRUE;
+	//process is called until all segments are generated, or to report errors
+	gf_filter_post_process_task(filter);
+	if (!dst) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[GHIX] No destination URL found, cannot generate segments\n"));
+		ctx->seg_err = GF_BAD_PARAM;
+		return;
+	}
+	p = gf_filter_pid_get_property(ctx->ipid, GF_PROP_PID_URL);
+	if (!p || !p->value.string) {
+		gf_free(dst);
+		GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[GHIX] Index URL unknown, cannot generate segments\n"));
+		ctx->seg_err = GF_BAD_PARAM;
+		return;
+	}
+	GF_SAFEALLOC(gen, GHISegGen);
+	if (!gen) {
+		gf_free(dst);
+		ctx->seg_err = GF_OUT_OF_MEM;
+		return;
+	}
+	ctx->seg_gen = gen;
+	gen->dst = dst;
+	gen->dst_opts = ctx->segopts;
+	gen->filters = &ctx->segf;
+	gf_dynstrcat(&gen->src_args, p->value.string, NULL);
+	if (ctx->mux.nb_items) {
+		gf_dynstrcat(&gen->src_args, ":mux=", NULL);
+		for (i=0; i<ctx->mux.nb_items; i++)
+			gf_dynstrcat(&gen->src_args, ctx->mux.vals[i], i ? "," : NULL);
+	}
+
+	for (i=0; i<gf_list_count(ctx->streams); i++) {
+		gen->nb_jobs += ghi_dmx_get_nb_segs(gf_list_get(ctx->streams, i));
+	}
+	gen->jobs = gen->nb_jobs ? gf_malloc(sizeof(GHISegJob) * gen->nb_jobs) : NULL;
+	if (!gen->jobs) {
+		if (gen->nb_jobs) ctx->seg_err = GF_OUT_OF_MEM;
+		gen->nb_jobs = 0;
+		ghi_dmx_stop_segments(ctx, GF_FALSE);
+		return;
+	}
+	gen->nb_jobs = 0;
+	for (i=0; i<gf_list_count(ctx->streams); i++) {
+		GHIStream *st = gf_list_get(ctx->streams, i);
+		nb_segs = ghi_dmx_get_nb_segs(st);
+		for (j=0; j<nb_segs; j++) {
+			gen->jobs[gen->nb_jobs].rep_id = st->rep_id;
+			gen->jobs[gen->nb_jobs].sn = j+1;
+			gen->nb_jobs++;
+		}
+	}
+	gen->mx = gf_mx_new("GHISegGen");
+	gen->clock = gf_sys_clock_high_res();
+
+	nb_threads = MIN(ctx->segth, gen->nb_jobs);
+	gen->threads = gf_malloc(sizeof(GF_Thread *) * nb_threads);
+	if (!gen->threads) nb_threads = 0;
+	for (i=0; i<nb_threads; i++) {
+		GF_Thread *th = gf_th_new("GHISegGen");
+		if (th && (gf_th_run(th, ghi_dmx_seg_worker, gen) != GF_OK)) {
+			gf_th_del(th);
+			th = NULL;
+		}
+		if (th) gen->threads[gen->nb_threads++] = th;
+	}
+	GF_LOG(GF_LOG_INFO, GF_LOG_DASH, ("[GHIX] Generating %d segments using %d threads\n", gen->nb_jobs, gen->nb_threads));
+}
+
 static Bool ghi_dmx_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 {
 	GF_FilterEvent fevt;
@@ -308,6 +528,9 @@ static Bool ghi_dmx_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 	switch (evt->base.type) {
 	case GF_FEVT_PLAY:
 		if (ctx->gm) {
+			//output chain is now connected, segments can be generated
+			if (ctx->segth && (ctx->gm==GHI_GM_ALL) && !ctx->segs_started)
+				ghi_dmx_start_segments(filter, ctx, evt->base.on_pid);
 			ghi_dmx_send_seg_times(ctx, st, evt->base.on_pid);
 			return GF_TRUE;
 		}
@@ -813,6 +1036,14 @@ GF_Err ghi_dmx_init_bin(GF_Filter *filter, GHIDmxCtx *ctx, GF_BitStream *bs)
 
 		//locate segment
 		if (ctx->sn > st->nb_segs) {
+			//inactive or muxed representations may be shorter than the one generated
+			if (st->inactive || st->mux_dst.nb_items) {
+				st->empty_seg = 1;
+				rep_end = rep_size + rep_start;
+				skip = rep_end - (u32) gf_bs_get_position(bs);
+				gf_bs_skip_bytes(bs, skip);
+				continue;
+			}
 			GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[GHIX] Invalid segment index %d - only %d segments available\n", ctx->sn, st->nb_segs));
 			return GF_BAD_PARAM;
 		//todo: locate by other criteria ? (time)
@@ -984,6 +1215,97 @@ GF_Err ghi_dmx_init_xml(GF_Filter *filter, GHIDmxCtx *ctx, const u8 *data)
 	return GF_NOT_SUPPORTED;
 #endif
 }
+#ifndef GPAC_DISABLE_MPD
+static Bool ghi_dmx_same_name(const char *name, const char *seg_name)
+{
+	u32 len = (u32) strlen(seg_name);
+	if (strncmp(name, seg_name, len)) return GF_FALSE;
+	//extensions are not part of the index template
+	if (!name[len]) return GF_TRUE;
+	if ((name[len]=='.') && !strchr(name+len, '/')) return GF_TRUE;
+	return GF_FALSE;
+}
+
+//get representation and segment number (0 for init) from a segment name produced with the index template
+static Bool ghi_dmx_match_seg_name(GHIDmxCtx *ctx, const char *template, const char *rep_id, u32 bandwidth, u32 nb_segs)
+{
+	char szName[GF_MAX_PATH], szName2[GF_MAX_PATH];
+	u32 i, sn;
+
+	gf_media_mpd_format_segment_name(GF_DASH_TEMPLATE_INITIALIZATION, GF_FALSE, szName, rep_id, NULL, template, NULL, 0, bandwidth, 0, GF_FALSE, GF_FALSE);
+	if (ghi_dmx_same_name(ctx->seg, szName)) {
+		ctx->gm = GHI_GM_INIT;
+		ctx->sn = 0;
+		return GF_TRUE;
+	}
+	//names of segments 1 and 2 only differ by the number, locate it
+	gf_media_mpd_format_segment_name(GF_DASH_TEMPLATE_SEGMENT, GF_FALSE, szName, rep_id, NULL, template, NULL, 0, bandwidth, 1, GF_FALSE, GF_FALSE);
+	gf_media_mpd_format_segment_name(GF_DASH_TEMPLATE_SEGMENT, GF_FALSE, szName2, rep_id, NULL, template, NULL, 0, bandwidth, 2, GF_FALSE, GF_FALSE);
+	i=0;
+	while (szName[i] && (szName[i]==szName2[i])) i++;
+	if (!szName[i]) return GF_FALSE;
+	while (i && (szName[i-1]>='0') && (szName[i-1]<='9')) i--;
+	if (strncmp(ctx->seg, szName, i)) return GF_FALSE;
+	if ((ctx->seg[i]<'0') || (ctx->seg[i]>'9')) return GF_FALSE;
+
+	sn = atoi(ctx->seg+i);
+	if (!sn || (sn>nb_segs)) return GF_FALSE;
+	gf_media_mpd_format_segment_name(GF_DASH_TEMPLATE_SEGMENT, GF_FALSE, szName, rep_id, NULL, template, NULL, 0, bandwidth, sn, GF_FALSE, GF_FALSE);
+	if (!ghi_dmx_same_name(ctx->seg, szName)) return GF_FALSE;
+	ctx->gm = GHI_GM_NONE;
+	ctx->sn = sn;
+	return GF_TRUE;
+}
+
+#endif
+
+static GF_Err ghi_dmx_resolve_seg_name(GHIDmxCtx *ctx, GF_BitStream *bs)
+{
+#ifdef GPAC_DISABLE_MPD
+	return GF_NOT_SUPPORTED;
+#else
+	u32 i, nb_reps;
+	Bool found = GF_FALSE;
+	char *template;
+
+	gf_bs_skip_bytes(bs, 4*4 + 2*8);
+	template = gf_bs_read_utf8(bs);
+	nb_reps = gf_bs_read_u32(bs);
+	for (i=0; i<nb_reps && template && !found; i++) {
+		u32 bandwidth, nb_segs;
+		u64 rep_start = gf_bs_get_position(bs);
+		u32 rep_size = gf_bs_read_u32(bs);
+		char *rep_id = gf_bs_read_utf8(bs);
+		char *res_url = gf_bs_read_utf8(bs);
+		//trackID, start offset, timescales
+		gf_bs_skip_bytes(bs, 4*4);
+		bandwidth = gf_bs_read_u32(bs);
+		//delay, sample duration, cts offset
+		gf_bs_skip_bytes(bs, 3*4);
+		nb_segs = gf_bs_read_u32(bs);
+
+		if (rep_id && ghi_dmx_match_seg_name(ctx, template, rep_id, bandwidth, nb_segs)) {
+			if (ctx->rep) gf_free(ctx->rep);
+			ctx->rep = rep_id;
+			rep_id = NULL;
+			found = GF_TRUE;
+		}
+		if (rep_id) gf_free(rep_id);
+		if (res_url) gf_free(res_url);
+		if (gf_bs_is_overflow(bs)) break;
+		gf_bs_seek(bs, rep_start + rep_size);
+	}
+	if (template) gf_free(template);
+	gf_bs_seek(bs, 0);
+	if (found) {
+		GF_LOG(GF_LOG_INFO, GF_LOG_DASH, ("[GHIX] Generating %s segment %d of representation %s for %s\n", (ctx->gm==GHI_GM_INIT) ? "init" : "media", ctx->sn, ctx->rep, ctx->seg));
+		return GF_OK;
+	}
+	GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[GHIX] Segment %s does not match any representation in index\n", ctx->seg));
+	return GF_URL_ERROR;
+#endif
+}
+
 GF_Err ghi_dmx_init(GF_Filter *filter, GHIDmxCtx *ctx)
 {
 	u32 size, i, nb_active=0;
@@ -998,8 +1320,15 @@ GF_Err ghi_dmx_init(GF_Filter *filter, GHIDmxCtx *ctx)
 	}
 	if ((data[0] == 'G') && (data[1] == 'H') && (data[2] == 'I') && (data[3] == 'D')) {
 		bs = gf_bs_new(data, size, GF_BITSTREAM_READ);
-		e = ghi_dmx_init_bin(filter, ctx, bs);
+		e = GF_OK;
+		if (ctx->seg)
+			e = ghi_dmx_resolve_seg_name(ctx, bs);
+		if (!e)
+			e = ghi_dmx_init_bin(filter, ctx, bs);
 		if (!e && gf_bs_is_overflow(bs)) e = GF_NON_COMPLIANT_BITSTREAM;
+	} else if (ctx->seg) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[GHIX] Segment name resolution only supported for binary indexes\n"));
+		e = GF_NOT_SUPPORTED;
 	} else {
 		e = ghi_dmx_init_xml(filter, ctx, data);
 	}
@@ -1102,6 +1431,28 @@ GF_Err ghi_dmx_process(GF_Filter *filter)
 	if (!ctx->init) {
 		return ghi_dmx_init(filter, ctx);
 	}
+	if (ctx->seg_gen || ctx->seg_err) {
+		GF_Err e = ctx->seg_err;
+		if (ctx->seg_gen) {
+			Bool done;
+			gf_mx_p(ctx->seg_gen->mx);
+			//no thread running, remaining jobs are processed when stopping
+			done = ((ctx->seg_gen->nb_done >= ctx->seg_gen->nb_jobs) || !ctx->seg_gen->nb_threads) ? GF_TRUE : GF_FALSE;
+			gf_mx_v(ctx->seg_gen->mx);
+			if (!done) {
+				gf_filter_ask_rt_reschedule(filter, 10000);
+				return GF_OK;
+			}
+			e = ghi_dmx_stop_segments(ctx, GF_FALSE);
+		}
+		//all segments generated, signal end of stream
+		while (gf_list_count(ctx->seg_eos_pids)) {
+			GF_FilterPid *opid = gf_list_pop_back(ctx->seg_eos_pids);
+			gf_filter_pid_set_eos(opid);
+		}
+		ctx->seg_err = GF_OK;
+		if (e) return e;
+	}
 
 	count = gf_list_count(ctx->streams);
 	for (i=0; i<count; i++) {
@@ -1163,6 +1514,15 @@ GF_Err ghi_dmx_initialize(GF_Filter *filter)
 	GHIDmxCtx *ctx = gf_filter_get_udta(filter);
 	ctx->streams = gf_list_new();
 
+	if (ctx->segth && (ctx->seg || (ctx->sn && ctx->rep) || (ctx->gm != GHI_GM_ALL))) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[GHIX] Segment generation threads only used in `all` manifest generation mode, ignoring segth\n"));
+		ctx->segth = 0;
+	}
+
+	//representation and segment number resolved when loading the index
+	if (ctx->seg)
+		return GF_OK;
+
 	if (ctx->sn && ctx->rep)
 		ctx->gm = GHI_GM_NONE;
 
@@ -1181,6 +1541,9 @@ void ghi_dmx_finalize(GF_Filter *filter)
 {
 	GHIDmxCtx *ctx = gf_filter_get_udta(filter);
 
+	ghi_dmx_stop_segments(ctx, GF_TRUE);
+	gf_list_del(ctx->seg_eos_pids);
+
 	while (gf_list_count(ctx->streams)) {
 		GHIStream *st = gf_list_pop_back(ctx->streams);
 		GF_PropertyValue p;
@@ -1246,6 +1609,10 @@ static const GF_FilterArgs GHIDmxArgs[] =
 	{ OFFS(sn), "segment number to generate, 0 means init segment", GF_PROP_UINT, NULL, NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(mux), "representation to mux - cf filter help", GF_PROP_STRING_LIST, NULL, NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(out), "output filename to generate", GF_PROP_STRING, NULL, NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(seg), "init or media segment name to generate, representation and segment number being resolved from the index template", GF_PROP_STRING, NULL, NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(segth), "number of threads used to generate all media segments in `all` manifest generation mode (0 disables segment generation)", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(segf), "filters to insert between demultiplexer and dasher when generating segments with [-segth]()", GF_PROP_STRING_LIST, NULL, NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(segopts), "options for the destination when generating segments with [-segth]()", GF_PROP_STRING, NULL, NULL, GF_FS_ARG_HINT_EXPERT},
 	{0}
 };
 
@@ -1319,6 +1686,26 @@ GF_FilterRegister GHIDXDmxRegister = {
 	"EX gpac -i index.ghi:rep=V2:sn=5:mux=A@V2 -o dash/vod.mpd\n"
 	"This will generate the 5th segment containing representations `A` and `V2`.\n"
 	"\n"
+	"# Generating segments by name\n"
+	"Instead of [-rep]() and [-sn](), the segment to generate can be given by its name using [-seg](), typically when serving segments requested by clients. "
+	"The name is matched against the names produced by the index template for each representation, ignoring file extensions. Templates using `$Time$` are not supported.\n"
+	"EX gpac -i index.ghi:seg=FOO-10.m4s -o dash/vod.mpd\n"
+	"This generates the 10th segment of representation with ID `FOO` using the default index template.\n"
+	"EX gpac -i index.ghi:seg=FOO-init.mp4 -o dash/vod.mpd\n"
+	"This generates the init segment of representation with ID `FOO`.\n"
+	"\n"
+	"# Parallel segment generation\n"
+	"In `all` manifest generation mode, the filter can also generate all media segments of the index using [-segth]() threads. "
+	"Each segment is generated in its own session, as if the filter was called with [-rep]() and [-sn](), so that packaging time scales with the number of cores rather than with the source duration. "
+	"Manifests and init segments are generated by the main session as usual.\n"
+	"EX gpac -i index.ghi:gm=all:segth=8 -o dash/vod.mpd\n"
+	"This generates manifest(s), init segment(s) and all media segments using 8 threads.\n"
+	"\n"
+	"Filters to apply to each segment, for example encryption, are given using [-segf](), and options of the destination using [-segopts](). "
+	"They should match the filters and options used in the main session. Filter options in [-segf]() require escaping the separator, see `gpac -h doc`.\n"
+	"EX gpac -i index.ghi:gm=all:segth=8::segf=cecrypt:cfile=drm.xml cecrypt:cfile=drm.xml -o dash/vod.mpd\n"
+	"This generates an encrypted presentation using 8 threads.\n"
+	"\n"
 	"The filter does not store any state, it is the user responsibility to use consistent information across calls:\n"
 	"- do not change segment templates\n"
 	"- do not change muxed representations to configurations not advertised in the generated manifests\n"
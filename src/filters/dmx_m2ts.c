@@ -56,11 +56,33 @@ enum
 
 };
 
+typedef struct
+{
+	//offset of the packet starting the RAP PES
+	u64 offset;
+	//PTS of the RAP, unwrapped
+	u64 pts;
+} GF_M2TSIdxEntry;
+
+typedef struct
+{
+	u32 number, pid, pcr_pid;
+	Bool is_audio;
+	//unwrapped PTS of first and last PES of program, unwrapped PCR base of first and last PCR
+	u64 first_pts, last_pts, first_pcr, last_pcr;
+	u32 nb_entries, nb_alloc;
+	GF_M2TSIdxEntry *entries;
+
+	//scan state
+	u64 pts_wrap, pcr_wrap, last_pts_raw, last_pcr_raw;
+	Bool has_pts, has_pcr;
+} GF_M2TSIdxProg;
+
 typedef struct
 {
 	//opts
 	const char *temi_url;
-	Bool dsmcc, seeksrc, sigfrag, dvbtxt;
+	Bool dsmcc, seeksrc, sigfrag, dvbtxt, pidx;
 	Double index;
 
 	GF_Filter *filter;
@@ -90,6 +112,16 @@ typedef struct
 
 	Bool is_dash;
 	u32 nb_stopped_at_init;
+
+	//persistent seek index, one entry per program
+	GF_List *idx_progs;
+	//index being built by helper thread
+	GF_Thread *idx_th;
+	volatile u32 idx_state;
+	volatile Bool idx_abort;
+	GF_List *idx_build;
+	char *idx_src;
+	u64 idx_file_size, idx_mtime;
 } GF_M2TSDmxCtx;
 
 
@@ -165,6 +197,472 @@ static void m2tsdmx_on_event_duration_probe(GF_M2TS_Demuxer *ts, u32 evt_type, v
 	}
 }
 
+#define M2TSDMX_IDX_VERSION	1
+
+enum
+{
+	M2TSDMX_IDX_NONE=0,
+	M2TSDMX_IDX_RUNNING,
+	M2TSDMX_IDX_DONE,
+};
+
+static void m2tsdmx_del_index_progs(GF_List *progs)
+{
+	if (!progs) return;
+	while (gf_list_count(progs)) {
+		GF_M2TSIdxProg *ip = gf_list_pop_back(progs);
+		if (ip->entries) gf_free(ip->entries);
+		gf_free(ip);
+	}
+	gf_list_del(progs);
+}
+
+static void m2tsdmx_del_index(GF_M2TSDmxCtx *ctx)
+{
+	m2tsdmx_del_index_progs(ctx->idx_progs);
+	ctx->idx_progs = NULL;
+}
+
+static GF_M2TSIdxProg *m2tsdmx_index_get_prog(GF_M2TSDmxCtx *ctx, u32 number)
+{
+	u32 i, count = gf_list_count(ctx->idx_progs);
+	for (i=0; i<count; i++) {
+		GF_M2TSIdxProg *ip = gf_list_get(ctx->idx_progs, i);
+		if (ip->number == number) return ip;
+	}
+	return NULL;
+}
+
+//unwrap 33-bit timestamps, assuming no jump larger than 2^32
+static u64 m2tsdmx_index_unwrap(u64 raw, u64 *last_raw, u64 *wrap, Bool *has_prev)
+{
+	if (*has_prev && (raw + 0x100000000ULL < *last_raw)) {
+		*wrap += 0x200000000ULL;
+	}
+	*has_prev = GF_TRUE;
+	*last_raw = raw;
+	return raw + *wrap;
+}
+
+static void m2tsdmx_index_scan_packet(GF_M2TSIdxProg **pid_map, GF_M2TSIdxProg **pcr_map, u8 *data, u64 offset)
+{
+	GF_M2TSIdxProg *ip;
+	u32 pid, pos=4;
+	Bool is_rap = GF_FALSE;
+	u8 af_type;
+
+	if (data[0] != 0x47) return;
+	if (data[1] & 0x80) return;
+	pid = ((data[1]&0x1f) << 8) | data[2];
+	af_type = (data[3] >> 4) & 0x3;
+
+	if (af_type & 0x2) {
+		u32 af_len = data[4];
+		if (af_len > 183) return;
+		if (af_len) {
+			is_rap = (data[5] & 0x40) ? GF_TRUE : GF_FALSE;
+			ip = pcr_map[pid];
+			if (ip && (data[5] & 0x10) && (af_len >= 7)) {
+				Bool is_first = !ip->has_pcr;
+				u64 pcr = ((u64)data[6] << 25) | ((u64)data[7] << 17) | ((u64)data[8] << 9) | ((u64)data[9] << 1) | (data[10] >> 7);
+				pcr = m2tsdmx_index_unwrap(pcr, &ip->last_pcr_raw, &ip->pcr_wrap, &ip->has_pcr);
+				if (is_first) ip->first_pcr = pcr;
+				ip->last_pcr = pcr;
+			}
+		}
+		pos += 1 + af_len;
+	}
+	ip = pid_map[pid];
+	if (!ip) return;
+	//payload start with at least a PES header with PTS
+	if (!(af_type & 0x1) || !(data[1] & 0x40)) return;
+	if (pos + 14 > 188) return;
+	data += pos;
+	if (data[0] || data[1] || (data[2]!=1)) return;
+	if (!(data[7] & 0x80)) return;
+
+	Bool is_first = !ip->has_pts;
+	u64 pts = ((u64)((data[9]>>1) & 0x7)) << 30;
+	pts |= ((u64)data[10]) << 22;
+	pts |= ((u64)(data[11]>>1)) << 15;
+	pts |= ((u64)data[12]) << 7;
+	pts |= data[13] >> 1;
+	pts = m2tsdmx_index_unwrap(pts, &ip->last_pts_raw, &ip->pts_wrap, &ip->has_pts);
+	if (is_first || (pts < ip->first_pts)) ip->first_pts = pts;
+	if (pts > ip->last_pts) ip->last_pts = pts;
+	//other streams of the program are only used for duration
+	if (pid != ip->pid) return;
+
+	//audio streams are not always signaled with RAI, index at most one access unit per second
+	if (ip->is_audio) {
+		if (ip->nb_entries && (pts < ip->entries[ip->nb_entries-1].pts + 90000))
+			return;
+	} else if (!is_rap) {
+		return;
+	}
+	if (ip->nb_entries == ip->nb_alloc) {
+		ip->nb_alloc = ip->nb_alloc ? 2*ip->nb_alloc : 256;
+		ip->entries = gf_realloc(ip->entries, sizeof(GF_M2TSIdxEntry) * ip->nb_alloc);
+	}
+	ip->entries[ip->nb_entries].offset = offset;
+	ip->entries[ip->nb_entries].pts = pts;
+	ip->nb_entries++;
+}
+
+static void m2tsdmx_on_event_index_probe(GF_M2TS_Demuxer *ts, u32 evt_type, void *param)
+{
+	//only program tables are needed
+	if (evt_type == GF_M2TS_EVT_PMT_FOUND) {
+		ts->nb_prog_pmt_received++;
+		if (ts->nb_prog_pmt_received == gf_list_count(ts->programs))
+			ts->all_prog_pmt_received = GF_TRUE;
+	}
+}
+
+static GF_List *m2tsdmx_build_index(GF_M2TSDmxCtx *ctx, FILE *src)
+{
+	u8 buf[192*100];
+	u32 i, j, count, pck_size, nb_read;
+	u64 pos;
+	GF_M2TSIdxProg **pid_map, **pcr_map;
+	GF_M2TS_Demuxer *ts;
+	GF_List *progs;
+
+	//get programs
+	ts = gf_m2ts_demux_new();
+	if (!ts) return NULL;
+	ts->seek_mode = GF_TRUE;
+	ts->on_event = m2tsdmx_on_event_index_probe;
+	while (!gf_feof(src)) {
+		nb_read = (u32) gf_fread(buf, 1880, src);
+		gf_m2ts_process_data(ts, buf, nb_read);
+		if (ts->all_prog_pmt_received || (nb_read!=1880)) break;
+	}
+	pck_size = ts->prefix_present ? 192 : 188;
+
+	pid_map = gf_malloc(sizeof(GF_M2TSIdxProg *) * GF_M2TS_MAX_STREAMS);
+	pcr_map = gf_malloc(sizeof(GF_M2TSIdxProg *) * GF_M2TS_MAX_STREAMS);
+	memset(pid_map, 0, sizeof(GF_M2TSIdxProg *) * GF_M2TS_MAX_STREAMS);
+	memset(pcr_map, 0, sizeof(GF_M2TSIdxProg *) * GF_M2TS_MAX_STREAMS);
+
+	progs = gf_list_new();
+	count = gf_list_count(ts->programs);
+	for (i=0; i<count; i++) {
+		GF_M2TSIdxProg *ip;
+		GF_M2TS_PES *video=NULL, *audio=NULL;
+		GF_M2TS_Program *prog = gf_list_get(ts->programs, i);
+		u32 count2 = gf_list_count(prog->streams);
+		GF_SAFEALLOC(ip, GF_M2TSIdxProg);
+		if (!ip) break;
+		for (j=0; j<count2; j++) {
+			GF_M2TS_PES *pes = gf_list_get(prog->streams, j);
+			if (!(pes->flags & GF_M2TS_ES_IS_PES)) continue;
+			pid_map[pes->pid] = ip;
+			switch (pes->stream_type) {
+			case GF_M2TS_VIDEO_MPEG1:
+			case GF_M2TS_VIDEO_MPEG2:
+			case GF_M2TS_VIDEO_DCII:
+			case GF_M2TS_VIDEO_MPEG4:
+			case GF_M2TS_VIDEO_H264:
+			case GF_M2TS_VIDEO_HEVC:
+			case GF_M2TS_VIDEO_VVC:
+			case GF_M2TS_VIDEO_VC1:
+			case GF_M2TS_VIDEO_AV1:
+				if (!video) video = pes;
+				break;
+			case GF_M2TS_AUDIO_MPEG1:
+			case GF_M2TS_AUDIO_MPEG2:
+			case GF_M2TS_AUDIO_AAC:
+			case GF_M2TS_AUDIO_LATM_AAC:
+			case GF_M2TS_AUDIO_AC3:
+			case GF_M2TS_AUDIO_EC3:
+			case GF_M2TS_AUDIO_OPUS:
+				if (!audio) audio = pes;
+				break;
+			}
+		}
+		if (!video && !audio) {
+			for (j=0; j<count2; j++) {
+				GF_M2TS_ES *es = gf_list_get(prog->streams, j);
+				pid_map[es->pid] = NULL;
+			}
+			gf_free(ip);
+			continue;
+		}
+		ip->number = prog->number;
+		ip->pid = video ? video->pid : audio->pid;
+		ip->is_audio = video ? GF_FALSE : GF_TRUE;
+		ip->pcr_pid = prog->pcr_pid;
+		if (ip->pcr_pid < GF_M2TS_MAX_STREAMS) pcr_map[ip->pcr_pid] = ip;
+		gf_list_add(progs, ip);
+	}
+	gf_m2ts_demux_del(ts);
+
+	//scan whole file
+	if (gf_list_count(progs)) {
+		gf_fseek(src, 0, SEEK_SET);
+		nb_read = (u32) gf_fread(buf, 2*pck_size, src);
+		pos = 0;
+		//locate first packet
+		for (i=0; i+pck_size<nb_read; i++) {
+			if ((buf[i]==0x47) && (buf[i+pck_size]==0x47)) break;
+		}
+		if (i+pck_size<nb_read) {
+			pos = i;
+			gf_fseek(src, pos, SEEK_SET);
+			while (!gf_feof(src)) {
+				nb_read = (u32) gf_fread(buf, 100*pck_size, src);
+				for (i=0; i+188<=nb_read; i+=pck_size) {
+					m2tsdmx_index_scan_packet(pid_map, pcr_map, buf+i, pos+i);
+				}
+				pos += nb_read;
+				if (nb_read != 100*pck_size) break;
+				if (ctx->idx_abort) break;
+			}
+		}
+	}
+	gf_free(pid_map);
+	gf_free(pcr_map);
+	if (!gf_list_count(progs) || ctx->idx_abort) {
+		m2tsdmx_del_index_progs(progs);
+		return NULL;
+	}
+	return progs;
+}
+
+static Bool m2tsdmx_load_index(GF_M2TSDmxCtx *ctx, const char *idx_path, u64 file_size, u64 mtime)
+{
+	u32 i, j, nb_progs;
+	GF_BitStream *bs;
+	FILE *f = gf_fopen(idx_path, "rb");
+	if (!f) return GF_FALSE;
+	bs = gf_bs_from_file(f, GF_BITSTREAM_READ);
+	if (!bs) {
+		gf_fclose(f);
+		return GF_FALSE;
+	}
+	if ((gf_bs_read_u32(bs) != GF_4CC('G','T','S','I'))
+		|| (gf_bs_read_u8(bs) != M2TSDMX_IDX_VERSION)
+		|| (gf_bs_read_u64(bs) != file_size)
+		|| (gf_bs_read_u64(bs) != mtime)
+	) {
+		gf_bs_del(bs);
+		gf_fclose(f);
+		return GF_FALSE;
+	}
+	ctx->idx_progs = gf_list_new();
+	nb_progs = gf_bs_read_u32(bs);
+	for (i=0; i<nb_progs; i++) {
+		GF_M2TSIdxProg *ip;
+		GF_SAFEALLOC(ip, GF_M2TSIdxProg);
+		if (!ip) break;
+		gf_list_add(ctx->idx_progs, ip);
+		ip->number = gf_bs_read_u16(bs);
+		ip->pid = gf_bs_read_u16(bs);
+		ip->pcr_pid = gf_bs_read_u16(bs);
+		ip->is_audio = gf_bs_read_u8(bs);
+		ip->first_pts = gf_bs_read_u64(bs);
+		ip->last_pts = gf_bs_read_u64(bs);
+		ip->first_pcr = gf_bs_read_u64(bs);
+		ip->last_pcr = gf_bs_read_u64(bs);
+		ip->nb_entries = gf_bs_read_u32(bs);
+		if ((u64) ip->nb_entries * 16 > gf_bs_available(bs)) {
+			ip->nb_entries = 0;
+			break;
+		}
+		ip->nb_alloc = ip->nb_entries;
+		if (!ip->nb_entries) continue;
+		ip->entries = gf_malloc(sizeof(GF_M2TSIdxEntry) * ip->nb_entries);
+		for (j=0; j<ip->nb_entries; j++) {
+			ip->entries[j].offset = gf_bs_read_u64(bs);
+			ip->entries[j].pts = gf_bs_read_u64(bs);
+		}
+	}
+	gf_bs_del(bs);
+	gf_fclose(f);
+	if (i<nb_progs) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_CONTAINER, ("[M2TSDmx] Corrupted index file %s, ignoring\n", idx_path));
+		m2tsdmx_del_index(ctx);
+		return GF_FALSE;
+	}
+	return GF_TRUE;
+}
+
+static void m2tsdmx_save_index(GF_List *progs, const char *idx_path, u64 file_size, u64 mtime)
+{
+	u32 i, j, nb_progs;
+	GF_BitStream *bs;
+	FILE *f = gf_fopen(idx_path, "wb");
+	if (!f) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_CONTAINER, ("[M2TSDmx] Failed to create index file %s, index will not be persistent\n", idx_path));
+		return;
+	}
+	bs = gf_bs_from_file(f, GF_BITSTREAM_WRITE);
+	gf_bs_write_u32(bs, GF_4CC('G','T','S','I'));
+	gf_bs_write_u8(bs, M2TSDMX_IDX_VERSION);
+	gf_bs_write_u64(bs, file_size);
+	gf_bs_write_u64(bs, mtime);
+	nb_progs = gf_list_count(progs);
+	gf_bs_write_u32(bs, nb_progs);
+	for (i=0; i<nb_progs; i++) {
+		GF_M2TSIdxProg *ip = gf_list_get(progs, i);
+		gf_bs_write_u16(bs, ip->number);
+		gf_bs_write_u16(bs, ip->pid);
+		gf_bs_write_u16(bs, ip->pcr_pid);
+		gf_bs_write_u8(bs, ip->is_audio);
+		gf_bs_write_u64(bs, ip->first_pts);
+		gf_bs_write_u64(bs, ip->last_pts);
+		gf_bs_write_u64(bs, ip->first_pcr);
+		gf_bs_write_u64(bs, ip->last_pcr);
+		gf_bs_write_u32(bs, ip->nb_entries);
+		for (j=0; j<ip->nb_entries; j++) {
+			gf_bs_write_u64(bs, ip->entries[j].offset);
+			gf_bs_write_u64(bs, ip->entries[j].pts);
+		}
+	}
+	gf_bs_del(bs);
+	gf_fclose(f);
+}
+
+static char *m2tsdmx_index_path(const char *src_path)
+{
+	char *idx_path = gf_strdup(src_path);
+	gf_dynstrcat(&idx_path, ".tsidx", NULL);
+	return idx_path;
+}
+
+//set duration from index, discard index if no duration
+static Bool m2tsdmx_index_set_duration(GF_M2TSDmxCtx *ctx)
+{
+	u32 i, count;
+	u64 dur=0;
+	//use longest program as duration
+	count = gf_list_count(ctx->idx_progs);
+	for (i=0; i<count; i++) {
+		u64 pdur;
+		GF_M2TSIdxProg *ip = gf_list_get(ctx->idx_progs, i);
+		if (!ip->nb_entries) continue;
+		pdur = ip->last_pts - ip->first_pts;
+		if (ip->last_pcr - ip->first_pcr > pdur) pdur = ip->last_pcr - ip->first_pcr;
+		if (pdur > dur) dur = pdur;
+	}
+	if (!dur) {
+		m2tsdmx_del_index(ctx);
+		return GF_FALSE;
+	}
+	ctx->duration.num = dur;
+	ctx->duration.den = 90000;
+	return GF_TRUE;
+}
+
+static u32 m2tsdmx_index_thread(void *par)
+{
+	GF_M2TSDmxCtx *ctx = (GF_M2TSDmxCtx *) par;
+	u64 clock = gf_sys_clock_high_res();
+	FILE *src = gf_fopen(ctx->idx_src, "rb");
+	if (src) {
+		ctx->idx_build = m2tsdmx_build_index(ctx, src);
+		gf_fclose(src);
+	}
+	if (ctx->idx_build) {
+		char *idx_path = m2tsdmx_index_path(ctx->idx_src);
+		GF_LOG(GF_LOG_INFO, GF_LOG_CONTAINER, ("[M2TSDmx] Index built in "LLU" ms\n", (gf_sys_clock_high_res() - clock)/1000));
+		m2tsdmx_save_index(ctx->idx_build, idx_path, ctx->idx_file_size, ctx->idx_mtime);
+		gf_free(idx_path);
+	}
+	ctx->idx_state = M2TSDMX_IDX_DONE;
+	if (!ctx->idx_abort)
+		gf_filter_post_process_task(ctx->filter);
+	return 0;
+}
+
+static void m2tsdmx_stop_index(GF_M2TSDmxCtx *ctx)
+{
+	if (ctx->idx_th) {
+		ctx->idx_abort = GF_TRUE;
+		gf_th_stop(ctx->idx_th);
+		gf_th_del(ctx->idx_th);
+		ctx->idx_th = NULL;
+	}
+	m2tsdmx_del_index_progs(ctx->idx_build);
+	ctx->idx_build = NULL;
+	if (ctx->idx_src) gf_free(ctx->idx_src);
+	ctx->idx_src = NULL;
+	ctx->idx_state = M2TSDMX_IDX_NONE;
+}
+
+//use index once built by helper thread, called on filter thread
+static void m2tsdmx_check_index(GF_M2TSDmxCtx *ctx)
+{
+	u32 i, nb_streams;
+	if (ctx->idx_state != M2TSDMX_IDX_DONE) return;
+	gf_th_stop(ctx->idx_th);
+	gf_th_del(ctx->idx_th);
+	ctx->idx_th = NULL;
+	ctx->idx_progs = ctx->idx_build;
+	ctx->idx_build = NULL;
+	m2tsdmx_stop_index(ctx);
+	if (!ctx->idx_progs || !m2tsdmx_index_set_duration(ctx)) return;
+
+	nb_streams = gf_filter_get_opid_count(ctx->filter);
+	for (i=0; i<nb_streams; i++) {
+		GF_FilterPid *opid = gf_filter_get_opid(ctx->filter, i);
+		gf_filter_pid_set_property(opid, GF_PROP_PID_DURATION, &PROP_FRAC64(ctx->duration) );
+	}
+}
+
+//load index if present and valid, otherwise build it in a helper thread while the file is being demultiplexed
+static void m2tsdmx_setup_index(GF_M2TSDmxCtx *ctx, const char *src_path)
+{
+	char *idx_path;
+	FILE *src = gf_fopen(src_path, "rb");
+	if (!src) return;
+	ctx->idx_file_size = gf_fsize(src);
+	gf_fclose(src);
+	ctx->idx_mtime = gf_file_modification_time(src_path);
+
+	idx_path = m2tsdmx_index_path(src_path);
+	if (m2tsdmx_load_index(ctx, idx_path, ctx->idx_file_size, ctx->idx_mtime)) {
+		gf_free(idx_path);
+		m2tsdmx_index_set_duration(ctx);
+		return;
+	}
+	gf_free(idx_path);
+
+	ctx->idx_src = gf_strdup(src_path);
+	ctx->idx_abort = GF_FALSE;
+	ctx->idx_state = M2TSDMX_IDX_RUNNING;
+	ctx->idx_th = gf_th_new("M2TSDmxIndex");
+	if (!ctx->idx_th || (gf_th_run(ctx->idx_th, m2tsdmx_index_thread, ctx) != GF_OK)) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_CONTAINER, ("[M2TSDmx] Failed to start index thread, index will not be used\n"));
+		m2tsdmx_stop_index(ctx);
+	}
+}
+
+//get offset of last RAP with PTS less than or equal to start time, GF_FALSE if not found
+static Bool m2tsdmx_index_lookup(GF_M2TSDmxCtx *ctx, u32 prog_number, Double start_range, u64 *file_pos)
+{
+	u32 low, high;
+	u64 pts;
+	GF_M2TSIdxProg *ip = m2tsdmx_index_get_prog(ctx, prog_number);
+	if (!ip || !ip->nb_entries) return GF_FALSE;
+
+	pts = ip->first_pts + (u64) (start_range * 90000);
+	if (pts <= ip->entries[0].pts) {
+		*file_pos = 0;
+		return GF_TRUE;
+	}
+	low = 0;
+	high = ip->nb_entries;
+	while (high - low > 1) {
+		u32 mid = (low + high) / 2;
+		if (ip->entries[mid].pts <= pts) low = mid;
+		else high = mid;
+	}
+	*file_pos = ip->entries[low].offset;
+	return GF_TRUE;
+}
+
 static void m2tsdmx_update_sdt(GF_M2TS_Demuxer *ts, void *for_pid)
 {
 	u32 i, count = gf_list_count(ts->programs);
@@ -1157,8 +1655,12 @@ static GF_Err m2tsdmx_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool i
 			}
 		}
 
+		if (ctx->pidx && !ctx->idx_progs && !ctx->idx_state) {
+			m2tsdmx_setup_index(ctx, p->value.string);
+		}
+
 		FILE *stream = NULL;
-		if (!ctx->sigfrag && ctx->index) {
+		if (!ctx->sigfrag && ctx->index && !ctx->idx_progs) {
 			stream = gf_fopen(p->value.string, "rb");
 		}
 
@@ -1313,12 +1815,18 @@ static Bool m2tsdmx_process_event(GF_Filter *filter, const GF_FilterEvent *com)
 
 		if (is_source_seek) {
 			file_pos = com->play.hint_start_offset;
-		}
-		else if (ctx->is_file && ctx->duration.num) {
-			file_pos = (u64) (ctx->file_size * com->play.start_range);
-			file_pos *= ctx->duration.den;
-			file_pos /= ctx->duration.num;
-			if (file_pos > ctx->file_size) return GF_TRUE;
+		} else {
+			Bool found = GF_FALSE;
+			if (ctx->idx_state) m2tsdmx_check_index(ctx);
+			if (ctx->idx_progs)
+				found = m2tsdmx_index_lookup(ctx, pes->program->number, com->play.start_range, &file_pos);
+
+			if (!found && ctx->is_file && ctx->duration.num) {
+				file_pos = (u64) (ctx->file_size * com->play.start_range);
+				file_pos *= ctx->duration.den;
+				file_pos /= ctx->duration.num;
+				if (file_pos > ctx->file_size) return GF_TRUE;
+			}
 		}
 
 		if (!ctx->initial_play_done) {
@@ -1395,6 +1903,8 @@ static void m2tsdmx_finalize(GF_Filter *filter)
 {
 	GF_M2TSDmxCtx *ctx = gf_filter_get_udta(filter);
 	if (ctx->ts) gf_m2ts_demux_del(ctx->ts);
+	m2tsdmx_stop_index(ctx);
+	m2tsdmx_del_index(ctx);
 
 }
 
@@ -1406,6 +1916,8 @@ static GF_Err m2tsdmx_process(GF_Filter *filter)
 	const char *data;
 	u32 size;
 
+	if (ctx->idx_state) m2tsdmx_check_index(ctx);
+
 restart:
 	pck = gf_filter_pid_get_packet(ctx->ipid);
 	if (!pck) {
@@ -1511,6 +2023,7 @@ static const GF_FilterArgs M2TSDmxArgs[] =
 	{ OFFS(sigfrag), "signal segment boundaries on output packets for DASH or HLS sources", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(dvbtxt), "export DVB teletext streams", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(index), "indexing window length", GF_PROP_DOUBLE, "1.0", NULL, GF_FS_ARG_HINT_HIDE},
+	{ OFFS(pidx), "use a persistent seek index for local files (see filter help)", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{0}
 };
 
@@ -1518,7 +2031,14 @@ static const GF_FilterArgs M2TSDmxArgs[] =
 GF_FilterRegister M2TSDmxRegister = {
 	.name = "m2tsdmx",
 	GF_FS_SET_DESCRIPTION("MPEG-2 TS demultiplexer")
-	GF_FS_SET_HELP("This filter demultiplexes MPEG-2 Transport Stream files/data into a set of media PIDs and frames.")
+	GF_FS_SET_HELP("This filter demultiplexes MPEG-2 Transport Stream files/data into a set of media PIDs and frames.\n"
+	"\n"
+	"All programs of the input are demultiplexed by a single filter. For large multi-program streams, the [tssplit](tssplit) filter can be used to route packets of each program to a dedicated demultiplexer, allowing parallel processing of programs.\n"
+	"\n"
+	"When [-pidx]() is set for a local file, the filter builds an index of random access points (offset and PTS of the first video stream, or of the first audio stream, of each program) and of the first and last PCR of each program. "
+	"The index is stored in a sidecar file with the source name and extension `.tsidx`, and reused as long as the source size and modification time do not change.\n"
+	"When no valid index is found, the file is scanned in a helper thread while being demultiplexed, duration and seeking being estimated from the file bitrate until the index is ready; "
+	"subsequent opens load the index, report the exact duration and seek using a binary search in the index.\n")
 	.private_size = sizeof(GF_M2TSDmxCtx),
 	.initialize = m2tsdmx_initialize,
 	.finalize = m2tsdmx_finalize,
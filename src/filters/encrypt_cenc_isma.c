@@ -62,6 +62,9 @@ typedef struct
 	char IV[16];
 	bin128 key;
 	u32 IV_size;
+	//encrypted ranges of the current sample, processed in a single call once the sample is parsed
+	GF_CryptRange *ranges;
+	u32 nb_ranges, nb_alloc_ranges;
 } CENC_MKey;
 
 typedef struct
@@ -1064,6 +1067,7 @@ static void cenc_free_pid_context(GF_CENCStream *cstr)
 	u32 i;
 	for (i=0; i<cstr->nb_keys; i++) {
 		if (cstr->keys[i].crypt) gf_crypt_close(cstr->keys[i].crypt);
+		if (cstr->keys[i].ranges) gf_free(cstr->keys[i].ranges);
 	}
 	gf_free(cstr->keys);
 	if (cstr->cinfo) gf_crypt_info_del(cstr->cinfo);
@@ -1588,6 +1592,23 @@ static void cenc_resync_IV(GF_Crypt *mc, char IV[16], u8 IV_size)
 
 #ifndef GPAC_DISABLE_AV_PARSERS
 //parses slice header and returns its size
+static GF_Err cenc_push_range(CENC_MKey *mkey, u32 offset, u32 size)
+{
+	if (!size) return GF_OK;
+	if (mkey->nb_ranges == mkey->nb_alloc_ranges) {
+		mkey->nb_alloc_ranges = mkey->nb_alloc_ranges ? 2*mkey->nb_alloc_ranges : 10;
+		mkey->ranges = gf_realloc(mkey->ranges, sizeof(GF_CryptRange) * mkey->nb_alloc_ranges);
+		if (!mkey->ranges) {
+			mkey->nb_alloc_ranges = mkey->nb_ranges = 0;
+			return GF_OUT_OF_MEM;
+		}
+	}
+	mkey->ranges[mkey->nb_ranges].offset = offset;
+	mkey->ranges[mkey->nb_ranges].size = size;
+	mkey->nb_ranges++;
+	return GF_OK;
+}
+
 static u32 cenc_get_clear_bytes(GF_CENCStream *cstr, GF_BitStream *plaintext_bs, char *samp_data, u32 nal_size, u32 bytes_in_nalhr)
 {
 	u32 clear_bytes = 0;
@@ -1683,6 +1704,7 @@ static GF_Err cenc_encrypt_packet(GF_CENCEncCtx *ctx, GF_CENCStream *cstr, GF_Fi
 		sai_size_sub = 6;
 	}
 	for (i=0; i<nb_keys; i++) {
+		cstr->keys[i].nb_ranges = 0;
 		if (cstr->tci->keys[i].IV_size) {
 			//in cbcs scheme, if Per_Sample_IV_size is not 0 (no constant IV), fetch current IV
 			if (!cstr->ctr_mode) {
@@ -1991,38 +2013,20 @@ static GF_Err cenc_encrypt_packet(GF_CENCEncCtx *ctx, GF_CENCStream *cstr, GF_Fi
 				//read data to encrypt
 				if (nalu_size > clear_bytes) {
 					/*get encrypted data start*/
+					u32 crypt_size;
 					u32 cur_pos = (u32) gf_bs_get_position(ctx->bs_r);
 
 					/*skip bytes of encrypted data*/
 					gf_bs_skip_bytes(ctx->bs_r, nalu_size - clear_bytes);
 
-					//cbcs scheme with constant IV, reinit at each sub sample,
-					if (!cstr->ctr_mode && !cstr->tci->keys[key_idx].IV_size)
-						gf_crypt_set_IV(cstr->keys[key_idx].crypt, cstr->keys[key_idx].IV, 16);
-
-					//pattern encryption
-					if (cstr->tci->crypt_byte_block && cstr->tci->skip_byte_block) {
-						u32 res = nalu_size - clear_bytes - clear_bytes_at_end;
-						pos = cur_pos;
-						//don't use modulo in case we use fatal_assert
-						gf_assert((res / 16) * 16 == res);
-
-						while (res) {
-							e = gf_crypt_encrypt(cstr->keys[key_idx].crypt, output+pos, res >= (u32) (16*cstr->tci->crypt_byte_block) ? 16*cstr->tci->crypt_byte_block : res);
-							if (res >= (u32) (16 * (cstr->tci->crypt_byte_block + cstr->tci->skip_byte_block))) {
-								pos += 16 * (cstr->tci->crypt_byte_block + cstr->tci->skip_byte_block);
-								res -= 16 * (cstr->tci->crypt_byte_block + cstr->tci->skip_byte_block);
-							} else {
-								res = 0;
-							}
-						}
-					}
-					//full subsample encryption
-					else {
-						//clear_bytes_at_end is 0 unless NALU-based cbcs without pattern (not defined in CENC)
-						//in this case, we must only encrypt a multiple of 16-byte blocks
-						e = gf_crypt_encrypt(cstr->keys[key_idx].crypt, output+cur_pos, nalu_size - clear_bytes - clear_bytes_at_end);
-					}
+					//clear_bytes_at_end is 0 unless NALU-based cbcs without pattern (not defined in CENC)
+					//in this case, we must only encrypt a multiple of 16-byte blocks
+					crypt_size = nalu_size - clear_bytes - clear_bytes_at_end;
+					//pattern encryption, don't use modulo in case we use fatal_assert
+					gf_assert(!cstr->tci->crypt_byte_block || !cstr->tci->skip_byte_block || ((crypt_size / 16) * 16 == crypt_size));
+
+					//encryption (pattern, constant IV reset per subsample) is done once all subsamples of the sample are known
+					e = cenc_push_range(&cstr->keys[key_idx], cur_pos, crypt_size);
 				}
 
 
@@ -2141,6 +2145,22 @@ static GF_Err cenc_encrypt_packet(GF_CENCEncCtx *ctx, GF_CENCStream *cstr, GF_Fi
 		}
 	}
 	
+	//encrypt all subsamples of each key in one go
+	for (i=0; i<nb_keys; i++) {
+		GF_Err e;
+		CENC_MKey *mkey = &cstr->keys[i];
+		if (!mkey->nb_ranges) continue;
+		//cbcs scheme with constant IV, reinit at each sub sample
+		e = gf_crypt_encrypt_ranges(mkey->crypt, output, mkey->ranges, mkey->nb_ranges,
+			cstr->tci->crypt_byte_block, cstr->tci->skip_byte_block,
+			(!cstr->ctr_mode && !cstr->tci->keys[i].IV_size) ? mkey->IV : NULL);
+		if (e) {
+			gf_bs_del(sai_bs);
+			gf_filter_pck_discard(dst_pck);
+			return e;
+		}
+	}
+
 	if (prev_entry_bytes_clear || prev_entry_bytes_crypt) {
 		if (!nb_subsamples) gf_bs_write_int(sai_bs, 0, nb_subsamples_bits);
 		nb_subsamples++;
@@ -59,6 +59,7 @@ typedef struct
 	char *ext;
 	char *mime;
 	Bool blockio;
+	u32 prio;
 
 
 	//internal
@@ -147,6 +148,7 @@ static GF_Err httpin_initialize(GF_Filter *filter)
 		return e;
 	}
 	gf_dm_sess_set_netcap_id(ctx->sess, gf_filter_get_netcap_id(filter));
+	gf_dm_sess_set_priority(ctx->sess, ctx->prio);
 	if (ctx->range.num || ctx->range.den) {
 		gf_dm_sess_set_range(ctx->sess, ctx->range.num, ctx->range.den, GF_TRUE);
 	}
@@ -330,7 +332,10 @@ static Bool httpin_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 			else if (ctx->cache==GF_HTTPIN_STORE_NONE) flags |= GF_NETIO_SESSION_NOT_CACHED;
 
 			ctx->sess = gf_dm_sess_new(ctx->dm, ctx->src, flags, NULL, NULL, &e);
-			if (ctx->sess) gf_dm_sess_set_netcap_id(ctx->sess, gf_filter_get_netcap_id(filter));
+			if (ctx->sess) {
+				gf_dm_sess_set_netcap_id(ctx->sess, gf_filter_get_netcap_id(filter));
+				gf_dm_sess_set_priority(ctx->sess, ctx->prio);
+			}
 		}
 
 		if (!e && (evt->seek.start_offset || evt->seek.end_offset))
@@ -632,6 +637,7 @@ static const GF_FilterArgs HTTPInArgs[] =
 	{ OFFS(ext), "override file extension", GF_PROP_NAME, NULL, NULL, 0},
 	{ OFFS(mime), "set file mime type", GF_PROP_NAME, NULL, NULL, 0},
 	{ OFFS(blockio), "use blocking IO", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(prio), "request priority when the number of connections per origin is limited (see `-max-conn`) or for HTTP/2 stream weight", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{0}
 };
 
@@ -774,6 +774,8 @@ static GF_Err routein_process(GF_Filter *filter)
 				u64 et = gf_route_dmx_get_last_packet_time(ctx->route_dmx);
 				u64 nb_pck = gf_route_dmx_get_nb_packets(ctx->route_dmx);
 				u64 nb_bytes = gf_route_dmx_get_recv_bytes(ctx->route_dmx);
+				u32 nb_fec_objs;
+				u64 nb_fec_syms, nb_fec_pck;
 
 				et -= st;
 				if (et) {
@@ -781,6 +783,12 @@ static GF_Err routein_process(GF_Filter *filter)
 					rate /= et;
 				}
 				sprintf(szRpt, "[%us] "LLU" bytes "LLU" packets in "LLU" ms rate %.02f mbps", now/1000, nb_bytes, nb_pck, et/1000, rate);
+				gf_route_dmx_get_fec_stats(ctx->route_dmx, &nb_fec_objs, &nb_fec_syms, &nb_fec_pck);
+				if (nb_fec_pck) {
+					char szFEC[200];
+					sprintf(szFEC, " - FEC "LLU" repair packets, %u objects ("LLU" symbols) recovered", nb_fec_pck, nb_fec_objs, nb_fec_syms);
+					strcat(szRpt, szFEC);
+				}
 				gf_filter_update_status(filter, 0, szRpt);
 			}
 		}
@@ -756,11 +756,14 @@ u32 rtpin_stream_read(GF_RTPInStream *stream)
 	}
 
 	if (gf_sk_group_sock_is_set(stream->rtpin->sockgroup, stream->rtp_ch->rtp, GF_SK_SELECT_READ)) {
-		size = gf_rtp_read_rtp(stream->rtp_ch, stream->buffer, stream->rtpin->block_size);
-		if (size) {
-			tot_size += size;
-			rtpin_stream_on_rtp_pck(stream, stream->buffer, size);
-		}
+		//datagrams are fetched by batch, process all of them
+		do {
+			size = gf_rtp_read_rtp(stream->rtp_ch, stream->buffer, stream->rtpin->block_size);
+			if (size) {
+				tot_size += size;
+				rtpin_stream_on_rtp_pck(stream, stream->buffer, size);
+			}
+		} while (stream->rtp_ch->rcv_idx < stream->rtp_ch->rcv_nb);
 		stream->rtpin->eos_probe_start = 0;
 	}
 
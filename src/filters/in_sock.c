@@ -77,6 +77,9 @@ typedef struct
 	Bool is_stop;
 
 	char *buffer;
+	//batch reception of UDP datagrams
+	u8 *mbuf;
+	u32 *mbuf_sizes;
 
 	GF_SockGroup *active_sockets;
 	u32 last_rcv_time;
@@ -85,6 +88,11 @@ typedef struct
 
 
 
+//max UDP payload size
+#define SOCKIN_SLOT_SIZE	65536
+//number of UDP datagrams fetched at once
+#define SOCKIN_BATCH	32
+
 static GF_Err sockin_initialize(GF_Filter *filter)
 {
 	char *str, *url;
@@ -192,6 +200,12 @@ static GF_Err sockin_initialize(GF_Filter *filter)
 
 	ctx->buffer = gf_malloc(ctx->block_size + 1);
 	if (!ctx->buffer) return GF_OUT_OF_MEM;
+	//only touched pages are used, typical datagrams use a single page per slot
+	if (sock_type==GF_SOCK_TYPE_UDP) {
+		ctx->mbuf = gf_malloc(SOCKIN_SLOT_SIZE * SOCKIN_BATCH);
+		ctx->mbuf_sizes = gf_malloc(sizeof(u32) * SOCKIN_BATCH);
+		if (!ctx->mbuf || !ctx->mbuf_sizes) return GF_OUT_OF_MEM;
+	}
 	//ext/mime given and not mpeg2, disable probe
 	if (ctx->ext && !strstr("ts|m2t|mts|dmb|trp", ctx->ext)) ctx->tsprobe = GF_FALSE;
 	if (ctx->mime && !strstr(ctx->mime, "mpeg-2") && !strstr(ctx->mime, "mp2t")) ctx->tsprobe = GF_FALSE;
@@ -228,6 +242,8 @@ static void sockin_finalize(GF_Filter *filter)
 	}
 	sockin_client_reset(&ctx->sock_c);
 	if (ctx->buffer) gf_free(ctx->buffer);
+	if (ctx->mbuf) gf_free(ctx->mbuf);
+	if (ctx->mbuf_sizes) gf_free(ctx->mbuf_sizes);
 	if (ctx->active_sockets) gf_sk_group_del(ctx->active_sockets);
 }
 
@@ -275,10 +291,102 @@ static Bool sockin_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 	return GF_FALSE;
 }
 
+static void sockin_update_stats(GF_SockInClient *sock_c)
+{
+	u64 now = gf_sys_clock_high_res();
+	if (now > sock_c->last_stats_time + 100000) {
+		sock_c->last_stats_time = now;
+		u64 bitrate = (now - sock_c->start_time );
+		if (bitrate) {
+			bitrate = (sock_c->nb_bytes * 8 * 1000000) / bitrate;
+			gf_filter_pid_set_info(sock_c->pid, GF_PROP_PID_DOWN_RATE, &PROP_UINT((u32) bitrate) );
+			GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[SockIn] Receiving from %s at %d kbps\r", sock_c->address, (u32) (bitrate/10)));
+		}
+	}
+}
+
+//fetch as many datagrams as possible in one call and dispatch them in a single packet
+static GF_Err sockin_read_client_batch(GF_Filter *filter, GF_SockInCtx *ctx, GF_SockInClient *sock_c)
+{
+	u32 i, nb_pck, size;
+	GF_Err e;
+	GF_FilterPacket *dst_pck;
+	u8 *out_data;
+	u32 hdr_size = 0;
+
+	e = gf_sk_receive_batch(sock_c->socket, ctx->mbuf, SOCKIN_SLOT_SIZE, SOCKIN_BATCH, ctx->mbuf_sizes, &nb_pck);
+	switch (e) {
+	case GF_OK:
+		break;
+	case GF_IP_NETWORK_EMPTY:
+		return GF_OK;
+	case GF_IP_CONNECTION_CLOSED:
+		if (!sock_c->done) {
+			sock_c->done = GF_TRUE;
+			gf_filter_pid_set_eos(sock_c->pid);
+		}
+		return GF_EOS;
+	default:
+		return e;
+	}
+	size = 0;
+	for (i=0; i<nb_pck; i++)
+		size += ctx->mbuf_sizes[i];
+	if (!size) return GF_OK;
+
+	sock_c->nb_bytes += size;
+	sock_c->done = GF_FALSE;
+
+#ifndef GPAC_DISABLE_STREAMING
+	if (sock_c->rtp_reorder) {
+		u32 nb_read;
+		char *pck;
+		for (i=0; i<nb_pck; i++) {
+			u8 *data = ctx->mbuf + i*SOCKIN_SLOT_SIZE;
+			if (ctx->mbuf_sizes[i] < 12) continue;
+			u16 seq_num = ((data[2] << 8) & 0xFF00) | (data[3] & 0xFF);
+			gf_rtp_reorderer_add(sock_c->rtp_reorder, (void *) data, ctx->mbuf_sizes[i], seq_num);
+		}
+		while ((pck = (char *) gf_rtp_reorderer_get(sock_c->rtp_reorder, &nb_read, GF_FALSE, NULL))) {
+			dst_pck = gf_filter_pck_new_shared(sock_c->pid, pck+12, nb_read-12, sockin_rtp_destructor);
+			if (dst_pck) {
+				gf_filter_pck_set_framing(dst_pck, GF_TRUE, GF_TRUE);
+				gf_filter_pck_send(dst_pck);
+			}
+		}
+		return GF_OK;
+	}
+#else
+	if (sock_c->is_rtp) {
+		hdr_size = 12;
+		size = 0;
+		for (i=0; i<nb_pck; i++) {
+			if (ctx->mbuf_sizes[i] > hdr_size) size += ctx->mbuf_sizes[i] - hdr_size;
+		}
+		if (!size) return GF_OK;
+	}
+#endif
+
+	dst_pck = gf_filter_pck_new_alloc(sock_c->pid, size, &out_data);
+	if (!dst_pck) return GF_OUT_OF_MEM;
+
+	for (i=0; i<nb_pck; i++) {
+		u32 len = ctx->mbuf_sizes[i];
+		if (len <= hdr_size) continue;
+		len -= hdr_size;
+		memcpy(out_data, ctx->mbuf + i*SOCKIN_SLOT_SIZE + hdr_size, len);
+		out_data += len;
+	}
+	gf_filter_pck_set_framing(dst_pck, GF_FALSE, GF_FALSE);
+	gf_filter_pck_send(dst_pck);
+
+	sockin_update_stats(sock_c);
+	return GF_OK;
+}
+
 static GF_Err sockin_read_client(GF_Filter *filter, GF_SockInCtx *ctx, GF_SockInClient *sock_c)
 {
 	u32 nb_read, pos;
-	u64 now;
 	GF_Err e;
 	GF_FilterPacket *dst_pck;
 	u8 *out_data, *in_data;
@@ -293,6 +401,11 @@ static GF_Err sockin_read_client(GF_Filter *filter, GF_SockInCtx *ctx, GF_SockIn
 	}
 
 	if (!sock_c->start_time) sock_c->start_time = gf_sys_clock_high_res();
+
+	//data format probed, use batch reception for UDP
+	if (sock_c->pid && ctx->mbuf)
+		return sockin_read_client_batch(filter, ctx, sock_c);
+
 	pos = 0;
 	nb_read=0;
 	while (pos < ctx->block_size) {
@@ -409,16 +522,7 @@ static GF_Err sockin_read_client(GF_Filter *filter, GF_SockInCtx *ctx, GF_SockIn
 	gf_filter_pck_send(dst_pck);
 
 	//send bitrate
-	now = gf_sys_clock_high_res();
-	if (now > sock_c->last_stats_time + 100000) {
-		sock_c->last_stats_time = now;
-		u64 bitrate = (now - sock_c->start_time );
-		if (bitrate) {
-			bitrate = (sock_c->nb_bytes * 8 * 1000000) / bitrate;
-			gf_filter_pid_set_info(sock_c->pid, GF_PROP_PID_DOWN_RATE, &PROP_UINT((u32) bitrate) );
-			GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[SockIn] Receiving from %s at %d kbps\r", sock_c->address, (u32) (bitrate/10)));
-		}
-	}
+	sockin_update_stats(sock_c);
 
 	return GF_OK;
 }
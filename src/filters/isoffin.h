@@ -175,6 +175,8 @@ typedef struct
 	u8 is_encrypted, is_cenc;
 	u8 disable_seek, set_disc;
 	u8 skip_next_play;
+	//sample data loading mode, as in reader nodata option
+	u32 nodata;
 	u8 seek_flag;
 	u8 check_avc_ps, check_hevc_ps, check_vvc_ps, check_mhas_pl;
 	u8 needs_pid_reconfig;
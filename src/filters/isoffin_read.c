@@ -703,6 +703,7 @@ ISOMChannel *isor_create_channel(ISOMReader *read, GF_FilterPid *pid, u32 track,
 	ch->owner = read;
 	ch->pid = pid;
 	ch->to_init = 1;
+	ch->nodata = read->nodata;
 	gf_list_add(read->channels, ch);
 	ch->track = track;
 	ch->item_id = item_id;
@@ -928,6 +929,9 @@ static Bool isoffin_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 		isor_reset_reader(ch);
 		ch->eos_sent = 0;
 		ch->speed = is_byte_range ? 1 : evt->play.speed;
+		//consumer only needs sample info, skip data loading unless forced by user
+		if (!read->nodata)
+			ch->nodata = evt->play.no_data ? 1 : 0;
 		ch->initial_play_seen = 1;
 		read->reset_frag_state = 1;
 		//it can happen that input_is_stop is still TRUE because we did not get called back after the stop - reset to FALSE since we now play
@@ -1527,8 +1531,8 @@ static GF_Err isoffin_process(GF_Filter *filter)
 					ch->static_sample->dataLength = 0;
 					ch->static_sample->alloc_size=0;
 				}
-				else if (read->nodata) {
-					if (read->nodata==1)
+				else if (ch->nodata) {
+					if (ch->nodata==1)
 						pck = gf_filter_pck_new_shared(ch->pid, NULL, ch->sample->dataLength, NULL);
 					else
 						pck = gf_filter_pck_new_alloc(ch->pid, ch->sample->dataLength, &data);
@@ -122,7 +122,7 @@ static void init_reader(ISOMChannel *ch)
 			ch->last_state = gf_isom_get_sample_for_movie_time(ch->owner->mov, ch->track, ch->start, &sample_desc_index, mode, &ch->static_sample, &ch->sample_num, &ch->sample_data_offset);
 		} else {
 			ch->sample_num = 1;
-			if (ch->owner->nodata) {
+			if (ch->nodata) {
 				ch->sample = gf_isom_get_sample_info_ex(ch->owner->mov, ch->track, ch->sample_num, &sample_desc_index, &ch->sample_data_offset, ch->static_sample);
 			} else {
 				ch->sample = gf_isom_get_sample_ex(ch->owner->mov, ch->track, ch->sample_num, &sample_desc_index, ch->static_sample, &ch->sample_data_offset);
@@ -333,13 +333,13 @@ void isor_reader_get_sample(ISOMChannel *ch)
 
 	if (ch->next_track) {
 		ch->track = ch->next_track;
-		if (!ch->owner->nodata)
+		if (!ch->nodata)
 			gf_isom_set_sample_alloc(ch->owner->mov, ch->track, isor_sample_alloc, ch);
 		ch->next_track = 0;
 	}
 
 	if (ch->to_init) {
-		if (!ch->owner->nodata)
+		if (!ch->nodata)
 			gf_isom_set_sample_alloc(ch->owner->mov, ch->track, isor_sample_alloc, ch);
 		init_reader(ch);
 		sample_desc_index = ch->last_sample_desc_index;
@@ -495,7 +495,7 @@ void isor_reader_get_sample(ISOMChannel *ch)
 			}
 		}
 		if (do_fetch) {
-			if (ch->owner->nodata) {
+			if (ch->nodata) {
 				ch->sample = gf_isom_get_sample_info_ex(ch->owner->mov, ch->track, ch->sample_num, &sample_desc_index, &ch->sample_data_offset, ch->static_sample);
 			} else {
 				ch->sample = gf_isom_get_sample_ex(ch->owner->mov, ch->track, ch->sample_num, &sample_desc_index, ch->static_sample, &ch->sample_data_offset);
@@ -312,7 +312,7 @@ typedef struct
 	Bool mfra;
 	u32 uncv;
 	Bool forcesync, refrag, pad_sparse;
-	Bool force_dv, tsalign, dvsingle, patch_dts;
+	Bool force_dv, tsalign, dvsingle, patch_dts, cflush;
 	u32 itags;
 	Double start;
 	u32 chapm;
@@ -405,6 +405,8 @@ typedef struct
 	u32 last_block_in_segment;
 	u64 flush_idx_start_range, flush_idx_end_range;
 	Bool flush_ll_hls;
+	//UTC of capture and of reception at muxer of first sample in current fragment, for chunk latency tracking
+	u64 chunk_cap_utc, chunk_in_utc;
 
 	Bool has_def_vid, has_def_aud, has_def_txt;
 
@@ -5597,6 +5599,18 @@ static void mp4mux_send_output(GF_MP4MuxCtx *ctx)
 	}
 }
 
+static void mp4mux_send_chunk(GF_MP4MuxCtx *ctx)
+{
+	if (!ctx->dst_pck || !ctx->chunk_in_utc) return;
+
+	//tag last packet of chunk with timing info, used by output filters for latency stats
+	if (ctx->chunk_cap_utc)
+		gf_filter_pck_set_property_str(ctx->dst_pck, "chunk_cap_utc", &PROP_LONGUINT(ctx->chunk_cap_utc) );
+	gf_filter_pck_set_property_str(ctx->dst_pck, "chunk_in_utc", &PROP_LONGUINT(ctx->chunk_in_utc) );
+	gf_filter_pck_set_property_str(ctx->dst_pck, "chunk_mux_utc", &PROP_LONGUINT(gf_net_get_utc()) );
+	ctx->chunk_cap_utc = ctx->chunk_in_utc = 0;
+}
+
 static void mp4_mux_flush_frag_hls(GF_MP4MuxCtx *ctx)
 {
 	GF_FilterEvent evt;
@@ -5659,6 +5673,8 @@ static void mp4_mux_flush_seg(GF_MP4MuxCtx *ctx, Bool is_init, u64 idx_start_ran
 			data[7] = ctx->m4cc[3];
 			mp4_mux_on_data(ctx, data, 8, NULL, 0);
 		}
+		if (!is_init)
+			mp4mux_send_chunk(ctx);
 		mp4mux_send_output(ctx);
 		if (signal_flush)
 			gf_filter_pid_send_flush(ctx->opid);
@@ -6493,6 +6509,12 @@ static GF_Err mp4_mux_process_fragmented(GF_MP4MuxCtx *ctx)
 				if (ctx->dash_mode)
 					ctx->nb_frags_in_seg++;
 
+				if (ctx->cflush) {
+					const GF_PropertyValue *ntp = gf_filter_pck_get_property(pck, GF_PROP_PCK_SENDER_NTP);
+					ctx->chunk_cap_utc = ntp ? gf_net_ntp_to_utc(ntp->value.longuint) : 0;
+					ctx->chunk_in_utc = gf_net_get_utc();
+				}
+
 			}
 
 
@@ -6803,6 +6825,11 @@ static GF_Err mp4_mux_process_fragmented(GF_MP4MuxCtx *ctx)
 			if (!ctx->dash_mode || ctx->flush_seg) {
 				mp4_mux_flush_seg(ctx, GF_FALSE, 0, 0, !is_eos);
 			}
+			//segment continues, send the last block of the fragment now rather than when the next fragment is written
+			else if (ctx->cflush) {
+				mp4mux_send_chunk(ctx);
+				mp4mux_send_output(ctx);
+			}
 		}
 		ctx->fragment_started = GF_FALSE;
 
@@ -8288,6 +8315,7 @@ static const GF_FilterArgs MP4MuxArgs[] =
 	"- both: use both chapter tracks and udta"
 	, GF_PROP_UINT, "both", "off|tk|udta|both", GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(patch_dts), "patch previous samples duration when dts do not increase monotonically", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(cflush), "send each fragment as soon as written rather than holding its last block until next fragment, and tag fragments with timing info for latency statistics (see filter help)", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(uncv), "use uncv (ISO 23001-17) for raw video\n"
 	"- off: disabled (always the case when muxing to QT)\n"
 	"- gen: enabled, do not write profile\n"
@@ -8320,6 +8348,14 @@ GF_FilterRegister MP4MuxRegister = {
 	"- If set to `replace`, SIDX/SSIX size will be estimated based on duration and DASH segment length, and padding will be used in the file __before__ the final SIDX. If input PIDs have the properties `DSegs` set, this will used be as the number of segments.\n"
 	"The `on` and `insert` modes will produce exactly the same file, while the mode `replace` may inject a `free` box before the sidx.\n"
 	"  \n"
+	"In DASH/HLS mode, the last block of a fragment is by default only sent when the next fragment is written or when the segment ends. For low latency delivery, the [-cflush]() option sends it as soon as the fragment is written, saving up to one fragment duration per fragment. "
+	"The last packet of each fragment is then tagged with the following UTC properties (in milliseconds):\n"
+	"- `chunk_cap_utc`: capture time of the first sample of the fragment, if the sample has a `SenderNTP` property (cf [-ntp](dasher))\n"
+	"- `chunk_in_utc`: reception time of the first sample of the fragment by the multiplexer\n"
+	"- `chunk_mux_utc`: time at which the fragment was written\n"
+	"These are used by [httpout](httpout) to compute per-fragment latency statistics.\n"
+	"EX gpac -i live_src -o http://localhost:8080/live.m3u8:segdur=2:cdur=0.2:llhls=sf:cflush:ntp=keep\n"
+	"  \n"
 	"# Custom boxes\n"
 	"Custom boxes can be specified as box patches:\n"
 	"For movie-level patch, the [-boxpatch]() option of the filter should be used.\n"
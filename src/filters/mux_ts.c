@@ -1153,6 +1153,8 @@ static GF_Err tsmux_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_
 	gf_filter_pid_set_property(ctx->opid, GF_PROP_PID_TIMESCALE, &PROP_UINT(90000));
 	gf_filter_pid_set_property(ctx->opid, GF_PROP_NO_TS_LOOP, &PROP_BOOL(GF_TRUE));
 	gf_filter_pid_set_property(ctx->opid, GF_PROP_PID_DASH_MODE, NULL);
+	//signal multiplex rate in CBR mode, used for pacing by network outputs
+	gf_filter_pid_set_property(ctx->opid, GF_PROP_PID_BITRATE, ctx->rate ? &PROP_UINT(ctx->rate) : NULL);
 
 	mux_assign_mime_file_ext(pid, ctx->opid, M2TS_FILE_EXTS, M2TS_MIMES, "ts");
 
@@ -35,6 +35,7 @@
 #include <gpac/config_file.h>
 #include <gpac/base_coding.h>
 #include <gpac/network.h>
+#include <gpac/thread.h>
 
 #ifdef GPAC_HAS_QJS
 #include "../quickjs/quickjs.h"
@@ -98,17 +99,18 @@ typedef struct
 } HTTP_DIRInfo;
 
 typedef struct __httpout_session GF_HTTPOutSession;
+typedef struct __httpout_worker GF_HTTPOutWorker;
 
 typedef struct
 {
 	//options
-	char *dst, *user_agent, *ifce, *cache_control, *ext, *mime, *wdir, *cert, *pkey, *reqlog;
+	char *dst, *user_agent, *ifce, *cache_control, *ext, *mime, *wdir, *cert, *pkey, *reqlog, *jit, *jitopts;
 #ifdef GPAC_HAS_QJS
 	char *js;
 #endif
-	GF_PropStringList rdirs;
+	GF_PropStringList rdirs, jitm;
 	Bool close, hold, quit, post, dlist, ice, reopen, blockio;
-	u32 port, block_size, maxc, maxp, timeout, hmode, sutc, cors, max_client_errors, max_async_buf, ka, zmax;
+	u32 port, block_size, maxc, maxp, timeout, hmode, sutc, cors, max_client_errors, max_async_buf, ka, zmax, nbth, max_cache_size, jitn;
 	s32 max_cache_segs;
 	GF_PropStringList hdrs;
 
@@ -142,6 +144,8 @@ typedef struct
 
 	const char *mem_url;
 	GF_FileIO *mem_fileio;
+	//bytes allocated by all files stored in memory
+	u64 mem_cache_size;
 	u32 nb_sess_flush_pending;
 
 	GF_List *directories;
@@ -156,8 +160,41 @@ typedef struct
 #endif
 	s32 (*on_request)(void *udta, GF_HTTPOutSession *session, const char *method, const char *url, u32 auth_code, u32 nb_hdrs, const char **hdrs);
 	void *rt_udta;
+
+	//sender threads
+	GF_List *workers;
+	u32 next_worker;
+
+	//just-in-time packaging jobs
+	GF_List *jit_jobs;
+	u32 jit_run_id;
 } GF_HTTPOutCtx;
 
+enum
+{
+	HTTP_WORKER_NONE=0,
+	HTTP_WORKER_SENDING,
+	HTTP_WORKER_DONE,
+	HTTP_WORKER_CLOSED,
+};
+
+//sender thread, owns sessions while their body is being sent
+struct __httpout_worker
+{
+	GF_HTTPOutCtx *ctx;
+	u32 idx;
+	GF_Thread *th;
+	//protects pending list and session worker state
+	GF_Mutex *mx;
+	GF_Semaphore *sema;
+	//sessions handed over by filter thread
+	GF_List *pending;
+	//sessions owned by thread, only accessed by thread
+	GF_List *sessions;
+	GF_SockGroup *sg;
+	Bool run;
+};
+
 typedef struct __httpout_input
 {
 	GF_HTTPOutCtx *ctx;
@@ -213,6 +250,11 @@ typedef struct __httpout_input
 	char *llhls_url;
 
 	Bool flush_close, flush_close_llhls, flush_open, flush_llhls_open;
+
+	//chunk latency stats in ms, for packets tagged by the multiplexer (mp4mx cflush)
+	u32 nb_chunks, nb_cap_chunks;
+	u64 chunk_mux_lat, chunk_out_lat, chunk_cap_lat;
+	u32 chunk_mux_lat_max, chunk_out_lat_max, chunk_cap_lat_max;
 } GF_HTTPOutInput;
 
 typedef struct
@@ -286,6 +328,11 @@ struct __httpout_session {
 	GF_List *headers;
 	u32 reply;
 	u64 next_process_clock;
+
+	//sender thread in charge of this session if any
+	GF_HTTPOutWorker *worker;
+	u32 worker_state;
+	GF_Err worker_err;
 };
 
 /*GF FileIO for mem mode*/
@@ -296,22 +343,58 @@ typedef struct __gf_http_io
 	u64 pos;
 
 	//only for write
-	u64 size;
+	u64 size, alloc;
 	u8 *data;
 	//source PID
 	GF_HTTPOutInput *in;
 	u32 nb_used;
 	GF_FileIO *fio;
-	Bool hls_ll_chunk, do_remove, is_static;
+	Bool hls_ll_chunk, do_remove, is_static, is_closed;
+	//last time the file was opened for read, for LRU purge
+	u64 last_access;
 } GF_HTTPFileIO;
 
 static void httpio_del(GF_HTTPFileIO *hio)
 {
 	gf_fileio_del(hio->fio);
-	if (hio->data) gf_free(hio->data);
+	if (hio->data) {
+		if (hio->in) hio->in->ctx->mem_cache_size -= hio->alloc;
+		gf_free(hio->data);
+	}
 	gf_free(hio);
 }
 
+//purge least recently used files until memory cache is below max_cache_size
+//files currently being written or read, and static files (init segments, manifests), are never purged
+static void httpio_purge_lru(GF_HTTPOutCtx *ctx)
+{
+	u32 i, j, count, count2;
+	if (!ctx->max_cache_size) return;
+
+	while (ctx->mem_cache_size > ((u64) ctx->max_cache_size)*1000) {
+		GF_HTTPFileIO *oldest = NULL;
+		count = gf_list_count(ctx->inputs);
+		for (i=0; i<count; i++) {
+			GF_HTTPOutInput *in = gf_list_get(ctx->inputs, i);
+			if (!in->mem_files) continue;
+			count2 = gf_list_count(in->mem_files);
+			for (j=0; j<count2; j++) {
+				GF_HTTPFileIO *hio = gf_list_get(in->mem_files, j);
+				if (hio->is_static || !hio->is_closed || hio->nb_used || hio->hls_ll_chunk) continue;
+				if (!oldest || (hio->last_access < oldest->last_access))
+					oldest = hio;
+			}
+		}
+		if (!oldest) {
+			GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTPOutIO] memory cache size "LLU" bytes above max_cache_size but no file can be purged\n", ctx->mem_cache_size));
+			return;
+		}
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTPOutIO] remove %s, memory cache size "LLU" bytes exceeds max_cache_size\n", gf_fileio_resource_url(oldest->fio), ctx->mem_cache_size));
+		gf_list_del_item(oldest->in->mem_files, oldest);
+		httpio_del(oldest);
+	}
+}
+
 static GF_Err httpio_seek(GF_FileIO *fileio, u64 offset, s32 whence)
 {
 	GF_HTTPFileIO *ioctx = gf_fileio_get_udta(fileio);
@@ -341,8 +424,15 @@ static u32 httpio_write(GF_FileIO *fileio, u8 *buffer, u32 bytes)
 	GF_HTTPFileIO *ioctx = gf_fileio_get_udta(fileio);
 	if (!ioctx || ioctx->parent) return 0;
 
-	ioctx->data = gf_realloc(ioctx->data, sizeof(u8)*((size_t)ioctx->size+bytes));
-	if (!ioctx->data) return 0;
+	if (ioctx->size + bytes > ioctx->alloc) {
+		//grow by half to avoid reallocating for each write
+		u64 new_alloc = ioctx->size + bytes;
+		new_alloc += new_alloc/2;
+		ioctx->data = gf_realloc(ioctx->data, sizeof(u8)*((size_t)new_alloc));
+		if (!ioctx->data) return 0;
+		if (ioctx->in) ioctx->in->ctx->mem_cache_size += new_alloc - ioctx->alloc;
+		ioctx->alloc = new_alloc;
+	}
 	memcpy(ioctx->data + ioctx->size, buffer, bytes);
 	ioctx->size += bytes;
 	ioctx->pos += bytes;
@@ -389,6 +479,17 @@ static GF_FileIO *httpio_open(GF_FileIO *fileio_ref, const char *url, const char
 		}
 		//write file io
 		gf_assert(ioctx->in);
+		ioctx->is_closed = GF_TRUE;
+		ioctx->last_access = gf_sys_clock_high_res();
+		//no reader yet, release unused allocated bytes
+		if (!ioctx->nb_used && (ioctx->alloc > ioctx->size) && ioctx->size) {
+			u8 *data = gf_realloc(ioctx->data, sizeof(u8)*((size_t)ioctx->size));
+			if (data) {
+				ioctx->data = data;
+				ioctx->in->ctx->mem_cache_size -= ioctx->alloc - ioctx->size;
+				ioctx->alloc = ioctx->size;
+			}
+		}
 
 		//purge old files
 		count = gf_list_count(ioctx->in->mem_files);
@@ -408,6 +509,7 @@ static GF_FileIO *httpio_open(GF_FileIO *fileio_ref, const char *url, const char
 			i--;
 			count--;
 		}
+		httpio_purge_lru(ioctx->in->ctx);
 		//keep active
 		return NULL;
 	}
@@ -435,6 +537,7 @@ static GF_FileIO *httpio_open(GF_FileIO *fileio_ref, const char *url, const char
 		//in read mode, the url given as parent is the gfio:// of the file
 		ioctx->parent = gf_fileio_get_udta(fileio_ref);
 		ioctx->parent->nb_used++;
+		ioctx->parent->last_access = gf_sys_clock_high_res();
 
 		gfio = gf_fileio_new((char *) gf_fileio_resource_url(fileio_ref), ioctx, httpio_open, httpio_seek, httpio_read, NULL, httpio_tell, httpio_eof, NULL);
 		if (!gfio) {
@@ -1288,11 +1391,317 @@ static void httpout_push_headers(GF_HTTPOutSession *sess)
 	gf_list_del(sess->headers);
 	sess->headers=NULL;
 }
+typedef struct
+{
+	const char *dst_dir;
+	GF_Err e;
+} HTTPJITMove;
+
+//move generated files to their final location, keeping the directory structure
+static Bool httpout_jit_move(void *cbck, char *item_name, char *item_path, GF_FileEnumInfo *file_info)
+{
+	HTTPJITMove *jm = (HTTPJITMove *) cbck;
+	char *dst = NULL;
+	gf_dynstrcat(&dst, jm->dst_dir, NULL);
+	gf_dynstrcat(&dst, item_name, NULL);
+	if (file_info->directory) {
+		HTTPJITMove sub;
+		gf_dynstrcat(&dst, "/", NULL);
+		sub.dst_dir = dst;
+		sub.e = GF_OK;
+		gf_enum_directory(item_path, GF_TRUE, httpout_jit_move, &sub, NULL);
+		if (!sub.e) gf_enum_directory(item_path, GF_FALSE, httpout_jit_move, &sub, NULL);
+		jm->e = sub.e;
+	} else {
+		//create parent directories if needed
+		gf_fopen(dst, "mkdir");
+		if (gf_file_exists(dst)) gf_file_delete(dst);
+		jm->e = gf_file_move(item_path, dst);
+	}
+	gf_free(dst);
+	return jm->e ? GF_TRUE : GF_FALSE;
+}
+
+static GF_Err httpout_jit_run(GF_HTTPOutCtx *ctx, const char *idx_path, const char *res_name, u32 run_id)
+{
+	GF_Err e;
+	char *args=NULL, *tmp_dir=NULL, *dst_dir=NULL, *sep;
+	char szTmp[50];
+	GF_Filter *src, *dst;
+	GF_FilterSession *fsess;
+	u64 clock = gf_sys_clock_high_res();
+	const char *ext = gf_file_ext_start(res_name);
+	Bool is_manifest = (ext && (!stricmp(ext, ".mpd") || !stricmp(ext, ".m3u8"))) ? GF_TRUE : GF_FALSE;
+
+	fsess = gf_fs_new_defaults(0);
+	if (!fsess) return GF_OUT_OF_MEM;
+
+	gf_dynstrcat(&args, idx_path, NULL);
+	//manifests are generated with all init segments, segments are generated one at a time
+	gf_dynstrcat(&args, is_manifest ? ":gm=all" : ":seg=", NULL);
+	if (!is_manifest)
+		gf_dynstrcat(&args, res_name, NULL);
+	src = gf_fs_load_source(fsess, args, NULL, NULL, &e);
+	gf_free(args);
+	args = NULL;
+
+	//files are generated in a hidden directory next to the index and only moved to the index directory on success,
+	//so that a failed generation never leaves incomplete files in the read directory
+	gf_dynstrcat(&dst_dir, idx_path, NULL);
+	sep = (char *) gf_file_basename(dst_dir);
+	sep[0] = 0;
+	gf_dynstrcat(&tmp_dir, dst_dir, NULL);
+	sprintf(szTmp, ".jit_%u_%u/", gf_sys_get_process_id(), run_id);
+	gf_dynstrcat(&tmp_dir, szTmp, NULL);
+
+	if (src) {
+		gf_dynstrcat(&args, tmp_dir, NULL);
+		//the manifest is not written when generating a segment, it only sets the output directory
+		gf_dynstrcat(&args, is_manifest ? res_name : "jit.mpd", NULL);
+		dst = gf_fs_load_destination(fsess, args, ctx->jitopts, NULL, &e);
+		gf_free(args);
+		if (dst) {
+			e = gf_fs_run(fsess);
+			if (e>GF_OK) e = GF_OK;
+			if (!e) e = gf_fs_get_last_connect_error(fsess);
+			if (!e) e = gf_fs_get_last_process_error(fsess);
+		}
+	}
+	gf_fs_del(fsess);
+
+	if (!e && gf_dir_exists(tmp_dir)) {
+		HTTPJITMove jm;
+		jm.dst_dir = dst_dir;
+		jm.e = GF_OK;
+		gf_enum_directory(tmp_dir, GF_TRUE, httpout_jit_move, &jm, NULL);
+		if (!jm.e) gf_enum_directory(tmp_dir, GF_FALSE, httpout_jit_move, &jm, NULL);
+		e = jm.e;
+	}
+	if (gf_dir_exists(tmp_dir)) {
+		gf_dir_cleanup(tmp_dir);
+		gf_rmdir(tmp_dir);
+	}
+	gf_free(tmp_dir);
+	gf_free(dst_dir);
+	GF_LOG(e ? GF_LOG_WARNING : GF_LOG_INFO, GF_LOG_HTTP, ("[HTTPOut] JIT packaging of %s %s in "LLU" us\n", res_name, e ? gf_error_to_string(e) : "done", gf_sys_clock_high_res() - clock));
+	return e;
+}
+
+//locate the JIT index in the directory of the missing resource or in its parents
+//return the full path of the resource to generate, or NULL if no index found or resource not allowed
+static char *httpout_jit_locate(GF_HTTPOutCtx *ctx, const char *url, char **out_idx_path, u32 *out_name_offset)
+{
+	u32 i, count = gf_list_count(ctx->directories);
+	for (i=0; i<count; i++) {
+		u32 root_len;
+		char *full_path=NULL, *idx_path=NULL, *sep, *prev;
+		HTTP_DIRInfo *adi = gf_list_get(ctx->directories, i);
+		const char *res_url = url+1;
+		//only check roots
+		if (adi->is_subpath) continue;
+		if (adi->name) {
+			if (strncmp(adi->name, url+1, adi->name_len)) continue;
+			res_url += adi->name_len;
+		}
+		if (!res_url[0] || strstr(res_url, "..")) continue;
+
+		root_len = (u32) strlen(adi->path);
+		if (!root_len) continue;
+		gf_dynstrcat(&full_path, adi->path, NULL);
+		if (!strchr("/\\", adi->path[root_len-1])) {
+			gf_dynstrcat(&full_path, "/", NULL);
+			root_len++;
+		}
+		gf_dynstrcat(&full_path, res_url, NULL);
+
+		sep = strrchr(full_path, '/');
+		while (sep && (sep - full_path >= (s32) root_len - 1)) {
+			char c = sep[1];
+			sep[1] = 0;
+			gf_dynstrcat(&idx_path, full_path, NULL);
+			sep[1] = c;
+			gf_dynstrcat(&idx_path, ctx->jit, NULL);
+			if (gf_file_exists(idx_path)) break;
+			gf_free(idx_path);
+			idx_path = NULL;
+			if (sep == full_path) break;
+			sep[0] = 0;
+			prev = strrchr(full_path, '/');
+			sep[0] = '/';
+			sep = prev;
+		}
+		if (idx_path) {
+			//resource names are relative to the index directory
+			const char *res_name = sep+1;
+			const char *ext = gf_file_ext_start(res_name);
+			//only generate manifests configured by the operator
+			if (ext && (!stricmp(ext, ".mpd") || !stricmp(ext, ".m3u8"))) {
+				u32 j;
+				Bool found = GF_FALSE;
+				for (j=0; j<ctx->jitm.nb_items; j++) {
+					if (!strcmp(ctx->jitm.vals[j], res_name)) {
+						found = GF_TRUE;
+						break;
+					}
+				}
+				if (!found) {
+					GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTPOut] Manifest %s not in JIT manifest list, ignoring\n", res_name));
+					gf_free(idx_path);
+					gf_free(full_path);
+					continue;
+				}
+			}
+			*out_idx_path = idx_path;
+			*out_name_offset = (u32) (res_name - full_path);
+			return full_path;
+		}
+		gf_free(full_path);
+	}
+	return NULL;
+}
+
+enum
+{
+	HTTP_JIT_RUNNING=0,
+	HTTP_JIT_DONE,
+};
+
+//just-in-time packaging job, run in its own thread
+typedef struct
+{
+	GF_HTTPOutCtx *ctx;
+	GF_Thread *th;
+	volatile u32 state;
+	char *res, *idx;
+	u32 name_offset, run_id;
+	GF_Err err;
+} HTTPJITJob;
+
+static u32 httpout_jit_thread(void *par)
+{
+	HTTPJITJob *job = (HTTPJITJob *) par;
+	job->err = httpout_jit_run(job->ctx, job->idx, job->res + job->name_offset, job->run_id);
+	job->state = HTTP_JIT_DONE;
+	return 0;
+}
+
+static void httpout_jit_del(HTTPJITJob *job)
+{
+	if (job->th) {
+		gf_th_stop(job->th);
+		gf_th_del(job->th);
+	}
+	if (job->res) gf_free(job->res);
+	if (job->idx) gf_free(job->idx);
+	gf_free(job);
+}
+
+static void httpout_jit_reset(GF_HTTPOutCtx *ctx)
+{
+	if (!ctx->jit_jobs) return;
+	while (gf_list_count(ctx->jit_jobs)) {
+		HTTPJITJob *job = gf_list_pop_back(ctx->jit_jobs);
+		httpout_jit_del(job);
+	}
+	gf_list_del(ctx->jit_jobs);
+	ctx->jit_jobs = NULL;
+}
+
+//check if path is being generated
+static Bool httpout_jit_pending(GF_HTTPOutCtx *ctx, const char *path)
+{
+	u32 i, count = gf_list_count(ctx->jit_jobs);
+	for (i=0; i<count; i++) {
+		const char *idx_dir, *ext;
+		HTTPJITJob *job = gf_list_get(ctx->jit_jobs, i);
+		if (job->state != HTTP_JIT_RUNNING) continue;
+		if (!strcmp(job->res, path)) return GF_TRUE;
+		//segment generation only writes the segment, manifest generation writes init segments and child playlists
+		ext = gf_file_ext_start(job->res);
+		if (!ext || (stricmp(ext, ".mpd") && stricmp(ext, ".m3u8"))) continue;
+		idx_dir = gf_file_basename(job->idx);
+		if (!strncmp(job->idx, path, idx_dir - job->idx)) return GF_TRUE;
+	}
+	return GF_FALSE;
+}
+
+//launch generation of the resource in a dedicated thread, returns the HTTP reply code
+//up to jitn resources are generated in parallel, each resource is served from disk once generated
+static u32 httpout_jit_request(GF_HTTPOutCtx *ctx, char *res_path, char *idx_path, u32 name_offset)
+{
+	u32 i, count, nb_running=0;
+	HTTPJITJob *job;
+
+	if (!ctx->jit_jobs) ctx->jit_jobs = gf_list_new();
+	count = gf_list_count(ctx->jit_jobs);
+	for (i=0; i<count; i++) {
+		job = gf_list_get(ctx->jit_jobs, i);
+		if (job->state == HTTP_JIT_RUNNING) {
+			nb_running++;
+			continue;
+		}
+		//generation of this resource failed, do not retry right away
+		if (job->err && !strcmp(job->res, res_path)) {
+			gf_list_rem(ctx->jit_jobs, i);
+			httpout_jit_del(job);
+			gf_free(res_path);
+			gf_free(idx_path);
+			return 404;
+		}
+		//keep failed jobs until their resource is requested again
+		if (job->err) continue;
+		gf_list_rem(ctx->jit_jobs, i);
+		httpout_jit_del(job);
+		i--;
+		count--;
+	}
+	if (nb_running >= MAX(ctx->jitn, 1)) {
+		gf_free(res_path);
+		gf_free(idx_path);
+		return 503;
+	}
+	//drop oldest failed jobs
+	while (gf_list_count(ctx->jit_jobs) >= MAX(ctx->jitn, 1)) {
+		job = NULL;
+		for (i=0; i<gf_list_count(ctx->jit_jobs); i++) {
+			job = gf_list_get(ctx->jit_jobs, i);
+			if (job->state == HTTP_JIT_DONE) break;
+			job = NULL;
+		}
+		if (!job) break;
+		gf_list_rem(ctx->jit_jobs, i);
+		httpout_jit_del(job);
+	}
+
+	GF_SAFEALLOC(job, HTTPJITJob);
+	if (!job) {
+		gf_free(res_path);
+		gf_free(idx_path);
+		return 500;
+	}
+	job->ctx = ctx;
+	job->res = res_path;
+	job->idx = idx_path;
+	job->name_offset = name_offset;
+	job->run_id = ++ctx->jit_run_id;
+	job->state = HTTP_JIT_RUNNING;
+	job->th = gf_th_new("HTTPOutJIT");
+	if (!job->th || (gf_th_run(job->th, httpout_jit_thread, job) != GF_OK)) {
+		job->state = HTTP_JIT_DONE;
+		httpout_jit_del(job);
+		return 500;
+	}
+	gf_list_add(ctx->jit_jobs, job);
+	return 503;
+}
+
 static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 {
 	const char *durl="";
 	char *url=NULL;
 	char *full_path=NULL;
+	char *jit_path=NULL, *jit_idx=NULL;
+	u32 jit_name_offset=0, jit_code=0;
 	char szFmt[100];
 	char szDate[200];
 	char szRange[200];
@@ -1640,14 +2049,18 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 			gf_free(full_path);
 			full_path = NULL;
 		}
+		//resource missing, check if it can be generated - generation is only launched once permissions are checked
+		if (!full_path && sess->ctx->jit && ((parameter->reply == GF_HTTP_GET) || (parameter->reply == GF_HTTP_HEAD)))
+			jit_path = httpout_jit_locate(sess->ctx, url, &jit_idx, &jit_name_offset);
+
 		//browse for permissions
-		if (full_path) {
+		if (full_path || jit_path) {
 			HTTP_DIRInfo *di = NULL;
 			u32 di_len = 0;
 			for (i=0; i<count; i++) {
 				HTTP_DIRInfo *adi = gf_list_get(sess->ctx->directories, i);
 				u32 adi_len = (u32) strlen(adi->path);
-				if (strncmp(adi->path, full_path, adi_len)) continue;
+				if (strncmp(adi->path, full_path ? full_path : jit_path, adi_len)) continue;
 				if (!di || (di_len < adi_len)) {
 					di_len = adi_len;
 					di = adi;
@@ -1687,10 +2100,36 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 		sess->reply_code = httpout_auth_check(sess->dir_desc, gf_dm_sess_get_header(sess->http_sess, "Authorization"), GF_FALSE);
 		if (sess->reply_code != 200) {
 			if (full_path) gf_free(full_path);
+			if (jit_path) gf_free(jit_path);
+			if (jit_idx) gf_free(jit_idx);
 			goto exit;
 		}
 	}
 
+	//resource being generated or to generate, ask client to retry
+	if (full_path && httpout_jit_pending(sess->ctx, full_path)) {
+		gf_free(full_path);
+		full_path = NULL;
+		jit_code = 503;
+	} else if (jit_path) {
+		if (httpout_jit_pending(sess->ctx, jit_path)) {
+			gf_free(jit_path);
+			gf_free(jit_idx);
+			jit_code = 503;
+		} else {
+			//ownership of paths is transferred
+			jit_code = httpout_jit_request(sess->ctx, jit_path, jit_idx, jit_name_offset);
+		}
+		jit_path = jit_idx = NULL;
+	}
+	if ((jit_code == 503) || (jit_code == 500)) {
+		sess->reply_code = jit_code;
+		gf_dynstrcat(&response_body, "Resource ", NULL);
+		gf_dynstrcat(&response_body, url, NULL);
+		gf_dynstrcat(&response_body, (jit_code == 503) ? " is being generated" : " cannot be generated", NULL);
+		goto exit;
+	}
+
 	if (!full_path && !source_pid) {
 		if (!sess->ctx->dlist || strcmp(url, "/")) {
 			sess->reply_code = 404;
@@ -2225,6 +2664,9 @@ exit:
 	if (sess->reply_code == 401) {
 		gf_dm_sess_set_header(sess->http_sess, "WWW-Authenticate", "Basic");
 	}
+	if (sess->reply_code == 503) {
+		gf_dm_sess_set_header(sess->http_sess, "Retry-After", "1");
+	}
 
 	if (response_body || sess->body_or_file) {
 		body_size = (u32) strlen(response_body ? response_body : sess->body_or_file);
@@ -2636,6 +3078,8 @@ check_next_conn:
 	goto check_next_conn;
 }
 
+static GF_Err httpout_create_workers(GF_HTTPOutCtx *ctx);
+
 static GF_Err httpout_initialize(GF_Filter *filter)
 {
 	char szIP[1024];
@@ -2910,6 +3354,14 @@ static GF_Err httpout_initialize(GF_Filter *filter)
 	}
 	gf_sk_group_register(ctx->sg, ctx->server_sock);
 
+	if (ctx->nbth) {
+		e = httpout_create_workers(ctx);
+		if (e) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_HTTP, ("[HTTPOut] failed to create sender threads: %s\n", gf_error_to_string(e) ));
+			return e;
+		}
+	}
+
 	gf_sk_server_mode(ctx->server_sock, GF_TRUE);
 	GF_LOG(GF_LOG_INFO, GF_LOG_HTTP, ("[HTTPOut] Server running on port %d\n", ctx->port));
 	if (ctx->reqlog) {
@@ -3055,6 +3507,8 @@ static void httpout_close_hls_chunk(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in, Boo
 }
 
 
+static void httpout_del_workers(GF_HTTPOutCtx *ctx);
+
 static void httpout_finalize(GF_Filter *filter)
 {
 	GF_HTTPOutCtx *ctx = (GF_HTTPOutCtx *) gf_filter_get_udta(filter);
@@ -3063,6 +3517,11 @@ static void httpout_finalize(GF_Filter *filter)
 	if (gf_filter_is_alias(filter))
 		return;
 
+	//stop sender threads before destroying sessions
+	if (ctx->workers) httpout_del_workers(ctx);
+	//wait for pending JIT generation
+	httpout_jit_reset(ctx);
+
 	while (gf_list_count(ctx->sessions)) {
 		GF_HTTPOutSession *tmp = gf_list_get(ctx->sessions, 0);
 		tmp->opid = NULL;
@@ -3073,6 +3532,15 @@ static void httpout_finalize(GF_Filter *filter)
 
 	while (gf_list_count(ctx->inputs)) {
 		GF_HTTPOutInput *in = gf_list_pop_back(ctx->inputs);
+		if (in->nb_chunks) {
+			char szCap[100];
+			szCap[0] = 0;
+			if (in->nb_cap_chunks)
+				sprintf(szCap, " - capture to output avg %u ms max %u ms", (u32) (in->chunk_cap_lat / in->nb_cap_chunks), in->chunk_cap_lat_max);
+			GF_LOG(GF_LOG_INFO, GF_LOG_HTTP, ("[HTTPOut] %s chunk latency over %u chunks: mux avg %u ms max %u ms - output avg %u ms max %u ms%s\n",
+				in->path ? gf_file_basename(in->path) : "output", in->nb_chunks,
+				(u32) (in->chunk_mux_lat / in->nb_chunks), in->chunk_mux_lat_max, (u32) (in->chunk_out_lat / in->nb_chunks), in->chunk_out_lat_max, szCap));
+		}
 		if (in->local_path) gf_free(in->local_path);
 		if (in->path) gf_free(in->path);
 		if (in->mime) gf_free(in->mime);
@@ -3245,12 +3713,367 @@ static void log_request_done(GF_HTTPOutSession *sess)
 	}
 }
 
-static void httpout_process_session(GF_Filter *filter, GF_HTTPOutCtx *ctx, GF_HTTPOutSession *sess)
+enum
+{
+	HTTP_SEND_PENDING=0,
+	HTTP_SEND_DONE,
+	HTTP_SEND_CLOSED,
+};
+
+//send resource data of a GET session, may be called from sender threads
+//in mem mode, get the read fileio of the session resource, NULL otherwise
+static GF_HTTPFileIO *httpout_sess_mem_io(GF_HTTPOutSession *sess)
+{
+	GF_HTTPFileIO *hio;
+	if (!sess->ctx->mem_fileio || !sess->resource) return NULL;
+	if (!gf_fileio_check(sess->resource)) return NULL;
+	hio = gf_fileio_get_udta((GF_FileIO *) sess->resource);
+	if (!hio || !hio->parent) return NULL;
+	return hio;
+}
+
+static u32 httpout_sess_send(GF_HTTPOutSession *sess, Bool *reschedule, GF_Err *send_err)
 {
 	u32 read;
-	u64 to_read=0;
-	GF_Err e = GF_OK;
+	u64 to_read;
+	GF_Err e;
+	u8 *data;
+	GF_HTTPFileIO *mem_io = httpout_sess_mem_io(sess);
 	Bool file_in_progress, last_range;
+
+	*reschedule = GF_FALSE;
+	*send_err = GF_OK;
+
+resend:
+	last_range=GF_FALSE;
+	file_in_progress = sess->file_in_progress;
+	to_read=0;
+	//we have ranges
+	if (sess->nb_ranges) {
+		Bool range_done=GF_FALSE;
+		//current range is done
+		if ((sess->ranges[sess->range_idx].end>0)
+			&& ((s64) sess->file_pos >= sess->ranges[sess->range_idx].end)
+		) {
+			//load next range, seeking file
+			if (sess->range_idx+1<sess->nb_ranges) {
+				sess->range_idx++;
+				sess->file_pos = (u64) sess->ranges[sess->range_idx].start;
+				gf_fseek(sess->resource, sess->file_pos, SEEK_SET);
+			} else {
+				range_done = GF_TRUE;
+				file_in_progress = GF_FALSE;
+			}
+		}
+		if (!range_done && (sess->range_idx<sess->nb_ranges)) {
+			if (sess->ranges[sess->range_idx].end>0) {
+				to_read = sess->ranges[sess->range_idx].end + 1 - sess->file_pos;
+				//we have an explicit closed range request, stop even if file is still being produced
+				file_in_progress = GF_FALSE;
+				if (sess->range_idx+1 == sess->nb_ranges)
+					last_range = GF_TRUE;
+			} else if (sess->file_size > sess->file_pos) {
+				to_read = sess->file_size - sess->file_pos;
+			}
+		}
+	} else if (sess->file_pos < sess->file_size) {
+		to_read = sess->file_size - sess->file_pos;
+		last_range = GF_TRUE;
+	}
+#ifdef GPAC_HAS_QJS
+	else if (sess->cbk_read) {
+		s32 nb_read = sess->cbk_read(sess->rt_udta, sess->buffer, sess->ctx->block_size);
+
+		if (nb_read<0) {
+			*reschedule = GF_TRUE;
+			sess->last_active_time = gf_sys_clock_high_res();
+			return HTTP_SEND_PENDING;
+		}
+		to_read = (u32) nb_read;
+		sess->file_size = sess->nb_bytes+nb_read;
+	}
+#endif
+
+	if (to_read) {
+		u64 remain = to_read;
+		//rescedule asap while we send
+		*reschedule = GF_TRUE;
+
+		if (to_read > (u64) sess->ctx->block_size)
+			to_read = (u64) sess->ctx->block_size;
+
+		data = sess->buffer;
+		if (sess->comp_data) {
+			data = sess->comp_data+sess->file_pos;
+			read = (u32) to_read;
+		}
+		//file in memory, shared by all sessions: send directly from the stored data, including data of files still being produced
+		else if (mem_io) {
+			GF_HTTPFileIO *par = mem_io->parent;
+			read = 0;
+			if (par->size > sess->file_pos) {
+				if (to_read > par->size - sess->file_pos)
+					to_read = par->size - sess->file_pos;
+				read = (u32) to_read;
+			}
+			if (!read) {
+				sess->last_active_time = gf_sys_clock_high_res();
+				return HTTP_SEND_PENDING;
+			}
+			data = par->data + sess->file_pos;
+			mem_io->pos = sess->file_pos + read;
+		}
+		else if (sess->resource) {
+			read = (u32) gf_fread(sess->buffer, (u32) to_read, sess->resource);
+			//may happen when file writing is in progress
+			if (!read) {
+				sess->last_active_time = gf_sys_clock_high_res();
+				return HTTP_SEND_PENDING;
+			}
+		} else {
+			read = (u32) to_read;
+		}
+		//transfer of file being uploaded, use chunk transfer
+		if (!sess->is_h2 && sess->use_chunk_transfer) {
+			char szHdr[100];
+			u32 len;
+			sprintf(szHdr, "%X\r\n", read);
+			len = (u32) strlen(szHdr);
+
+			e = gf_dm_sess_send(sess->http_sess, szHdr, len);
+			e |= gf_dm_sess_send(sess->http_sess, data, read);
+			e |= gf_dm_sess_send(sess->http_sess, "\r\n", 2);
+		} else {
+			e = gf_dm_sess_send(sess->http_sess, data, read);
+		}
+		sess->last_active_time = gf_sys_clock_high_res();
+
+		sess->file_pos += read;
+		sess->nb_bytes += read;
+
+		if (e) {
+			if ((e==GF_IP_CONNECTION_CLOSED) || (e==GF_URL_REMOVED)) {
+				GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTPOut] Connection to %s for %s closed\n", sess->peer_address, sess->path));
+				*send_err = e;
+				return HTTP_SEND_CLOSED;
+			}
+			GF_LOG(GF_LOG_ERROR, GF_LOG_HTTP, ("[HTTPOut] Error sending data to %s for %s: %s\n", sess->peer_address, sess->path, gf_error_to_string(e) ));
+		} else {
+			GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTPOut] sending data to %s for %s: "LLU"/"LLU" bytes\n", sess->peer_address, sess->path, sess->nb_bytes, sess->bytes_in_req));
+
+			//not in progress and we are done, notify (for chunk-transfer or h2) right away
+			if (!file_in_progress && last_range && (remain==read))
+				return HTTP_SEND_DONE;
+
+			if (gf_dm_sess_flush_async(sess->http_sess, GF_FALSE)==GF_OK) {
+				goto resend;
+			}
+		}
+		return HTTP_SEND_PENDING;
+	}
+	//file not done yet ...
+	if (file_in_progress || (sess->put_in_progress==1)) {
+		sess->last_active_time = gf_sys_clock_high_res();
+		return HTTP_SEND_PENDING;
+	}
+	return HTTP_SEND_DONE;
+}
+
+static Bool httpout_sess_can_offload(GF_HTTPOutSession *sess)
+{
+	if (!sess->ctx->workers) return GF_FALSE;
+	//already sent by sender thread, finalize on filter thread
+	if (sess->worker_state == HTTP_WORKER_DONE) return GF_FALSE;
+	//H2 sessions share the connection, in_source sessions and chunk transfer are driven by input data
+	if (sess->is_h2 || sess->in_source || sess->file_in_progress || sess->put_in_progress || sess->use_chunk_transfer)
+		return GF_FALSE;
+	//JS hooks run on filter thread
+	if (sess->cbk_read || sess->cbk_throttle || sess->body_or_file)
+		return GF_FALSE;
+	if (!sess->resource && !sess->comp_data)
+		return GF_FALSE;
+	return GF_TRUE;
+}
+
+static void httpout_sess_offload(GF_HTTPOutSession *sess)
+{
+	GF_HTTPOutCtx *ctx = sess->ctx;
+	GF_HTTPOutWorker *w = gf_list_get(ctx->workers, ctx->next_worker);
+	ctx->next_worker = (ctx->next_worker+1) % gf_list_count(ctx->workers);
+
+	//socket is now watched by the sender thread
+	gf_sk_group_unregister(ctx->sg, sess->socket);
+	sess->last_active_time = gf_sys_clock_high_res();
+	gf_mx_p(w->mx);
+	sess->worker = w;
+	sess->worker_state = HTTP_WORKER_SENDING;
+	gf_list_add(w->pending, sess);
+	gf_mx_v(w->mx);
+	gf_sema_notify(w->sema, 1);
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTPOut] Sending %s to %s from sender thread %d\n", sess->path, sess->peer_address, w->idx));
+}
+
+static u32 httpout_worker_run(void *par)
+{
+	GF_HTTPOutWorker *w = (GF_HTTPOutWorker *)par;
+	u32 timeout = w->ctx->timeout;
+
+	while (w->run) {
+		u32 i, count;
+		u64 now;
+		Bool selected;
+		GF_HTTPOutSession *sess;
+
+		gf_mx_p(w->mx);
+		while ((sess = gf_list_pop_front(w->pending))) {
+			gf_list_add(w->sessions, sess);
+			gf_sk_group_register(w->sg, sess->socket);
+		}
+		gf_mx_v(w->mx);
+
+		count = gf_list_count(w->sessions);
+		if (!count) {
+			gf_sema_wait_for(w->sema, 100);
+			continue;
+		}
+		//short wait so that stop requests and idle sessions are checked promptly
+		selected = (gf_sk_group_select(w->sg, 1000, GF_SK_SELECT_WRITE) == GF_OK) ? GF_TRUE : GF_FALSE;
+		now = gf_sys_clock_high_res();
+
+		for (i=0; i<count; i++) {
+			Bool reschedule;
+			GF_Err e = GF_OK;
+			u32 res;
+			sess = gf_list_get(w->sessions, i);
+			if (selected && gf_sk_group_sock_is_set(w->sg, sess->socket, GF_SK_SELECT_WRITE)) {
+				res = httpout_sess_send(sess, &reschedule, &e);
+				if (res==HTTP_SEND_PENDING) continue;
+			}
+			//peer no longer reading, close
+			else if (timeout && (now - sess->last_active_time > (u64) timeout * 1000000)) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_HTTP, ("[HTTPOut] Timeout for peer %s after %d sec in sender thread, closing connection (last request %s)\n", sess->peer_address, timeout, sess->path));
+				res = HTTP_SEND_CLOSED;
+				e = GF_IP_UDP_TIMEOUT;
+			} else {
+				continue;
+			}
+
+			//give session back to filter thread
+			gf_sk_group_unregister(w->sg, sess->socket);
+			gf_list_rem(w->sessions, i);
+			i--;
+			count--;
+			gf_mx_p(w->mx);
+			sess->worker_err = e;
+			sess->worker_state = (res==HTTP_SEND_DONE) ? HTTP_WORKER_DONE : HTTP_WORKER_CLOSED;
+			gf_mx_v(w->mx);
+			gf_filter_post_process_task(w->ctx->filter);
+		}
+	}
+	return 0;
+}
+
+//check sessions handled by sender threads, returns GF_TRUE if some sessions are still being sent
+static Bool httpout_check_workers(GF_HTTPOutCtx *ctx)
+{
+	u32 i, count;
+	Bool has_pending = GF_FALSE;
+	count = gf_list_count(ctx->active_sessions);
+	for (i=0; i<count; i++) {
+		u32 state;
+		GF_HTTPOutSession *sess = gf_list_get(ctx->active_sessions, i);
+		if (!sess->worker) continue;
+
+		gf_mx_p(sess->worker->mx);
+		state = sess->worker_state;
+		gf_mx_v(sess->worker->mx);
+		if (state==HTTP_WORKER_SENDING) {
+			has_pending = GF_TRUE;
+			continue;
+		}
+		sess->worker = NULL;
+
+		if (state==HTTP_WORKER_CLOSED) {
+			sess->worker_state = HTTP_WORKER_NONE;
+			sess->done = GF_TRUE;
+			sess->canceled = GF_FALSE;
+			httpout_close_session(sess, sess->worker_err);
+			log_request_done(sess);
+			httpout_del_session(sess);
+			i--;
+			count--;
+			continue;
+		}
+		//back to filter thread with DONE state, session will be closed or reset at next write check
+		gf_sk_group_register(ctx->sg, sess->socket);
+	}
+	return has_pending;
+}
+
+static void httpout_del_workers(GF_HTTPOutCtx *ctx)
+{
+	while (gf_list_count(ctx->workers)) {
+		GF_HTTPOutWorker *w = gf_list_pop_back(ctx->workers);
+		w->run = GF_FALSE;
+		if (w->th) {
+			if (w->sema) gf_sema_notify(w->sema, 1);
+			gf_th_stop(w->th);
+			gf_th_del(w->th);
+		}
+		while (gf_list_count(w->pending)) {
+			GF_HTTPOutSession *sess = gf_list_pop_back(w->pending);
+			sess->worker = NULL;
+		}
+		while (gf_list_count(w->sessions)) {
+			GF_HTTPOutSession *sess = gf_list_pop_back(w->sessions);
+			gf_sk_group_unregister(w->sg, sess->socket);
+			sess->worker = NULL;
+		}
+		gf_list_del(w->pending);
+		gf_list_del(w->sessions);
+		if (w->sg) gf_sk_group_del(w->sg);
+		if (w->sema) gf_sema_del(w->sema);
+		if (w->mx) gf_mx_del(w->mx);
+		gf_free(w);
+	}
+	gf_list_del(ctx->workers);
+	ctx->workers = NULL;
+}
+
+static GF_Err httpout_create_workers(GF_HTTPOutCtx *ctx)
+{
+	u32 i;
+	ctx->workers = gf_list_new();
+	if (!ctx->workers) return GF_OUT_OF_MEM;
+	for (i=0; i<ctx->nbth; i++) {
+		GF_HTTPOutWorker *w;
+		GF_SAFEALLOC(w, GF_HTTPOutWorker);
+		if (!w) return GF_OUT_OF_MEM;
+		gf_list_add(ctx->workers, w);
+		w->ctx = ctx;
+		w->idx = i+1;
+		w->pending = gf_list_new();
+		w->sessions = gf_list_new();
+		w->sg = gf_sk_group_new();
+		w->mx = gf_mx_new("HTTPOutWorker");
+		w->sema = gf_sema_new(GF_INT_MAX, 0);
+		w->th = gf_th_new("HTTPOutWorker");
+		if (!w->pending || !w->sessions || !w->sg || !w->mx || !w->sema || !w->th) return GF_OUT_OF_MEM;
+		w->run = GF_TRUE;
+		if (gf_th_run(w->th, httpout_worker_run, w) != GF_OK) {
+			w->run = GF_FALSE;
+			return GF_IO_ERR;
+		}
+	}
+	GF_LOG(GF_LOG_INFO, GF_LOG_HTTP, ("[HTTPOut] Using %d sender threads\n", ctx->nbth));
+	return GF_OK;
+}
+
+static void httpout_process_session(GF_Filter *filter, GF_HTTPOutCtx *ctx, GF_HTTPOutSession *sess)
+{
+	u32 read, res;
+	GF_Err e = GF_OK;
+	Bool reschedule;
 	Bool close_session = ctx->close;
 
 	if (sess->force_destroy) {
@@ -3524,127 +4347,26 @@ static void httpout_process_session(GF_Filter *filter, GF_HTTPOutCtx *ctx, GF_HT
 		gf_fseek(sess->resource, sess->file_pos, SEEK_SET);
 	}
 
-resend:
-	last_range=GF_FALSE;
-	file_in_progress = sess->file_in_progress;
-	to_read=0;
-	//we have ranges
-	if (sess->nb_ranges) {
-		Bool range_done=GF_FALSE;
-		//current range is done
-		if ((sess->ranges[sess->range_idx].end>0)
-			&& ((s64) sess->file_pos >= sess->ranges[sess->range_idx].end)
-		) {
-			//load next range, seeking file
-			if (sess->range_idx+1<sess->nb_ranges) {
-				sess->range_idx++;
-				sess->file_pos = (u64) sess->ranges[sess->range_idx].start;
-				gf_fseek(sess->resource, sess->file_pos, SEEK_SET);
-			} else {
-				range_done = GF_TRUE;
-				file_in_progress = GF_FALSE;
-			}
-		}
-		if (!range_done && (sess->range_idx<sess->nb_ranges)) {
-			if (sess->ranges[sess->range_idx].end>0) {
-				to_read = sess->ranges[sess->range_idx].end + 1 - sess->file_pos;
-				//we have an explicit closed range request, stop even if file is still being produced
-				file_in_progress = GF_FALSE;
-				if (sess->range_idx+1 == sess->nb_ranges)
-					last_range = GF_TRUE;
-			} else if (sess->file_size > sess->file_pos) {
-				to_read = sess->file_size - sess->file_pos;
-			}
-		}
-	} else if (sess->file_pos < sess->file_size) {
-		to_read = sess->file_size - sess->file_pos;
-		last_range = GF_TRUE;
-	}
-#ifdef GPAC_HAS_QJS
-	else if (sess->cbk_read) {
-		s32 nb_read = sess->cbk_read(sess->rt_udta, sess->buffer, sess->ctx->block_size);
-
-		if (nb_read<0) {
-			ctx->next_wake_us = 1;
-			sess->last_active_time = gf_sys_clock_high_res();
-			return;
-		}
-		to_read = (u32) nb_read;
-		sess->file_size = sess->nb_bytes+nb_read;
-	}
-#endif
-
-	if (to_read) {
-		u64 remain = to_read;
-		//rescedule asap while we send
-		ctx->next_wake_us = 1;
-
-		if (to_read > (u64) sess->ctx->block_size)
-			to_read = (u64) sess->ctx->block_size;
-
-		if (sess->comp_data) {
-			memcpy(sess->buffer, sess->comp_data+sess->file_pos, to_read);
-			read = (u32) to_read;
-		}
-		else if (sess->resource) {
-			read = (u32) gf_fread(sess->buffer, (u32) to_read, sess->resource);
-			//may happen when file writing is in progress
-			if (!read) {
-				sess->last_active_time = gf_sys_clock_high_res();
-				return;
-			}
-		} else {
-			read = (u32) to_read;
-		}
-		//transfer of file being uploaded, use chunk transfer
-		if (!sess->is_h2 && sess->use_chunk_transfer) {
-			char szHdr[100];
-			u32 len;
-			sprintf(szHdr, "%X\r\n", read);
-			len = (u32) strlen(szHdr);
-
-			e = gf_dm_sess_send(sess->http_sess, szHdr, len);
-			e |= gf_dm_sess_send(sess->http_sess, sess->buffer, read);
-			e |= gf_dm_sess_send(sess->http_sess, "\r\n", 2);
-		} else {
-			e = gf_dm_sess_send(sess->http_sess, sess->buffer, read);
-		}
-		sess->last_active_time = gf_sys_clock_high_res();
-
-		sess->file_pos += read;
-		sess->nb_bytes += read;
-
-		if (e) {
-			if ((e==GF_IP_CONNECTION_CLOSED) || (e==GF_URL_REMOVED)) {
-				GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTPOut] Connection to %s for %s closed\n", sess->peer_address, sess->path));
-				sess->done = GF_TRUE;
-				sess->canceled = GF_FALSE;
-				httpout_close_session(sess, e);
-				log_request_done(sess);
-				return;
-			}
-			GF_LOG(GF_LOG_ERROR, GF_LOG_HTTP, ("[HTTPOut] Error sending data to %s for %s: %s\n", sess->peer_address, sess->path, gf_error_to_string(e) ));
-		} else {
-			GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTPOut] sending data to %s for %s: "LLU"/"LLU" bytes\n", sess->peer_address, sess->path, sess->nb_bytes, sess->bytes_in_req));
-
-			//not in progress and we are done, notify (for chunk-transfer or h2) right away
-			if (!file_in_progress && last_range && (remain==read))
-				goto session_done;
-
-			if (gf_dm_sess_flush_async(sess->http_sess, GF_FALSE)==GF_OK) {
-				goto resend;
-			}
-		}
+	//sender threads only handle plain transfers of completed resources
+	if (httpout_sess_can_offload(sess)) {
+		httpout_sess_offload(sess);
 		return;
 	}
-	//file not done yet ...
-	if (file_in_progress || (sess->put_in_progress==1)) {
-		sess->last_active_time = gf_sys_clock_high_res();
+
+	res = httpout_sess_send(sess, &reschedule, &e);
+	if (reschedule) ctx->next_wake_us = 1;
+	if (res==HTTP_SEND_PENDING) return;
+	if (res==HTTP_SEND_CLOSED) {
+		sess->done = GF_TRUE;
+		sess->canceled = GF_FALSE;
+		httpout_close_session(sess, e);
+		log_request_done(sess);
 		return;
 	}
 
 session_done:
 
+	sess->worker_state = HTTP_WORKER_NONE;
 	sess->file_pos = sess->file_size;
 	sess->last_active_time = gf_sys_clock_high_res();
 
@@ -4350,6 +5072,45 @@ static void httpout_prune_files(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in)
 	}
 }
 
+static void httpout_update_chunk_stats(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in, GF_FilterPacket *pck)
+{
+	u64 now, mux_utc, in_utc;
+	u32 mux_lat, out_lat, cap_lat=0;
+	const char *name = in->path;
+	const GF_PropertyValue *p = gf_filter_pck_get_property_str(pck, "chunk_mux_utc");
+	if (!p) return;
+	mux_utc = p->value.longuint;
+	p = gf_filter_pck_get_property_str(pck, "chunk_in_utc");
+	in_utc = p ? p->value.longuint : mux_utc;
+	now = gf_net_get_utc();
+	if (!name) name = "output";
+
+	mux_lat = (mux_utc > in_utc) ? (u32) (mux_utc - in_utc) : 0;
+	out_lat = (now > mux_utc) ? (u32) (now - mux_utc) : 0;
+	in->nb_chunks++;
+	in->chunk_mux_lat += mux_lat;
+	in->chunk_out_lat += out_lat;
+	if (mux_lat > in->chunk_mux_lat_max) in->chunk_mux_lat_max = mux_lat;
+	if (out_lat > in->chunk_out_lat_max) in->chunk_out_lat_max = out_lat;
+
+	p = gf_filter_pck_get_property_str(pck, "chunk_cap_utc");
+	if (p && p->value.longuint) {
+		cap_lat = (now > p->value.longuint) ? (u32) (now - p->value.longuint) : 0;
+		in->nb_cap_chunks++;
+		in->chunk_cap_lat += cap_lat;
+		if (cap_lat > in->chunk_cap_lat_max) in->chunk_cap_lat_max = cap_lat;
+	}
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTPOut] %s chunk %u latency: mux %u ms output %u ms capture to output %u ms\n", name, in->nb_chunks, mux_lat, out_lat, cap_lat));
+
+	if (gf_filter_reporting_enabled(ctx->filter)) {
+		char szStatus[1024];
+		snprintf(szStatus, 1024, "%s: %u chunks - avg latency mux %u ms output %u ms capture %u ms", gf_file_basename(name), in->nb_chunks,
+			(u32) (in->chunk_mux_lat / in->nb_chunks), (u32) (in->chunk_out_lat / in->nb_chunks),
+			in->nb_cap_chunks ? (u32) (in->chunk_cap_lat / in->nb_cap_chunks) : 0);
+		gf_filter_update_status(ctx->filter, -1, szStatus);
+	}
+}
+
 static void httpout_process_inputs(GF_HTTPOutCtx *ctx)
 {
 	Bool keep_alive=GF_FALSE;
@@ -4607,6 +5368,7 @@ next_pck:
 			if (end) {
 				httpout_close_input(ctx, in);
 			}
+			httpout_update_chunk_stats(ctx, in, pck);
 			gf_filter_pid_drop_packet(in->ipid);
 			if (in->nb_write && ctx->quit) {
 				httpout_input_in_error(in, GF_OK);
@@ -4745,6 +5507,7 @@ next_pck:
 		}
 
 packet_done:
+		httpout_update_chunk_stats(ctx, in, pck);
 		gf_filter_pid_drop_packet(in->ipid);
 		if (end) {
 			httpout_close_input(ctx, in);
@@ -4793,6 +5556,12 @@ static GF_Err httpout_process(GF_Filter *filter)
 	//wakeup every 50ms when inactive
 	ctx->next_wake_us = 50000;
 
+	if (ctx->workers) {
+		//sessions still in sender threads, we will be woken up when done
+		if (httpout_check_workers(ctx))
+			ctx->next_wake_us = 10000;
+	}
+
 	e = gf_sk_group_select(ctx->sg, 10, GF_SK_SELECT_BOTH);
 	if ((e==GF_OK) && ctx->server_sock) {
 		//server mode, check pending connections
@@ -4803,6 +5572,9 @@ static GF_Err httpout_process(GF_Filter *filter)
 		count = gf_list_count(ctx->active_sessions);
 		for (i=0; i<count; i++) {
 			GF_HTTPOutSession *sess = gf_list_get(ctx->active_sessions, i);
+			//owned by sender thread
+			if (sess->worker) continue;
+
 			if ((sess->flush_close && !httpout_sess_flush_close(sess, GF_FALSE))
 #ifdef GPAC_HAS_QJS
 				|| (sess->async_pending==1)
@@ -4858,6 +5630,7 @@ static GF_Err httpout_process(GF_Filter *filter)
 			u32 diff_sec;
 			GF_HTTPOutSession *sess = gf_list_get(ctx->active_sessions, i);
 			if (sess->http_sess) nb_active++;
+			if (sess->worker) continue;
 
 			diff_sec = (u32) (gf_sys_clock_high_res() - sess->last_active_time)/1000000;
 			if (diff_sec>ctx->timeout) {
@@ -5004,6 +5777,7 @@ static const GF_FilterArgs HTTPOutArgs[] =
 	{ OFFS(ice), "insert ICE meta-data in response headers in sink mode", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(max_client_errors), "force disconnection after specified number of consecutive errors from HTTTP 1.1 client (ignored in H/2 or when `close` is set)", GF_PROP_UINT, "20", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(max_cache_segs), "maximum number of segments cached per HAS quality (see filter help)", GF_PROP_SINT, "5", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(max_cache_size), "maximum size in kilobytes of files cached in memory mode, 0 means no limit (see filter help)", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(reopen), "in server mode with no read dir, accept requests on files already over but with input pid not in end of stream", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(max_async_buf), "maximum async buffer size in bytes when sharing output over multiple connection without file IO", GF_PROP_UINT, "100000", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(blockio), "use blocking IO in push or source mode or in server mode with no read dir", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
@@ -5013,6 +5787,11 @@ static const GF_FilterArgs HTTPOutArgs[] =
 	{ OFFS(js), "javascript logic for server", GF_PROP_STRING, NULL, NULL, GF_FS_ARG_HINT_EXPERT},
 #endif
 	{ OFFS(zmax), "maximum uncompressed size allowed for gzip or deflate compression for text files (only enabled if client indicates it), 0 will disable compression", GF_PROP_UINT, "50000", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(nbth), "number of sender threads in server mode, 0 sends all data from filter thread (see filter help)", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(jit), "name of index file enabling just-in-time packaging of missing resources in read directories (see filter help)", GF_PROP_STRING, NULL, NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(jitopts), "options of the dasher used for just-in-time packaging", GF_PROP_STRING, NULL, NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(jitm), "list of manifest names allowed for just-in-time packaging, relative to the index directory", GF_PROP_STRING_LIST, NULL, NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(jitn), "maximum number of resources packaged just-in-time in parallel", GF_PROP_UINT, "4", NULL, GF_FS_ARG_HINT_EXPERT},
 	{0}
 };
 
@@ -5055,6 +5834,10 @@ GF_FilterRegister HTTPOutRegister = {
 		"  \n"
 		"Text files are compressed using gzip or deflate if the client accepts these encodings, unless [-no_z]() is set.\n"
 		"  \n"
+		"In server mode, response bodies of completed resources (files on disk or in memory, compressed text) can be sent from [-nbth]() sender threads, each thread watching its own set of client connections.\n"
+		"Request parsing, resources being produced (chunk transfer), HTTP/2 connections and JS-controlled sessions are always handled by the filter thread.\n"
+		"EX gpac httpout:rdirs=outcoming:nbth=4\n"
+		"  \n"
 		"# Simple HTTP server\n"
 		"In this mode, the filter does not need any input connection and exposes all files in the directories given by [-rdirs]().\n"
 		"PUT and POST methods are only supported if a write directory is specified by [-wdir]() option.\n"
@@ -5107,6 +5890,11 @@ GF_FilterRegister HTTPOutRegister = {
 		"- `MAX(N, time-shift depth)` files if stored locally and `N` is positive\n"
 		"- unlimited otherwise (files stored locally, `N` is positive and no time-shift info)\n"
 		"  \n"
+		"In memory mode, files are shared by all clients: data is sent directly from memory, including for files still being produced (e.g. low latency chunks), without per-client copy or disk read.\n"
+		"If [-max_cache_size]() is set, the least recently requested files are removed from memory whenever the total size exceeds the limit. Init segments, manifests and files being produced or sent are never removed.\n"
+		"EX gpac -i SOURCE reframer:rt=on -o http://localhost:8080/live.mpd:rdirs=gmem:max_cache_segs=100:max_cache_size=200000 --dmode=dynamic\n"
+		"In this example, at most 100 segments per quality are kept in memory, for a total of at most 200 MB.\n"
+		"  \n"
 		"# HTTP client sink\n"
 		"In this mode, the filter will upload input PIDs data to remote server using PUT (or POST if [-post]() is set).\n"
 		"This mode must be explicitly activated using [-hmode]().\n"
@@ -5121,11 +5909,33 @@ GF_FilterRegister HTTPOutRegister = {
 		"EX gpac httpout:hmode=source vout aout\n"
 		"In this example, the filter will try to play uploaded files through video and audio output.\n"
 		"  \n"
+		"# Low latency statistics\n"
+		"When input packets carry fragment timing info (cf [-cflush](mp4mx)), the filter logs per-fragment latency at debug level, a summary at info level when closing, and reports average latencies in the filter status:\n"
+		"- mux: time between reception of the first sample of the fragment by the multiplexer and fragment writing, including fragment buffering\n"
+		"- output: time between fragment writing and its processing by the server\n"
+		"- capture: time between capture of the first sample of the fragment and its processing by the server, only available when source packets carry NTP\n"
+		"  \n"
 		"# HTTPS server\n"
 		"The server can run over TLS (https) for all the server modes. TLS is enabled by specifying [-cert]() and [-pkey]() options.\n"
 		"Both certificate and key must be in PEM format.\n"
 		"The server currently only operates in either HTTPS or HTTP mode and cannot run both modes at the same time. You will need to use two httpout filters for this, one operating in HTTPS and one operating in HTTP.\n"
 		"  \n"
+		"# Just-in-time packaging\n"
+		"When [-jit]() is set in server mode, a GET or HEAD request for a file missing from [-rdirs]() triggers its generation from a GHI index (see `ghidmx` help) "
+		"named [-jit]() and located in the directory of the requested file or in one of its parents.\n"
+		"The file name is resolved relative to the index directory:\n"
+		"- manifests (MPD or M3U8) listed in [-jitm]() are generated with all init segments, other manifest names are never generated\n"
+		"- init and media segments are generated using the index segment template, by seeking to the segment samples and packaging only these samples\n"
+		"Generated files are written next to the index and are served directly on subsequent requests, the read directory acting as a cache. "
+		"Files are first generated in a temporary directory and only moved next to the index if generation succeeds.\n"
+		"Each resource is generated in a dedicated thread, with up to [-jitn]() resources generated in parallel. The request triggering the generation, requests to files being generated, "
+		"and requests to missing files while [-jitn]() generations are running, are answered with a 503 reply and a `Retry-After` header until generation is done.\n"
+		"JIT packaging is only performed once the request passes the access rights of the target directory.\n"
+		"Options for the dasher may be set using [-jitopts](), and must match the ones used when generating the manifest.\n"
+		"EX gpac -i source.mp4 -o idx.ghi:segdur=2\n"
+		"EX gpac httpout:port=8080:rdirs=media:jit=idx.ghi:jitm=live.mpd\n"
+		"This will serve `media/live.mpd` and all its segments from `media/idx.ghi`, packaging them upon first request.\n"
+		"  \n"
 		"# Multiple destinations on single server\n"
 		"When running in server mode, multiple HTTP outputs with same URL/port may be used:\n"
 		"- the first loaded HTTP output filter with same URL/port will be reused\n"
@@ -29,6 +29,7 @@
 #include <gpac/xml.h>
 #include <gpac/route.h>
 #include <gpac/network.h>
+#include <gpac/internal/reedsolomon.h>
 
 #if !defined(GPAC_DISABLE_ROUTE)
 
@@ -39,10 +40,26 @@ enum
 	LCT_SPLIT_ALL,
 };
 
+//max number of LCT packets sent at once
+#define ROUTE_SEND_BATCH	16
+//extra rate in percent over the sum of stream rates of an LCT channel when pacing, for signaling and init segments
+#define ROUTE_PACE_MARGIN	20
+
+//LCT header size of repair packets: LCT header, EXT_FTI and FEC payload ID
+#define ROUTE_FEC_HDR_SIZE	36
+
+enum
+{
+	ROUTE_PACE_NO = 0,
+	ROUTE_PACE_SW,
+	ROUTE_PACE_KERNEL,
+	ROUTE_PACE_TXTIME,
+};
+
 typedef struct
 {
 	char *dst, *ext, *mime, *ifce, *ip;
-	u32 carousel, first_port, bsid, mtu, splitlct, ttl, brinc, runfor;
+	u32 carousel, first_port, bsid, mtu, splitlct, ttl, brinc, runfor, pace, burst, fec;
 	Bool korean, llmode, noreg;
 
 	GF_FilterCapability in_caps[2];
@@ -63,11 +80,21 @@ typedef struct
 	u32 lls_slt_table_len;
 
 	u64 bytes_sent;
+	//LCT packets pending for batch send on lct_sock, each packet uses mtu bytes in lct_buffer
 	u8 *lct_buffer;
+	GF_Socket *lct_sock;
+	const u8 *lct_pck[ROUTE_SEND_BATCH];
+	u32 lct_size[ROUTE_SEND_BATCH];
+	u32 nb_lct_pending;
 
 	u64 reschedule_us;
 	u32 next_raw_file_toi;
 
+	//AL-FEC max source block length in symbols, and zero-padded last source symbol
+	u32 fec_max_k;
+	u8 *fec_pad;
+	u64 fec_nb_repair;
+
 	Bool reporting_on;
 	u64 total_size, total_bytes;
 	Bool total_size_unknown;
@@ -83,6 +110,8 @@ typedef struct
 
 	//for now we use a single route session per service, differenciated by TSI
 	GF_Socket *sock;
+	//pacing rate of the channel
+	u32 pace_rate;
 
 } ROUTELCT;
 
@@ -169,6 +198,10 @@ typedef struct
 	u32 pck_dur_at_frame_start;
 
 	u32 bitrate;
+
+	//object reassembly for AL-FEC when sent in several packets
+	u8 *fec_buf;
+	u32 fec_alloc;
 } ROUTEPid;
 
 
@@ -272,6 +305,7 @@ void routeout_remove_pid(ROUTEPid *rpid, Bool is_rem)
 	if (rpid->hld_child_pl_name) gf_free(rpid->hld_child_pl_name);
 	if (rpid->template) gf_free(rpid->template);
 	if (rpid->seg_name) gf_free(rpid->seg_name);
+	if (rpid->fec_buf) gf_free(rpid->fec_buf);
 
 	if (rpid->current_pck)
 		gf_filter_pck_unref(rpid->current_pck);
@@ -304,6 +338,52 @@ void routeout_delete_service(ROUTEService *serv)
 	gf_free(serv);
 }
 
+//pace each LCT channel at the sum of its stream rates
+static void routeout_update_pacing(GF_ROUTEOutCtx *ctx, ROUTEService *rserv)
+{
+	u32 i, j, flags = 0;
+	if (!ctx->pace) return;
+	if (ctx->pace==ROUTE_PACE_KERNEL) flags = GF_SK_PACING_KERNEL;
+	else if (ctx->pace==ROUTE_PACE_TXTIME) flags = GF_SK_PACING_TXTIME;
+
+	for (i=0; i<gf_list_count(rserv->rlcts); i++) {
+		u64 rate = 0;
+		Bool unknown = GF_FALSE;
+		ROUTELCT *rlct = gf_list_get(rserv->rlcts, i);
+		for (j=0; j<gf_list_count(rserv->pids); j++) {
+			ROUTEPid *rpid = gf_list_get(rserv->pids, j);
+			if ((rpid->rlct != rlct) || rpid->manifest_type) continue;
+			if (!rpid->bitrate) unknown = GF_TRUE;
+			rate += rpid->bitrate;
+		}
+		//one stream with unknown rate, do not pace
+		if (unknown) rate = 0;
+		//repair symbols are sent on the same channel
+		rate = rate * (100 + ctx->fec) / 100;
+		rate = rate * (100 + ROUTE_PACE_MARGIN) / 100;
+		if (rate > 0xFFFFFFFF) rate = 0xFFFFFFFF;
+		if (rlct->pace_rate == (u32) rate) continue;
+
+		if (!rate && unknown) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_ROUTE, ("[ROUTE] Unknown stream bitrate on LCT channel %s:%d, pacing disabled\n", rlct->ip, rlct->port));
+		}
+		rlct->pace_rate = (u32) rate;
+		gf_sk_set_pacing(rlct->sock, rlct->pace_rate, ctx->burst, flags);
+	}
+}
+
+//get delay before next LCT packet can be sent on a paced channel, accounting for LCT packets not yet sent
+static u32 routeout_pace_delay(GF_ROUTEOutCtx *ctx, ROUTELCT *rlct)
+{
+	u32 i, pending = 0;
+	if (!rlct->pace_rate) return 0;
+	if (ctx->lct_sock == rlct->sock) {
+		for (i=0; i<ctx->nb_lct_pending; i++)
+			pending += ctx->lct_size[i];
+	}
+	return gf_sk_pacing_delay(rlct->sock, pending + ctx->mtu);
+}
+
 static GF_Err routeout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remove)
 {
 	const GF_PropertyValue *p;
@@ -537,6 +617,8 @@ static GF_Err routeout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool
 	}
 
 
+	routeout_update_pacing(ctx, rserv);
+
 	gf_filter_pid_init_play_event(pid, &evt, 0, 1.0, "ROUTEOut");
 	gf_filter_pid_send_event(pid, &evt);
 
@@ -641,7 +723,20 @@ static GF_Err routeout_initialize(GF_Filter *filter)
 		gf_sk_setup_multicast(ctx->sock_atsc_lls, GF_ATSC_MCAST_ADDR, GF_ATSC_MCAST_PORT, 0, GF_FALSE, ctx->ifce);
 	}
 
-	ctx->lct_buffer = gf_malloc(sizeof(u8) * ctx->mtu);
+	ctx->lct_buffer = gf_malloc(sizeof(u8) * ctx->mtu * ROUTE_SEND_BATCH);
+	if (ctx->fec) {
+		if (ctx->mtu <= ROUTE_FEC_HDR_SIZE + 4) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_ROUTE, ("[ROUTE] MTU %u too small for FEC\n", ctx->mtu));
+			return GF_BAD_PARAM;
+		}
+		//k source symbols and ceil(k*fec/100) repair symbols per block must fit in 255 encoding symbols
+		ctx->fec_max_k = 25500 / (100 + ctx->fec);
+		if (!ctx->fec_max_k) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_ROUTE, ("[ROUTE] FEC overhead %u percent too high\n", ctx->fec));
+			return GF_BAD_PARAM;
+		}
+		ctx->fec_pad = gf_malloc(sizeof(u8) * (ctx->mtu - ROUTE_FEC_HDR_SIZE));
+	}
 	ctx->clock_init = gf_sys_clock_high_res();
 	ctx->clock_stats = ctx->clock_init;
 
@@ -669,6 +764,7 @@ static void routeout_finalize(GF_Filter *filter)
 		gf_sk_del(ctx->sock_atsc_lls);
 
 	if (ctx->lct_buffer) gf_free(ctx->lct_buffer);
+	if (ctx->fec_pad) gf_free(ctx->fec_pad);
 	if (ctx->lls_slt_table) gf_free(ctx->lls_slt_table);
 	if (ctx->lls_time_table) gf_free(ctx->lls_time_table);
 }
@@ -1215,16 +1311,26 @@ static GF_Err routeout_check_service_updates(GF_ROUTEOutCtx *ctx, ROUTEService *
 				gf_dynstrcat(&payload_text, "/>\n", NULL);
 				gf_dynstrcat(&payload_text, "    </ContentInfo>\n", NULL);
 			}
-			//setup payload format - we remove srcFecPayloadId=\"0\" as there is no FEC support yet
+			//setup payload format - srcFecPayloadId=\"0\" (start offset) is the default and not signaled
 			snprintf(temp, 1000,
 					"    <Payload codePoint=\"%d\" formatId=\"%d\" frag=\"0\" order=\"true\"/>\n"
 					, rpid->fmtp, rpid->mode);
 
 			gf_dynstrcat(&payload_text, temp, NULL);
-
-			gf_dynstrcat(&payload_text,
-					"   </SrcFlow>\n"
-					"  </LS>\n", NULL);
+			gf_dynstrcat(&payload_text, "   </SrcFlow>\n", NULL);
+
+			//repair packets are sent on the same TSI with PSI=b00
+			if (ctx->fec) {
+				snprintf(temp, 1000,
+					"   <RprFlow>\n"
+					"    <FECParameters fecEncodingId=\"%d\" maximumDelay=\"0\">\n"
+					"     <ProtectedObject tsi=\"%u\"/>\n"
+					"    </FECParameters>\n"
+					"   </RprFlow>\n"
+					, GF_RS_FEC_ENCODING_ID, rpid->tsi);
+				gf_dynstrcat(&payload_text, temp, NULL);
+			}
+			gf_dynstrcat(&payload_text, "  </LS>\n", NULL);
 		}
 		gf_dynstrcat(&payload_text, " </RS>\n", NULL);
 	}
@@ -1259,13 +1365,50 @@ static GF_Err routeout_check_service_updates(GF_ROUTEOutCtx *ctx, ROUTEService *
 }
 
 
+//send pending LCT packets - packets not sent because the socket would block are kept and sent at next flush
+//if force is set, the function only returns once all packets are sent or dropped
+static void routeout_lct_flush(GF_ROUTEOutCtx *ctx, Bool force)
+{
+	while (ctx->nb_lct_pending) {
+		GF_Err e;
+		u32 i, nb_sent=0;
+
+		e = gf_sk_send_batch(ctx->lct_sock, ctx->lct_pck, ctx->lct_size, ctx->nb_lct_pending, &nb_sent);
+		if (!e) {
+			ctx->nb_lct_pending = 0;
+			return;
+		}
+		//move unsent packets at the beginning of the buffer
+		if (nb_sent) {
+			ctx->nb_lct_pending -= nb_sent;
+			memmove(ctx->lct_buffer, ctx->lct_buffer + nb_sent * ctx->mtu, ctx->nb_lct_pending * ctx->mtu);
+			for (i=0; i<ctx->nb_lct_pending; i++) {
+				ctx->lct_pck[i] = ctx->lct_buffer + i * ctx->mtu;
+				ctx->lct_size[i] = ctx->lct_size[i + nb_sent];
+			}
+		}
+		if ((e==GF_IP_NETWORK_EMPTY) || (e==GF_BUFFER_TOO_SMALL)) {
+			if (!force) return;
+			gf_sleep(1);
+			continue;
+		}
+		GF_LOG(GF_LOG_ERROR, GF_LOG_ROUTE, ("[ROUTE] Failed to send %u LCT packets: %s\n", ctx->nb_lct_pending, gf_error_to_string(e) ));
+		ctx->nb_lct_pending = 0;
+	}
+}
+
 u32 routeout_lct_send(GF_ROUTEOutCtx *ctx, GF_Socket *sock, u32 tsi, u32 toi, u32 codepoint, u8 *payload, u32 len, u32 offset, u32 service_id, u32 total_size, u32 offset_in_frame)
 {
 	u32 max_size = ctx->mtu;
 	u32 send_payl_size;
 	u32 hdr_len = 4;
 	u32 hpos;
-	GF_Err e;
+	u8 *lct_buffer;
+
+	//packets are sent by batch on the same socket
+	if (ctx->nb_lct_pending && (ctx->lct_sock != sock))
+		routeout_lct_flush(ctx, GF_TRUE);
+	lct_buffer = ctx->lct_buffer + ctx->nb_lct_pending * ctx->mtu;
 
 	if (total_size) {
 		//TOL extension
@@ -1280,21 +1423,27 @@ u32 routeout_lct_send(GF_ROUTEOutCtx *ctx, GF_Socket *sock, u32 tsi, u32 toi, u3
 	} else {
 		send_payl_size = len - offset;
 	}
-	ctx->lct_buffer[0] = 0x12; //V=b0001, C=b00, PSI=b10
-	ctx->lct_buffer[1] = 0xA0; //S=b1, 0=b01, h=b0, res=b00, A=b0, B=X
+	//with FEC, a source packet never spans two source symbols so that a lost packet erases a single symbol
+	if (ctx->fec) {
+		u32 sym_size = ctx->mtu - ROUTE_FEC_HDR_SIZE;
+		u32 sym_left = sym_size - (offset_in_frame % sym_size);
+		if (send_payl_size > sym_left) send_payl_size = sym_left;
+	}
+	lct_buffer[0] = 0x12; //V=b0001, C=b00, PSI=b10
+	lct_buffer[1] = 0xA0; //S=b1, 0=b01, h=b0, res=b00, A=b0, B=X
 	//set close flag only if total_len is known
 	if (total_size && (offset + send_payl_size == len))
-		ctx->lct_buffer[1] |= 1;
+		lct_buffer[1] |= 1;
 
-	ctx->lct_buffer[2] = hdr_len;
-	ctx->lct_buffer[3] = (u8) codepoint;
+	lct_buffer[2] = hdr_len;
+	lct_buffer[3] = (u8) codepoint;
 	hpos = 4;
 
 #define PUT_U32(_val)\
-	ctx->lct_buffer[hpos] = (_val>>24 & 0xFF);\
-	ctx->lct_buffer[hpos+1] = (_val>>16 & 0xFF);\
-	ctx->lct_buffer[hpos+2] = (_val>>8 & 0xFF);\
-	ctx->lct_buffer[hpos+3] = (_val & 0xFF); \
+	lct_buffer[hpos] = (_val>>24 & 0xFF);\
+	lct_buffer[hpos+1] = (_val>>16 & 0xFF);\
+	lct_buffer[hpos+2] = (_val>>8 & 0xFF);\
+	lct_buffer[hpos+3] = (_val & 0xFF); \
 	hpos+=4;
 
 	//CCI=0
@@ -1305,16 +1454,16 @@ u32 routeout_lct_send(GF_ROUTEOutCtx *ctx, GF_Socket *sock, u32 tsi, u32 toi, u3
 	//total length
 	if (total_size) {
 		if (total_size<=0xFFFFFF) {
-			ctx->lct_buffer[hpos] = GF_LCT_EXT_TOL24;
-			ctx->lct_buffer[hpos+1] = total_size>>16 & 0xFF;
-			ctx->lct_buffer[hpos+2] = total_size>>8 & 0xFF;
-			ctx->lct_buffer[hpos+3] = total_size & 0xFF;
+			lct_buffer[hpos] = GF_LCT_EXT_TOL24;
+			lct_buffer[hpos+1] = total_size>>16 & 0xFF;
+			lct_buffer[hpos+2] = total_size>>8 & 0xFF;
+			lct_buffer[hpos+3] = total_size & 0xFF;
 			hpos+=4;
 		} else {
-			ctx->lct_buffer[hpos] = GF_LCT_EXT_TOL48;
-			ctx->lct_buffer[hpos+1] = 2; //2 x 32 bits for header ext
-			ctx->lct_buffer[hpos+2] = 0;
-			ctx->lct_buffer[hpos+3] = 0;
+			lct_buffer[hpos] = GF_LCT_EXT_TOL48;
+			lct_buffer[hpos+1] = 2; //2 x 32 bits for header ext
+			lct_buffer[hpos+2] = 0;
+			lct_buffer[hpos+3] = 0;
 			hpos+=4;
 			PUT_U32(total_size);
 		}
@@ -1327,17 +1476,142 @@ u32 routeout_lct_send(GF_ROUTEOutCtx *ctx, GF_Socket *sock, u32 tsi, u32 toi, u3
 
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_ROUTE, ("[ROUTE] LCT SID %u TSI %u TOI %u size %u (frag %u total %u) offset %u (%u in obj)\n", service_id, tsi, toi, send_payl_size, len, total_size, offset, offset_in_frame));
 
-	memcpy(ctx->lct_buffer + hpos, payload + offset, send_payl_size);
-	e = gf_sk_send(sock, ctx->lct_buffer, send_payl_size + hpos);
-	if (e) {
-		GF_LOG(GF_LOG_ERROR, GF_LOG_ROUTE, ("[ROUTE] Failed to send LCT object TSI %u TOI %u fragment: %s\n", tsi, toi, gf_error_to_string(e) ));
-	}
+	memcpy(lct_buffer + hpos, payload + offset, send_payl_size);
+	ctx->lct_sock = sock;
+	ctx->lct_pck[ctx->nb_lct_pending] = lct_buffer;
+	ctx->lct_size[ctx->nb_lct_pending] = send_payl_size + hpos;
+	ctx->nb_lct_pending++;
+	if (ctx->nb_lct_pending == ROUTE_SEND_BATCH)
+		routeout_lct_flush(ctx, GF_TRUE);
 	//store what we actually sent including header for rate estimation
 	ctx->bytes_sent += send_payl_size + hpos;
 	//but return what we sent from the source
 	return send_payl_size;
 }
 
+//send one repair symbol of an object, computed from the k source symbols of its source block
+static void routeout_lct_send_repair(GF_ROUTEOutCtx *ctx, GF_Socket *sock, u32 tsi, u32 toi, u32 total_size, u8 **src, u32 k, u32 sbn, u32 esi)
+{
+	u32 hpos, fec_id, sym_size = ctx->mtu - ROUTE_FEC_HDR_SIZE;
+	u32 max_n = ctx->fec_max_k + (ctx->fec_max_k * ctx->fec + 99) / 100;
+	u8 *lct_buffer;
+
+	if (ctx->nb_lct_pending && (ctx->lct_sock != sock))
+		routeout_lct_flush(ctx, GF_TRUE);
+	lct_buffer = ctx->lct_buffer + ctx->nb_lct_pending * ctx->mtu;
+
+	lct_buffer[0] = 0x10; //V=b0001, C=b00, PSI=b00 (repair)
+	lct_buffer[1] = 0xA0; //S=b1, 0=b01, h=b0, res=b00, A=b0, B=b0
+	lct_buffer[2] = 8; //base header and EXT_FTI
+	lct_buffer[3] = 0;
+	hpos = 4;
+	//CCI=0
+	PUT_U32(0);
+	PUT_U32(tsi);
+	PUT_U32(toi);
+
+	//EXT_FTI for Reed-Solomon over GF(2^8): transfer length, m, G, symbol length, max source block length, max encoding symbols
+	lct_buffer[hpos] = GF_LCT_EXT_FTI;
+	lct_buffer[hpos+1] = 4;
+	lct_buffer[hpos+2] = 0;
+	lct_buffer[hpos+3] = 0;
+	hpos+=4;
+	PUT_U32(total_size);
+	lct_buffer[hpos] = 8;
+	lct_buffer[hpos+1] = 1;
+	lct_buffer[hpos+2] = (sym_size>>8) & 0xFF;
+	lct_buffer[hpos+3] = sym_size & 0xFF;
+	hpos+=4;
+	lct_buffer[hpos] = (ctx->fec_max_k>>8) & 0xFF;
+	lct_buffer[hpos+1] = ctx->fec_max_k & 0xFF;
+	lct_buffer[hpos+2] = (max_n>>8) & 0xFF;
+	lct_buffer[hpos+3] = max_n & 0xFF;
+	hpos+=4;
+
+	//FEC payload ID: source block number and encoding symbol ID
+	fec_id = (sbn<<8) | esi;
+	PUT_U32(fec_id);
+	gf_assert(hpos == ROUTE_FEC_HDR_SIZE);
+
+	gf_rs_fec_encode(src, k, esi, lct_buffer + hpos, sym_size);
+
+	ctx->lct_sock = sock;
+	ctx->lct_pck[ctx->nb_lct_pending] = lct_buffer;
+	ctx->lct_size[ctx->nb_lct_pending] = ctx->mtu;
+	ctx->nb_lct_pending++;
+	if (ctx->nb_lct_pending == ROUTE_SEND_BATCH)
+		routeout_lct_flush(ctx, GF_TRUE);
+	ctx->bytes_sent += ctx->mtu;
+	ctx->fec_nb_repair++;
+}
+
+//send repair symbols of an object
+static void routeout_send_object_repair(GF_ROUTEOutCtx *ctx, ROUTEService *serv, ROUTEPid *rpid, u32 toi, u8 *data, u32 obj_size)
+{
+	u8 *src[255];
+	u32 i, j, nb_syms, nb_blocks, a_large, a_small, nb_large, first_sym;
+	u32 sym_size = ctx->mtu - ROUTE_FEC_HDR_SIZE;
+
+	if (!obj_size || !data) return;
+
+	//source block partitioning as in RFC 5052
+	nb_syms = (obj_size + sym_size - 1) / sym_size;
+	nb_blocks = (nb_syms + ctx->fec_max_k - 1) / ctx->fec_max_k;
+	a_large = (nb_syms + nb_blocks - 1) / nb_blocks;
+	a_small = nb_syms / nb_blocks;
+	nb_large = nb_syms - a_small * nb_blocks;
+
+	first_sym = 0;
+	for (i=0; i<nb_blocks; i++) {
+		u32 k = (i<nb_large) ? a_large : a_small;
+		u32 nb_repair = (k * ctx->fec + 99) / 100;
+
+		for (j=0; j<k; j++) {
+			u32 offset = (first_sym + j) * sym_size;
+			//last symbol is zero-padded
+			if (offset + sym_size > obj_size) {
+				memset(ctx->fec_pad, 0, sym_size);
+				memcpy(ctx->fec_pad, data + offset, obj_size - offset);
+				src[j] = ctx->fec_pad;
+			} else {
+				src[j] = data + offset;
+			}
+		}
+		for (j=0; j<nb_repair; j++) {
+			routeout_lct_send_repair(ctx, rpid->rlct->sock, rpid->tsi, toi, obj_size, src, k, i, k+j);
+		}
+		first_sym += k;
+	}
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_ROUTE, ("[ROUTE] Service %d TSI %u TOI %u sent repair symbols for %u source symbols in %u blocks\n", serv->service_id, rpid->tsi, toi, nb_syms, nb_blocks));
+}
+
+//send repair symbols for the current object once its last packet is sent
+static void routeout_send_repair(GF_ROUTEOutCtx *ctx, ROUTEService *serv, ROUTEPid *rpid)
+{
+	u8 *data;
+
+	//object sent in a single packet, use packet data
+	if (!rpid->frag_idx && rpid->full_frame_size) {
+		data = (u8 *) rpid->pck_data;
+	} else {
+		if (rpid->pck_size) {
+			if (rpid->frag_offset + rpid->pck_size > rpid->fec_alloc) {
+				rpid->fec_alloc = rpid->frag_offset + rpid->pck_size;
+				rpid->fec_buf = gf_realloc(rpid->fec_buf, rpid->fec_alloc);
+				if (!rpid->fec_buf) {
+					rpid->fec_alloc = 0;
+					return;
+				}
+			}
+			memcpy(rpid->fec_buf + rpid->frag_offset, rpid->pck_data, rpid->pck_size);
+		}
+		//object not complete
+		if (!rpid->full_frame_size) return;
+		data = rpid->fec_buf;
+	}
+	routeout_send_object_repair(ctx, serv, rpid, rpid->current_toi, data, rpid->full_frame_size);
+}
+
 static GF_Err routeout_service_send_bundle(GF_ROUTEOutCtx *ctx, ROUTEService *serv)
 {
 	u32 offset = 0;
@@ -1748,6 +2022,8 @@ next_packet:
 					}
 					offset += routeout_lct_send(ctx, rpid->rlct->sock, rpid->tsi, ROUTE_INIT_TOI, codepoint, (u8 *) rpid->init_seg_data, rpid->init_seg_size, offset, serv->service_id, rpid->init_seg_size, offset);
 				}
+				if (ctx->fec)
+					routeout_send_object_repair(ctx, serv, rpid, ROUTE_INIT_TOI, rpid->init_seg_data, rpid->init_seg_size);
 				if (ctx->reporting_on) {
 					ctx->total_size += rpid->init_seg_size;
 					ctx->total_bytes = rpid->init_seg_size;
@@ -1800,6 +2076,15 @@ next_packet:
 					}
 				}
 			}
+			//paced channel, wait for send budget
+			if (rpid->rlct->pace_rate) {
+				u32 delay = routeout_pace_delay(ctx, rpid->rlct);
+				if (delay) {
+					if (delay < ctx->reschedule_us)
+						ctx->reschedule_us = delay;
+					break;
+				}
+			}
 			//we use codepoint 8 (media segment, file mode) for media segments, otherwise as listed in S-TSID
 			codepoint = rpid->raw_file ? rpid->fmtp : 8;
 			sent = routeout_lct_send(ctx, rpid->rlct->sock, rpid->tsi, rpid->current_toi, codepoint, (u8 *) rpid->pck_data, rpid->pck_size, rpid->pck_offset, serv->service_id, rpid->full_frame_size, rpid->pck_offset + rpid->frag_offset);
@@ -1812,6 +2097,9 @@ next_packet:
 		assert (rpid->pck_offset <= rpid->pck_size);
 
 		if (rpid->pck_offset == rpid->pck_size) {
+			if (ctx->fec)
+				routeout_send_repair(ctx, serv, rpid);
+
 			//print fragment push info except if single fragment
 			if (rpid->frag_idx || !rpid->full_frame_size) {
 				GF_LOG(GF_LOG_DEBUG, GF_LOG_ROUTE, ("[ROUTE] pushed fragment %s#%d (%d bytes) in "LLU" us - target push "LLU" us\n", rpid->seg_name, rpid->frag_idx+1, rpid->pck_size, ctx->clock - rpid->clock_at_pck, rpid->current_dur_us));
@@ -1861,6 +2149,7 @@ next_packet:
 						if (seg_rate > rpid->bitrate) {
 							GF_LOG(GF_LOG_WARNING, GF_LOG_ROUTE, ("[ROUTE] Segment %s rate "LLU" but stream rate "LLU", updating bitrate\n", rpid->seg_name, seg_rate, rpid->bitrate));
 							rpid->bitrate = (u32) seg_rate;
+							routeout_update_pacing(ctx, serv);
 						}
 					}
 				}
@@ -2093,6 +2382,8 @@ static GF_Err routeout_process(GF_Filter *filter)
 		}
 	}
 
+	routeout_lct_flush(ctx, all_serv_done);
+
 	if (all_serv_done) {
 		return e ? e : GF_EOS;
 	}
@@ -2179,6 +2470,13 @@ static const GF_FilterArgs ROUTEOutArgs[] =
 	{ OFFS(llmode), "use low-latency mode", GF_PROP_BOOL, "false", NULL, GF_ARG_HINT_EXPERT},
 	{ OFFS(brinc), "bitrate increase in percent when estimating timing in low latency mode", GF_PROP_UINT, "10", NULL, GF_ARG_HINT_EXPERT},
 	{ OFFS(noreg), "disable rate regulation for media segments, pushing them as fast as received", GF_PROP_BOOL, "false", NULL, GF_ARG_HINT_EXPERT},
+	{ OFFS(pace), "pace LCT packets of each LCT channel\n"
+	"- no: no pacing\n"
+	"- sw: software pacing\n"
+	"- kernel: software and kernel pacing\n"
+	"- txtime: software pacing and kernel launch time on each packet", GF_PROP_UINT, "no", "no|sw|kernel|txtime", GF_ARG_HINT_EXPERT},
+	{ OFFS(burst), "max burst size in bytes when pacing, 0 means 1 ms of data", GF_PROP_UINT, "0", NULL, GF_ARG_HINT_EXPERT},
+	{ OFFS(fec), "AL-FEC repair overhead in percent of source symbols, 0 disables FEC", GF_PROP_UINT, "0", NULL, GF_ARG_HINT_EXPERT},
 
 	{ OFFS(runfor), "run for the given time in ms", GF_PROP_UINT, "0", NULL, 0},
 	{0}
@@ -2229,6 +2527,14 @@ GF_FilterRegister ROUTEOutRegister = {
 		"- otherwise, the first PID found is assigned TSI 10, the second TSI 20 etc ...\n"
 		"\n"
 		"Init segments and HLS child playlists are sent before each new segment, independently of [-carousel]().\n"
+		"\n"
+		"When [-pace]() is set, each LCT channel is paced at the sum of the bitrates of its streams increased by 20 percent, and media segments are only sent within this budget, which avoids bursts when catching up. "
+		"Kernel pacing modes usually require the `fq` (or `etf`) queuing discipline on the output interface.\n"
+		"\n"
+		"When [-fec]() is set, each init segment, media segment or raw file is protected by Reed-Solomon repair symbols sent after the object on the same TSI, and signaled in the S-TSID `RprFlow`. "
+		"The object is split in source blocks of at most 255 encoding symbols, and [-fec]() percent of repair symbols are added to each block. Any set of received symbols at least as large as the source block allows recovering the block.\n"
+		"The code uses a Cauchy generator matrix and is signaled with the unassigned FEC encoding ID 255, it is not interoperable with RFC 5510 (FEC encoding ID 5) receivers.\n"
+		"EX gpac -i source.mp4 dasher -o route://225.1.1.0:6000/manifest.mpd:fec=20\n"
 		"# ATSC 3.0 mode\n"
 		"In this mode, the filter allows multiple service multiplexing, identified through the `ServiceID` property.\n"
 		"By default, a single multicast IP is used for route sessions, each service will be assigned a different port.\n"
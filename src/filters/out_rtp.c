@@ -38,6 +38,16 @@
 #include "out_rtp.h"
 
 
+enum
+{
+	RTPOUT_PACE_NO = 0,
+	RTPOUT_PACE_SW,
+	RTPOUT_PACE_KERNEL,
+	RTPOUT_PACE_TXTIME,
+};
+//extra rate in percent over average stream bitrate when pacing
+#define RTPOUT_PACE_MARGIN	20
+
 typedef struct
 {
 	//options
@@ -54,6 +64,7 @@ typedef struct
 	char *info, *url, *email;
 	s32 runfor, tso;
 	Bool latm;
+	u32 pace, burst;
 
 	/*timeline origin of our session (all tracks) in microseconds*/
 	u64 sys_clock_at_init;
@@ -742,6 +753,23 @@ static GF_Err rtpout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is
 	e = rtpout_init_streamer(stream,  ctx->ip ? ctx->ip : "127.0.0.1", ctx->xps, ctx->mpeg4, ctx->latm, payt, ctx->mtu, ctx->ttl, ctx->ifce, GF_FALSE, &ctx->base_pid_id, ctx->single_stream, gf_filter_get_netcap_id(filter));
 	if (e) return e;
 
+	if (ctx->pace) {
+		u32 rate = 0, flags = 0;
+		p = gf_filter_pid_get_property(pid, GF_PROP_PID_MAXRATE);
+		if (p) rate = p->value.uint;
+		p = gf_filter_pid_get_property(pid, GF_PROP_PID_BITRATE);
+		if (p && (p->value.uint * (100+RTPOUT_PACE_MARGIN) / 100 > rate))
+			rate = p->value.uint * (100+RTPOUT_PACE_MARGIN) / 100;
+
+		if (!rate) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_RTP, ("[RTPOut] Unknown bitrate for PID %s, pacing disabled\n", gf_filter_pid_get_name(pid) ));
+		} else {
+			if (ctx->pace==RTPOUT_PACE_KERNEL) flags = GF_SK_PACING_KERNEL;
+			else if (ctx->pace==RTPOUT_PACE_TXTIME) flags = GF_SK_PACING_TXTIME;
+			gf_rtp_streamer_set_pacing(stream->rtp, rate, ctx->burst, flags);
+		}
+	}
+
 	stream->selected = GF_TRUE;
 
 	if (ctx->loop) {
@@ -1018,6 +1046,19 @@ GF_Err rtpout_process_rtp(GF_List *streams, GF_RTPOutStream **active_stream, Boo
 	}
 
 	stream = *active_stream;
+
+	/*paced stream, wait until the AU fits in the send budget*/
+	GF_FilterPacket *pck = gf_filter_pid_get_packet(stream->pid);
+	if (pck) {
+		u32 pace_delay;
+		gf_filter_pck_get_data(pck, &pck_size);
+		pace_delay = gf_rtp_streamer_get_pacing_delay(stream->rtp, pck_size);
+		if (pace_delay) {
+			*repost_delay_us = pace_delay;
+			return GF_OK;
+		}
+	}
+
 	clock = gf_sys_clock_high_res();
 	diff = (s64) *active_min_ts_microsec;
 	diff += ((s64) delay) * 1000;
@@ -1039,7 +1080,6 @@ GF_Err rtpout_process_rtp(GF_List *streams, GF_RTPOutStream **active_stream, Boo
 	}
 
 	/*send packets*/
-	GF_FilterPacket *pck = gf_filter_pid_get_packet(stream->pid);
 	pck_data = pck ? gf_filter_pck_get_data(pck, &pck_size) : NULL;
 	if (!pck_size) {
 		gf_filter_pid_drop_packet(stream->pid);
@@ -1239,6 +1279,12 @@ static const GF_FilterArgs RTPOutArgs[] =
 	{ OFFS(tso), "set timestamp offset in microseconds. Negative value means random initial timestamp", GF_PROP_SINT, "-1", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(xps), "force parameter set injection at each SAP. If not set, only inject if different from SDP ones", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(latm), "use latm for AAC payload format", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(pace), "pace RTP packets of each stream\n"
+	"- no: no pacing, all packets of an AU are sent at once\n"
+	"- sw: software pacing of AUs\n"
+	"- kernel: software pacing of AUs and kernel pacing of packets\n"
+	"- txtime: software pacing of AUs and kernel launch time on each packet", GF_PROP_UINT, "no", "no|sw|kernel|txtime", GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(burst), "max burst size in bytes when pacing, 0 means 1 ms of data", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(dst), "URL for direct RTP mode", GF_PROP_NAME, NULL, NULL, 0},
 	{ OFFS(ext), "file extension for direct RTP mode", GF_PROP_STRING, NULL, NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(mime), "set mime type for direct RTP mode", GF_PROP_NAME, NULL, NULL, GF_FS_ARG_HINT_ADVANCED},
@@ -1266,6 +1312,12 @@ GF_FilterRegister RTPOutRegister = {
 	"- determine the earliest packet to send next on each input PID, adding [-delay]() if any\n"
 	"- finally compare the packet mapped timestamp __TS__ to the system clock __SC__. When __TS__ - __SC__ is less than [-tt](), the RTP packets for the source packet are sent\n"
 	"\n"
+	"\n"
+	"When [-pace]() is set, each stream is paced at its maximum bitrate, or its average bitrate increased by 20 percent. "
+	"An AU is only sent once the stream send budget allows it, which avoids sending AUs faster than the stream rate, for example when catching up. "
+	"In `sw` mode, all RTP packets of an AU are still sent at once, so a large AU such as a video key frame results in a burst of packets; "
+	"the `kernel` and `txtime` modes spread the packets of an AU at the stream rate. Kernel pacing modes usually require the `fq` (or `etf`) queuing discipline on the output interface.\n"
+	"\n"
 	"The filter does not check for RTCP timeout and will run until all input PIDs reach end of stream.\n"
 	)
 	.private_size = sizeof(GF_RTPOutCtx),
@@ -43,7 +43,7 @@ typedef enum
 	RTPOUT_STREAM_STOP,
 } RTPOutStreamState;
 
-typedef struct
+typedef struct __rtpout_stream
 {
 	GF_RTPStreamer *rtp;
 	u16 port;
@@ -103,6 +103,13 @@ typedef struct
 
 	u32 rtp_timescale;
 
+	/*RTSP fan-out: destination streams fed by this stream, source stream feeding this stream, and SN offset of this stream*/
+	GF_List *fanout;
+	struct __rtpout_stream *fanout_src;
+	u16 fanout_sn_offset;
+	/*source stream packets are not sent to its own client*/
+	Bool fanout_mute;
+
 	void (*on_rtcp)(void *udta);
 	void *on_rtcp_udta;
 } GF_RTPOutStream;
@@ -97,7 +97,7 @@ typedef struct
 	u32 block_size;
 	Bool close, loop, mpeg4, quit, htun, dynurl;
 	u32 mcast, trp;
-	Bool latm;
+	Bool latm, fanout;
 
 	GF_Filter *filter;
 	GF_Socket *server_sock;
@@ -168,6 +168,13 @@ typedef struct __rtspout_session
 
 	u32 last_active_time;
 	char *setup_ctrl;
+
+	/*source session feeding this session in fan-out mode*/
+	struct __rtspout_session *fanout_src;
+	/*number of sessions fed by this session, and set if the client of this session is gone*/
+	u32 nb_fanout;
+	Bool fanout_headless;
+	GF_Err fanout_err;
 } GF_RTSPOutSession;
 
 static GF_Err rtspout_process_setup(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess, char *ctrl);
@@ -256,6 +263,25 @@ static GF_Err rtspout_send_sdp(GF_RTSPOutSession *sess)
 
 static void rtspout_del_stream(GF_RTPOutStream *st)
 {
+	//fan-out destination, pid belongs to source session
+	if (st->fanout_src) {
+		gf_list_del_item(st->fanout_src->fanout, st);
+		st->fanout_src = NULL;
+		st->pid = NULL;
+	}
+	if (st->fanout) {
+		while (gf_list_count(st->fanout)) {
+			GF_RTPOutStream *dst = gf_list_pop_back(st->fanout);
+			GF_RTSPOutSession *dst_sess = dst->on_rtcp_udta;
+			dst->fanout_src = NULL;
+			dst->pid = NULL;
+			dst->state = RTPOUT_STREAM_STOP;
+			//source is gone, destination session will be closed
+			if (dst_sess) dst_sess->fanout_err = GF_IP_CONNECTION_CLOSED;
+		}
+		gf_list_del(st->fanout);
+		st->fanout = NULL;
+	}
 	if (st->pid) {
 		GF_FilterEvent fevt;
 		gf_filter_pid_set_discard(st->pid, GF_TRUE);
@@ -267,14 +293,61 @@ static void rtspout_del_stream(GF_RTPOutStream *st)
 }
 
 
+static void rtspout_send_event(GF_RTSPOutSession *sess, Bool send_stop, Bool send_play, Double start_range);
+
+static void rtspout_set_mute(GF_RTSPOutSession *sess, Bool mute)
+{
+	u32 i, count = gf_list_count(sess->streams);
+	for (i=0; i<count; i++) {
+		GF_RTPOutStream *stream = gf_list_get(sess->streams, i);
+		stream->fanout_mute = mute;
+	}
+}
+
+static void rtspout_fanout_detach(GF_RTSPOutSession *sess)
+{
+	GF_RTSPOutSession *src = sess->fanout_src;
+	sess->fanout_src = NULL;
+	if (!src || !src->nb_fanout) return;
+	src->nb_fanout--;
+	if (src->nb_fanout) return;
+	if (!src->fanout_headless) {
+		GF_RTPOutStream *st = gf_list_get(src->streams, 0);
+		//source client paused while shared, pause source
+		if (st && st->fanout_mute) {
+			rtspout_set_mute(src, GF_FALSE);
+			src->play_state = 2;
+			src->pause_sys_clock = gf_sys_clock_high_res();
+		}
+		return;
+	}
+
+	//last destination gone and source client gone, stop source and setup small timeout as done for teardown
+	GF_LOG(GF_LOG_INFO, GF_LOG_RTP, ("[RTSPOut] Session %s: no more fan-out sessions, stopping\n", src->service_name));
+	src->fanout_headless = GF_FALSE;
+	src->play_state = 0;
+	rtspout_set_mute(src, GF_FALSE);
+	rtspout_send_event(src, GF_TRUE, GF_FALSE, 0);
+	src->last_active_time = gf_sys_clock() - src->ctx->ms_timeout + 2000;
+}
+
 static void rtspout_del_session(GF_Filter *filter, GF_RTSPOutSession *sess)
 {
+	if (sess->nb_fanout) {
+		u32 i, count = gf_list_count(sess->ctx->sessions);
+		for (i=0; i<count; i++) {
+			GF_RTSPOutSession *a_sess = gf_list_get(sess->ctx->sessions, i);
+			if (a_sess->fanout_src == sess) a_sess->fanout_src = NULL;
+		}
+		sess->nb_fanout = 0;
+	}
 	//server mode, cleanup
 	while (gf_list_count(sess->streams)) {
 		GF_RTPOutStream *stream = gf_list_pop_back(sess->streams);
 		rtspout_del_stream(stream);
 	}
 	gf_list_del(sess->streams);
+	rtspout_fanout_detach(sess);
 
 	if (sess->service_name)
 		gf_free(sess->service_name);
@@ -330,6 +403,42 @@ static void rtspout_on_rtcp(void *udta)
 {
 	GF_RTSPOutSession *sess = (GF_RTSPOutSession *) udta;
 	sess->last_active_time = gf_sys_clock();
+	//keep source alive as long as one of its destinations is
+	if (sess->fanout_src)
+		sess->fanout_src->last_active_time = sess->last_active_time;
+}
+
+static void rtspout_fanout_rtcp(void *cbk, u32 ssrc, u32 rtt_ms, u64 jitter_rtp_ts, u32 loss_rate)
+{
+	GF_RTPOutStream *stream = (GF_RTPOutStream *)cbk;
+	if (stream->on_rtcp)
+		stream->on_rtcp(stream->on_rtcp_udta);
+}
+
+/*packets of a source stream in fan-out mode, sent to the source client and to all destination streams playing with their own SSRC and SN*/
+static void rtspout_on_rtp_packet(void *udta, GF_RTPHeader *hdr, u8 *payload, u32 size)
+{
+	u32 i, count;
+	GF_RTPOutStream *stream = (GF_RTPOutStream *)udta;
+	u16 sn = hdr->SequenceNumber;
+
+	if (!stream->fanout_mute)
+		gf_rtp_streamer_send_packet(stream->rtp, hdr, payload, size);
+
+	count = gf_list_count(stream->fanout);
+	for (i=0; i<count; i++) {
+		GF_Err e;
+		GF_RTPOutStream *dst = gf_list_get(stream->fanout, i);
+		if (dst->state != RTPOUT_STREAM_PLAY) continue;
+		hdr->SequenceNumber = sn + dst->fanout_sn_offset;
+		e = gf_rtp_streamer_send_packet(dst->rtp, hdr, payload, size);
+		if (e) {
+			GF_RTSPOutSession *dst_sess = dst->on_rtcp_udta;
+			dst->state = RTPOUT_STREAM_STOP;
+			if (dst_sess) dst_sess->fanout_err = e;
+		}
+	}
+	hdr->SequenceNumber = sn;
 }
 
 static GF_Err rtspout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remove)
@@ -796,13 +905,44 @@ static GF_Err rtspout_process_rtp(GF_Filter *filter, GF_RTSPOutCtx *ctx, GF_RTSP
 			ctx->next_wake_us = 100;
 			return GF_OK;
 		} else if (e) {
-			return e;
+			if (!sess->nb_fanout || ((e!=GF_IP_CONNECTION_CLOSED) && (e!=GF_IP_CONNECTION_FAILURE)))
+				return e;
+			//shared source, keep running for other sessions
+			gf_rtsp_session_del(sess->rtsp);
+			sess->rtsp = NULL;
+			rtspout_set_mute(sess, GF_TRUE);
+			sess->fanout_headless = GF_TRUE;
 		}
 	}
 
 	e = rtpout_process_rtp(sess->streams, &sess->active_stream, sess->loop, ctx->delay, &sess->active_stream_idx, sess->sys_clock_at_init, &sess->active_min_ts_microsec, sess->microsec_ts_init, &sess->wait_for_loop, &repost_delay_us, &sess->first_RTCP_sent, sess->base_pid_id);
 
+	//forward end of stream to shared sessions
+	if (sess->nb_fanout) {
+		u32 i, count = gf_list_count(sess->streams);
+		for (i=0; i<count; i++) {
+			u32 j, nb_dst;
+			GF_RTPOutStream *stream = gf_list_get(sess->streams, i);
+			if (!stream->bye_sent) continue;
+			nb_dst = gf_list_count(stream->fanout);
+			for (j=0; j<nb_dst; j++) {
+				GF_RTPOutStream *dst = gf_list_get(stream->fanout, j);
+				if (dst->bye_sent || (dst->state != RTPOUT_STREAM_PLAY)) continue;
+				gf_rtp_streamer_send_bye(dst->rtp);
+				dst->bye_sent = GF_TRUE;
+			}
+		}
+	}
+
 	if (e) {
+		if (sess->nb_fanout && ((e==GF_IP_CONNECTION_CLOSED) || (e==GF_IP_CONNECTION_FAILURE))) {
+			//shared source, keep running for other sessions
+			if (sess->rtsp) gf_rtsp_session_del(sess->rtsp);
+			sess->rtsp = NULL;
+			rtspout_set_mute(sess, GF_TRUE);
+			sess->fanout_headless = GF_TRUE;
+			return GF_OK;
+		}
 		if ((e==GF_IP_CONNECTION_CLOSED) || (e==GF_IP_CONNECTION_FAILURE)) {
 			sess->play_state = 0;
 			rtspout_send_event(sess, GF_TRUE, GF_FALSE, 0);
@@ -817,6 +957,30 @@ static GF_Err rtspout_process_rtp(GF_Filter *filter, GF_RTSPOutCtx *ctx, GF_RTSP
 	return GF_OK;
 }
 
+static GF_Err rtspout_process_fanout(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess)
+{
+	u32 i, count;
+	if (sess->fanout_err) return sess->fanout_err;
+	if (sess->play_state!=1) return GF_OK;
+
+	if (sess->rtsp && sess->interleave) {
+		GF_Err e = gf_rtsp_check_connection(sess->rtsp);
+		if (e==GF_IP_NETWORK_EMPTY) {
+			ctx->next_wake_us = 100;
+		} else if (e) {
+			return e;
+		}
+	}
+	//packets are pushed by the source session, we only process RTCP
+	count = gf_list_count(sess->streams);
+	for (i=0; i<count; i++) {
+		GF_RTPOutStream *stream = gf_list_get(sess->streams, i);
+		if (stream->state != RTPOUT_STREAM_PLAY) continue;
+		gf_rtp_streamer_read_rtcp(stream->rtp, rtspout_fanout_rtcp, stream);
+	}
+	return GF_OK;
+}
+
 static GF_Err rtspout_interleave_packet(void *cbk1, void *cbk2, Bool is_rtcp, u8 *pck, u32 pck_size)
 {
 	GF_RTSPOutSession *sess = (GF_RTSPOutSession *)cbk1;
@@ -960,6 +1124,100 @@ static GF_RTSPOutSession *rtspout_locate_mcast(GF_RTSPOutCtx *ctx, char *res_pat
 	return NULL;
 }
 
+static GF_RTSPOutSession *rtspout_locate_fanout(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess, char *res_path)
+{
+	u32 i, count = gf_list_count(ctx->sessions);
+	for (i=0; i<count; i++) {
+		char *a_sess_path=NULL;
+		GF_RTSPOutSession *a_sess = gf_list_get(ctx->sessions, i);
+		if (a_sess == sess) continue;
+		//only unicast sessions owning their sources and currently playing can be shared
+		if (a_sess->fanout_src || a_sess->single_session || a_sess->multicast_ip || a_sess->mcast_mirror) continue;
+		if ((a_sess->sdp_state != SDP_LOADED) || (a_sess->play_state != 1)) continue;
+		if (!a_sess->service_name) continue;
+
+		a_sess_path = strstr(a_sess->service_name, "://");
+		if (a_sess_path) a_sess_path = strchr(a_sess_path+3, '/');
+		if (a_sess_path) a_sess_path++;
+		if (a_sess_path && !strcmp(a_sess_path, res_path))
+			return a_sess;
+	}
+	return NULL;
+}
+
+static GF_Err rtspout_setup_fanout(GF_Filter *filter, GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess, GF_RTSPOutSession *src)
+{
+	u32 i, count = gf_list_count(src->streams);
+	for (i=0; i<count; i++) {
+		GF_Err e;
+		GF_RTPOutStream *stream;
+		GF_RTPOutStream *src_st = gf_list_get(src->streams, i);
+
+		GF_SAFEALLOC(stream, GF_RTPOutStream);
+		if (!stream) return GF_OUT_OF_MEM;
+		gf_list_add(sess->streams, stream);
+		//we use the source pid for SDP generation, but never send events on it nor fetch packets from it
+		stream->pid = src_st->pid;
+		stream->streamtype = src_st->streamtype;
+		stream->min_dts = GF_FILTER_NO_TS;
+		stream->on_rtcp = rtspout_on_rtcp;
+		stream->on_rtcp_udta = sess;
+		stream->ctrl_id = src_st->ctrl_id;
+		stream->ctrl_name = sess->ctrl_name;
+
+		e = rtpout_init_streamer(stream, ctx->ifce ? ctx->ifce : "127.0.0.1", ctx->xps, ctx->mpeg4, ctx->latm, gf_rtp_streamer_get_payload_type(src_st->rtp), ctx->mtu, ctx->ttl, ctx->ifce, GF_TRUE, &sess->base_pid_id, 0, gf_filter_get_netcap_id(filter));
+		if (e) return e;
+
+		stream->fanout_src = src_st;
+		if (!src_st->fanout) {
+			src_st->fanout = gf_list_new();
+			gf_rtp_streamer_set_packet_callback(src_st->rtp, rtspout_on_rtp_packet, src_st);
+		}
+		gf_list_add(src_st->fanout, stream);
+	}
+	sess->next_stream_id = src->next_stream_id;
+	sess->fanout_src = src;
+	src->nb_fanout++;
+	sess->sdp_state = SDP_LOADED;
+	GF_LOG(GF_LOG_INFO, GF_LOG_RTP, ("[RTSPOut] Session %s: sharing source with session from %s (%d sessions)\n", src->service_name, src->peer_address, src->nb_fanout+1));
+	return GF_OK;
+}
+
+static void rtspout_play_fanout(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess)
+{
+	u32 i, count = gf_list_count(sess->streams);
+
+	gf_rtsp_response_reset(sess->response);
+	sess->response->ResponseCode = NC_RTSP_OK;
+	sess->response->CSeq = sess->command->CSeq;
+	for (i=0; i<count; i++) {
+		GF_RTPInfo *rtpi;
+		GF_RTPOutStream *stream = gf_list_get(sess->streams, i);
+		GF_RTPOutStream *src_st = stream->fanout_src;
+		if (!stream->selected || !src_st) continue;
+
+		//SN continues from our own packetizer initial SN, and is kept across pause/resume
+		if (stream->state == RTPOUT_STREAM_NOT_ACTIVE)
+			stream->fanout_sn_offset = gf_rtp_streamer_get_next_rtp_sn(stream->rtp) - gf_rtp_streamer_get_next_rtp_sn(src_st->rtp);
+		stream->state = RTPOUT_STREAM_PLAY;
+
+		GF_SAFEALLOC(rtpi, GF_RTPInfo);
+		if (rtpi) {
+			u32 timescale;
+			rtpi->url = gf_malloc(sizeof(char) * (strlen(sess->service_name)+50));
+			sprintf(rtpi->url, "%s/%s=%d", sess->service_name, sess->ctrl_name, stream->ctrl_id);
+			rtpi->seq = (u16) (gf_rtp_streamer_get_next_rtp_sn(src_st->rtp) + stream->fanout_sn_offset);
+			rtpi->rtp_time = (u32) (src_st->current_cts + src_st->ts_offset + src_st->rtp_ts_offset);
+			timescale = gf_rtp_streamer_get_timescale(src_st->rtp);
+			if (timescale)
+				rtpi->rtp_time = (u32) gf_timestamp_rescale(rtpi->rtp_time, src_st->timescale, timescale);
+			gf_list_add(sess->response->RTP_Infos, rtpi);
+		}
+	}
+	sess->play_state = 1;
+	rtspout_send_response(ctx, sess);
+}
+
 static char *rtspout_get_local_res_path(GF_RTSPOutCtx *ctx, char *res_path, GF_RTSPCommand *com, u32 *err_code, u32 *mcast_mode)
 {
 	u32 i, count, di_len;
@@ -1304,6 +1562,8 @@ static GF_Err rtspout_process_session_signaling(GF_Filter *filter, GF_RTSPOutCtx
 			Bool swap_sess = GF_FALSE;
 			GF_RTSPOutSession *a_sess = gf_list_get(ctx->sessions, i);
 			if (a_sess->rtsp) continue;
+			//headless fanout sessions only hold the shared RTP streams and cannot be restored
+			if (a_sess->fanout_headless) continue;
 
 			if (a_sess->sessionID && sess->command->Session && !strcmp(a_sess->sessionID, sess->command->Session) ) {
 				swap_sess = GF_TRUE;
@@ -1433,6 +1693,32 @@ static GF_Err rtspout_process_session_signaling(GF_Filter *filter, GF_RTSPOutCtx
 				}
 				return GF_OK;
 			}
+			//check if we have a running unicast session for this resource we can share
+			if (ctx->fanout && !is_setup && !sess->service_name && (mcast_mode!=MCAST_AUTHENTICATE_SETUP)) {
+				a_sess = rtspout_locate_fanout(ctx, sess, res_path);
+				//check access rights, dynamic services are only shared if enabled for all users
+				if (a_sess && ((res_path[0] == '?') || (res_path[0] == '@'))) {
+					if (!ctx->dynurl) a_sess = NULL;
+				} else if (a_sess) {
+					u32 fo_code=NC_RTSP_OK, fo_mcast_mode=MCAST_OFF;
+					char *src_url = rtspout_get_local_res_path(ctx, res_path, sess->command, &fo_code, &fo_mcast_mode);
+					if (src_url) gf_free(src_url);
+					if (fo_code != NC_RTSP_OK) a_sess = NULL;
+				}
+				if (a_sess) {
+					sess->service_name = gf_strdup(sess->command->service_name);
+					e = rtspout_setup_fanout(filter, ctx, sess, a_sess);
+					if (e) {
+						gf_rtsp_response_reset(sess->response);
+						sess->response->ResponseCode = NC_RTSP_Internal_Server_Error;
+						sess->response->CSeq = sess->command->CSeq;
+						rtspout_send_response(ctx, sess);
+						return GF_OK;
+					}
+					rtspout_send_sdp(sess);
+					return GF_OK;
+				}
+			}
 		}
 
 		if (!res_path) {
@@ -1613,6 +1899,17 @@ static GF_Err rtspout_process_session_signaling(GF_Filter *filter, GF_RTSPOutCtx
 			sess->response->CSeq = sess->command->CSeq;
 			rtspout_send_response(ctx, sess);
 			return GF_OK;
+		} else if (sess->fanout_src) {
+			//shared source, join at current position
+			rtspout_play_fanout(ctx, sess);
+		} else if (sess->nb_fanout && (sess->play_state==1)) {
+			//source is shared and cannot be seeked, resume sending to our client
+			rtspout_set_mute(sess, GF_FALSE);
+			sess->fanout_headless = GF_FALSE;
+			gf_rtsp_response_reset(sess->response);
+			sess->response->ResponseCode = NC_RTSP_OK;
+			sess->response->CSeq = sess->command->CSeq;
+			rtspout_send_response(ctx, sess);
 		} else {
 			//loop enabled, only if multicast session or single session mode
 			if (ctx->loop && !sess->loop_disabled && (sess->single_session || sess->multicast_ip))
@@ -1642,7 +1939,19 @@ static GF_Err rtspout_process_session_signaling(GF_Filter *filter, GF_RTSPOutCtx
 
 	//process pause (we don't implement range on pause yet)
 	if (!strcmp(sess->command->method, GF_RTSP_PAUSE)) {
-		if (sess->play_state!=2) {
+		if (sess->fanout_src) {
+			u32 i, count = gf_list_count(sess->streams);
+			for (i=0; i<count; i++) {
+				GF_RTPOutStream *stream = gf_list_get(sess->streams, i);
+				if (stream->state==RTPOUT_STREAM_PLAY) stream->state = RTPOUT_STREAM_STOP;
+			}
+			sess->play_state = 2;
+		}
+		//shared source, only stop sending to our client
+		else if (sess->nb_fanout) {
+			rtspout_set_mute(sess, GF_TRUE);
+		}
+		else if (sess->play_state!=2) {
 			sess->play_state = 2;
 			sess->pause_sys_clock = gf_sys_clock_high_res();
 		}
@@ -1654,6 +1963,29 @@ static GF_Err rtspout_process_session_signaling(GF_Filter *filter, GF_RTSPOutCtx
 	}
 	//process teardown
 	if (!strcmp(sess->command->method, GF_RTSP_TEARDOWN)) {
+		if (sess->fanout_src || sess->nb_fanout) {
+			gf_rtsp_response_reset(sess->response);
+			sess->response->ResponseCode = NC_RTSP_OK;
+			sess->response->CSeq = sess->command->CSeq;
+			rtspout_send_response(ctx, sess);
+			if (sess->fanout_src) {
+				rtspout_del_session(filter, sess);
+				*sess_ptr = NULL;
+				return GF_OK;
+			}
+			//shared source, keep running for other sessions and stop once they are all gone
+			rtspout_set_mute(sess, GF_TRUE);
+			sess->fanout_headless = GF_TRUE;
+			if (sess->sessionID) {
+				gf_free(sess->sessionID);
+				sess->sessionID = NULL;
+			}
+			if (sess->rtsp) {
+				gf_rtsp_session_del(sess->rtsp);
+				sess->rtsp = NULL;
+			}
+			return GF_OK;
+		}
 		sess->play_state = 0;
 		rtspout_send_event(sess, GF_TRUE, GF_FALSE, 0);
 
@@ -1750,7 +2082,16 @@ static GF_Err rtspout_process(GF_Filter *filter)
 		if (sess_err) e |= sess_err;
 		if (!sess) break;
 
-		if (sess->play_state==1) {
+		if (sess->fanout_src || sess->fanout_err) {
+			sess_err = rtspout_process_fanout(ctx, sess);
+			if (sess_err) {
+				GF_LOG(GF_LOG_INFO, GF_LOG_RTP, ("[RTSP] Closing shared session %s: %s\n", sess->service_name, gf_error_to_string(sess_err) ));
+				rtspout_del_session(filter, sess);
+				rtspout_check_last_sess(ctx);
+				break;
+			}
+		}
+		else if (sess->play_state==1) {
 			sess_err = rtspout_process_rtp(filter, ctx, sess);
 			if (sess_err) e |= sess_err;
 		}
@@ -1840,6 +2181,7 @@ static const GF_FilterArgs RTSPOutArgs[] =
 				"- on: clients can create multicast sessions\n"
 				"- mirror: clients can create a multicast session. Any later request to the same URL will use that multicast session"
 		, GF_PROP_UINT, "off", "off|on|mirror", GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(fanout), "in server mode, share source and RTP packetization of a playing unicast session with later sessions requesting the same resource", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(quit), "exit server once first session is over (for test purposes)", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(htun), "enable RTSP over HTTP tunnel", GF_PROP_BOOL, "true", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(trp), "transport mode\n"
@@ -1910,6 +2252,12 @@ GF_FilterRegister RTSPOutRegister = {
 		"\n"
 		"In server mode, multicast can be enabled per read directory using the `mcast` access rule of the directory configuration - see `gpac -h creds`.\n"
 		"\n"
+		"# Fan-out\n"
+		"In server mode, when [-fanout]() is set, a DESCRIBE on a resource currently played by a unicast session will reuse the source and RTP packetization of that session instead of loading the resource again.\n"
+		"Each shared session uses its own transport, SSRC and RTP sequence numbers, and joins the stream at its current position: seeking is not possible and the source cannot be paused while shared.\n"
+		"This is typically used to serve live sources to many clients:\n"
+		"EX gpac rtspout:mounts=mydir:fanout\n"
+		"\n"
 		"# HTTP Tunnel\n"
 		"The server mode supports handling RTSP over HTTP tunnel by default. This can be disabled using [-htun]().\n"
 		"The tunnel conforms to QT specification, and only HTTP 1.0 and 1.1 tunnels are supported.\n"
@@ -39,14 +39,25 @@ typedef struct
 	Bool pck_pending;
 } GF_SockOutClient;
 
+//max number of UDP datagrams sent at once
+#define SOCKOUT_BATCH	32
+
+enum
+{
+	SOCKOUT_PACE_SW = 0,
+	SOCKOUT_PACE_KERNEL,
+	SOCKOUT_PACE_TXTIME,
+};
+
 typedef struct
 {
 	//options
 	Double start, speed;
 	char *dst, *mime, *ext, *ifce;
 	Bool listen;
-	u32 maxc, port, sockbuf, ka, kp, rate, ttl;
+	u32 maxc, port, sockbuf, ka, kp, rate, ttl, burst, pace;
 	GF_Fraction pckr, pckd;
+	Bool cbr;
 
 	GF_Socket *socket;
 	//only one output pid
@@ -65,10 +76,19 @@ typedef struct
 	u32 nb_pck_processed;
 	u64 start_time;
 	u64 nb_bytes_sent;
+	//rate used for socket pacing in client mode
+	u32 pace_rate;
 
 	GF_FilterPacket *rev_pck;
 	u32 next_pckd_idx, next_pckr_idx;
 	u32 nb_pckd_wnd, nb_pckr_wnd;
+
+	//pending datagrams for batch send
+	Bool is_udp;
+	GF_FilterPacket *batch_pck[SOCKOUT_BATCH];
+	const u8 *batch_data[SOCKOUT_BATCH];
+	u32 batch_size[SOCKOUT_BATCH];
+	u32 nb_batch;
 } GF_SockOutCtx;
 
 
@@ -92,6 +112,22 @@ static GF_Err sockout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool i
 	}
 	ctx->pid = pid;
 
+	//pace the socket in client mode, server mode regulates the average rate over all clients
+	if (ctx->socket && !ctx->listen) {
+		u32 rate = ctx->rate;
+		if (!rate && ctx->cbr) {
+			p = gf_filter_pid_get_property(pid, GF_PROP_PID_BITRATE);
+			if (p) rate = p->value.uint;
+		}
+		if (rate != ctx->pace_rate) {
+			u32 flags = 0;
+			if (ctx->pace==SOCKOUT_PACE_KERNEL) flags = GF_SK_PACING_KERNEL;
+			else if (ctx->pace==SOCKOUT_PACE_TXTIME) flags = GF_SK_PACING_TXTIME;
+			gf_sk_set_pacing(ctx->socket, rate, ctx->burst, flags);
+			ctx->pace_rate = rate;
+		}
+	}
+
 	p = gf_filter_pid_get_property(pid, GF_PROP_PID_DISABLE_PROGRESSIVE);
 	if (p && p->value.uint) {
 		GF_LOG(GF_LOG_ERROR, GF_LOG_NETWORK, ("[SockOut] Block patching is not supported by socket output\n"));
@@ -168,12 +204,14 @@ static GF_Err sockout_initialize(GF_Filter *filter)
 	if (!strnicmp(ctx->dst, "udp://", 6)) {
 		sock_type = GF_SOCK_TYPE_UDP;
 		ctx->listen = GF_FALSE;
+		ctx->is_udp = GF_TRUE;
 	} else if (!strnicmp(ctx->dst, "tcp://", 6)) {
 		sock_type = GF_SOCK_TYPE_TCP;
 #ifdef GPAC_HAS_SOCK_UN
 	} else if (!strnicmp(ctx->dst, "udpu://", 7)) {
 		sock_type = GF_SOCK_TYPE_UDP_UN;
 		ctx->listen = GF_FALSE;
+		ctx->is_udp = GF_TRUE;
 	} else if (!strnicmp(ctx->dst, "tcpu://", 7)) {
 		sock_type = GF_SOCK_TYPE_TCP_UN;
 #endif
@@ -239,7 +277,10 @@ static GF_Err sockout_initialize(GF_Filter *filter)
 
 static void sockout_finalize(GF_Filter *filter)
 {
+	u32 i;
 	GF_SockOutCtx *ctx = (GF_SockOutCtx *) gf_filter_get_udta(filter);
+	for (i=0; i<ctx->nb_batch; i++)
+		gf_filter_pck_unref(ctx->batch_pck[i]);
 	if (ctx->clients) {
 		while (gf_list_count(ctx->clients)) {
 			GF_SockOutClient *sc = gf_list_pop_back(ctx->clients);
@@ -322,6 +363,81 @@ static GF_Err sockout_send_packet(GF_SockOutCtx *ctx, GF_FilterPacket *pck, GF_S
 	return GF_OK;
 }
 
+//send queued datagrams in one call, refilling the queue from the input first
+static GF_Err sockout_send_batch(GF_Filter *filter, GF_SockOutCtx *ctx)
+{
+	u32 i, nb_sent=0, queued=0, delay=0;
+	GF_Err e;
+
+	//socket closed, discard queued datagrams
+	if (!ctx->socket) {
+		for (i=0; i<ctx->nb_batch; i++)
+			gf_filter_pck_unref(ctx->batch_pck[i]);
+		ctx->nb_batch = 0;
+		return GF_EOS;
+	}
+
+	for (i=0; i<ctx->nb_batch; i++)
+		queued += ctx->batch_size[i];
+
+	//only queue packets with data
+	while (ctx->nb_batch < SOCKOUT_BATCH) {
+		u32 size;
+		const u8 *data;
+		GF_FilterPacket *pck = gf_filter_pid_get_packet(ctx->pid);
+		if (!pck) break;
+		data = gf_filter_pck_get_data(pck, &size);
+		if (!data) break;
+		//with pacing, stop once the bucket is used
+		if (ctx->pace_rate) {
+			delay = gf_sk_pacing_delay(ctx->socket, queued + size);
+			if (delay) break;
+		}
+
+		gf_filter_pck_ref(&pck);
+		gf_filter_pid_drop_packet(ctx->pid);
+		ctx->batch_pck[ctx->nb_batch] = pck;
+		ctx->batch_data[ctx->nb_batch] = data;
+		ctx->batch_size[ctx->nb_batch] = size;
+		ctx->nb_batch++;
+		queued += size;
+	}
+	if (!ctx->nb_batch) {
+		if (delay) gf_filter_ask_rt_reschedule(filter, delay);
+		return GF_OK;
+	}
+
+	e = gf_sk_send_batch(ctx->socket, ctx->batch_data, ctx->batch_size, ctx->nb_batch, &nb_sent);
+	if (e && (e!=GF_BUFFER_TOO_SMALL) && (e!=GF_IP_NETWORK_EMPTY)) {
+		if (e==GF_IP_CONNECTION_CLOSED) {
+			GF_FilterEvent evt;
+			GF_FEVT_INIT(evt, GF_FEVT_STOP, ctx->pid);
+			gf_filter_pid_send_event(ctx->pid, &evt);
+			gf_sk_del(ctx->socket);
+			ctx->socket = NULL;
+		} else {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_NETWORK, ("[SockOut] Write error: %s\n", gf_error_to_string(e) ));
+		}
+		//drop the failed datagram, as done for single sends
+		if (nb_sent < ctx->nb_batch) nb_sent++;
+	}
+	for (i=0; i<nb_sent; i++) {
+		ctx->nb_bytes_sent += ctx->batch_size[i];
+		ctx->nb_pck_processed++;
+		gf_filter_pck_unref(ctx->batch_pck[i]);
+	}
+	//keep unsent datagrams for next call
+	ctx->nb_batch -= nb_sent;
+	for (i=0; i<ctx->nb_batch; i++) {
+		ctx->batch_pck[i] = ctx->batch_pck[i+nb_sent];
+		ctx->batch_data[i] = ctx->batch_data[i+nb_sent];
+		ctx->batch_size[i] = ctx->batch_size[i+nb_sent];
+	}
+	if (ctx->nb_batch) gf_filter_ask_rt_reschedule(filter, 1000);
+	else if (delay) gf_filter_ask_rt_reschedule(filter, delay);
+	return GF_OK;
+}
+
 static GF_Err sockout_process(GF_Filter *filter)
 {
 	GF_Err e;
@@ -333,11 +449,12 @@ static GF_Err sockout_process(GF_Filter *filter)
 	if (!ctx->socket)
 		return GF_EOS;
 
-	if (ctx->rate) {
+	if (ctx->rate || ctx->pace_rate) {
 		if (!ctx->start_time) ctx->start_time = gf_sys_clock_high_res();
 		else {
 			u64 now = gf_sys_clock_high_res() - ctx->start_time;
-			if (ctx->nb_bytes_sent*8*1000000 > ctx->rate * now) {
+			//in server mode, regulate the average send rate
+			if (ctx->listen && (ctx->nb_bytes_sent*8*1000000 > ctx->rate * now)) {
 				u64 diff = ctx->nb_bytes_sent*8*1000000 / ctx->rate - now;
 				gf_filter_ask_rt_reschedule(filter, (u32) MAX(diff, 1000) );
 				return GF_OK;
@@ -384,6 +501,10 @@ static GF_Err sockout_process(GF_Filter *filter)
 		return GF_OK;
 	}
 
+	//datagrams not sent yet
+	if (ctx->nb_batch)
+		return sockout_send_batch(filter, ctx);
+
 	pck = gf_filter_pid_get_packet(ctx->pid);
 	if (!pck) {
 		if (gf_filter_pid_is_eos(ctx->pid) && !gf_filter_pid_is_flush_eos(ctx->pid) ) {
@@ -501,6 +622,22 @@ static GF_Err sockout_process(GF_Filter *filter)
 			gf_filter_ask_rt_reschedule(filter, 1000);
 			return GF_OK;
 		}
+		//UDP, send several datagrams at once unless we modify the packet sequence
+		if (ctx->is_udp && !is_pck_ref && !ctx->rev_pck && !ctx->pckr.den && !ctx->pckd.den) {
+			u32 size;
+			if (gf_filter_pck_get_data(pck, &size))
+				return sockout_send_batch(filter, ctx);
+		}
+		if (ctx->pace_rate) {
+			u32 size, delay;
+			gf_filter_pck_get_data(pck, &size);
+			delay = gf_sk_pacing_delay(ctx->socket, size);
+			if (delay) {
+				gf_filter_ask_rt_reschedule(filter, delay);
+				return GF_OK;
+			}
+		}
+
 		e = sockout_send_packet(ctx, pck, ctx->socket);
 		if (e == GF_BUFFER_TOO_SMALL) return GF_OK;
 		if (e==GF_IP_CONNECTION_CLOSED) {
@@ -560,6 +697,12 @@ static const GF_FilterArgs SockOutArgs[] =
 	{ OFFS(start), "set playback start offset. A negative value means percent of media duration with -1 equal to duration", GF_PROP_DOUBLE, "0.0", NULL, 0},
 	{ OFFS(speed), "set playback speed. If negative and start is 0, start is set to -1", GF_PROP_DOUBLE, "1.0", NULL, 0},
 	{ OFFS(rate), "set send rate in bps, disabled by default (as fast as possible)", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(cbr), "if [-rate]() is not set, use input bitrate as send rate (typically the rate of a CBR TS multiplex)", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(burst), "max burst size in bytes when pacing output, 0 means 1 ms of data", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(pace), "pacing mode when send rate is set in client mode\n"
+	"- sw: software pacing only\n"
+	"- kernel: also set kernel pacing rate on the socket\n"
+	"- txtime: also set kernel launch time on each datagram", GF_PROP_UINT, "sw", "sw|kernel|txtime", GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(pckr), "reverse packet every N", GF_PROP_FRACTION, "0/0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(pckd), "drop packet every N", GF_PROP_FRACTION, "0/0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(ttl), "multicast TTL", GF_PROP_UINT, "0", "0-127", GF_FS_ARG_HINT_EXPERT},
@@ -605,6 +748,12 @@ GF_FilterRegister SockOutRegister = {
 		"This drops every 4th packet of each 10 packet window.\n"
 		"EX :pckr=0/100\n"
 		"This reverts the send order of one random packet in each 100 packet window.\n"
+		"\n"
+		"# Pacing\n"
+		"In client mode, the send rate is enforced by a token bucket of [-burst]() bytes, avoiding bursts of datagrams when the filter is scheduled late.\n"
+		"Finer pacing can be delegated to the kernel using [-pace](), which usually requires the `fq` (or `etf` for launch time) queuing discipline on the output interface.\n"
+		"EX gpac -i src.mp4 m2tsmx:rate=10000000 -o udp://234.0.0.1:1234/:ext=ts:cbr:pace=txtime\n"
+		"This sends a 10 Mbps CBR multiplex, paced at the multiplex rate with launch times on each datagram.\n"
 		"\n",
 #endif //GPAC_DISABLE_DOC
 	.private_size = sizeof(GF_SockOutCtx),
@@ -0,0 +1,713 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: Jean Le Feuvre
+ *			Copyright (c) Telecom Paris 2025
+ *					All rights reserved
+ *
+ *  This file is part of GPAC / parallel split and merge filters
+ *
+ *  GPAC is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  GPAC is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ */
+
+#include <gpac/filters.h>
+#include <gpac/constants.h>
+
+#ifndef GPAC_DISABLE_PSPLIT
+
+typedef struct
+{
+	GF_FilterPid *ipid, *opid;
+	//source filter, NULL for first range
+	GF_Filter *src;
+	//start time of range in seconds, as requested to source
+	Double start;
+	//CTS of first SAP of range
+	u64 start_cts_plus_one;
+	Bool is_playing, done;
+} PSplitRange;
+
+typedef struct
+{
+	u32 id;
+	u32 nb_ranges;
+	PSplitRange *ranges;
+} PSplitStream;
+
+typedef struct
+{
+	//options
+	u32 n;
+	Double mdur;
+
+	//internal
+	GF_List *streams;
+	GF_Filter **sources;
+	u32 nb_ranges;
+	Bool setup_done;
+} PSplitCtx;
+
+static void psplit_set_props(PSplitStream *st, u32 idx, GF_FilterPid *pid)
+{
+	GF_FilterPid *opid = st->ranges[idx].opid;
+	gf_filter_pid_copy_properties(opid, pid);
+	if (st->nb_ranges<2) return;
+	gf_filter_pid_set_property_str(opid, "psplit_id", &PROP_UINT(st->id) );
+	gf_filter_pid_set_property_str(opid, "psplit_idx", &PROP_UINT(idx) );
+	gf_filter_pid_set_property_str(opid, "psplit_cnt", &PROP_UINT(st->nb_ranges) );
+}
+
+static void psplit_setup_ranges(GF_Filter *filter, PSplitCtx *ctx, GF_FilterPid *pid)
+{
+	u32 i;
+	Double dur;
+	const GF_PropertyValue *p;
+	ctx->setup_done = GF_TRUE;
+	ctx->nb_ranges = 1;
+
+	p = gf_filter_pid_get_property(pid, GF_PROP_PID_PLAYBACK_MODE);
+	if (!p || (p->value.uint < GF_PLAYBACK_MODE_SEEK)) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_MEDIA, ("[PSplit] Source cannot be seeked, disabling split\n"));
+		return;
+	}
+	p = gf_filter_pid_get_property(pid, GF_PROP_PID_DURATION);
+	if (!p || !p->value.lfrac.den || (p->value.lfrac.num<=0)) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_MEDIA, ("[PSplit] Source duration unknown, disabling split\n"));
+		return;
+	}
+	dur = ((Double) p->value.lfrac.num) / p->value.lfrac.den;
+
+	p = gf_filter_pid_get_property(pid, GF_PROP_PID_URL);
+	if (!p || !p->value.string) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_MEDIA, ("[PSplit] Source URL unknown, disabling split\n"));
+		return;
+	}
+
+	ctx->nb_ranges = ctx->n;
+	if (!ctx->nb_ranges) {
+		GF_SystemRTInfo rti;
+		if (gf_sys_get_rti(0, &rti, GF_RTI_SYSTEM_MEMORY_ONLY))
+			ctx->nb_ranges = rti.nb_cores;
+	}
+	if ((ctx->mdur>0) && (ctx->nb_ranges * ctx->mdur > dur))
+		ctx->nb_ranges = (u32) (dur / ctx->mdur);
+	if (ctx->nb_ranges<2) {
+		ctx->nb_ranges = 1;
+		return;
+	}
+
+	ctx->sources = gf_malloc(sizeof(GF_Filter *) * ctx->nb_ranges);
+	if (!ctx->sources) {
+		ctx->nb_ranges = 1;
+		return;
+	}
+	memset(ctx->sources, 0, sizeof(GF_Filter *) * ctx->nb_ranges);
+	//load one source per range, the first range uses the original source
+	for (i=1; i<ctx->nb_ranges; i++) {
+		GF_Err e;
+		ctx->sources[i] = gf_filter_connect_source(filter, p->value.string, NULL, GF_FALSE, &e);
+		if (!ctx->sources[i]) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_MEDIA, ("[PSplit] Failed to open source %s for range %d: %s, using %d ranges\n", p->value.string, i+1, gf_error_to_string(e), i));
+			ctx->nb_ranges = i;
+			break;
+		}
+		gf_filter_set_source(filter, ctx->sources[i], NULL);
+	}
+	GF_LOG(GF_LOG_INFO, GF_LOG_MEDIA, ("[PSplit] Splitting %g sec source in %d ranges\n", dur, ctx->nb_ranges));
+}
+
+static PSplitStream *psplit_get_stream(PSplitCtx *ctx, GF_FilterPid *pid, u32 *range_idx)
+{
+	u32 i, j, count = gf_list_count(ctx->streams);
+	for (i=0; i<count; i++) {
+		PSplitStream *st = gf_list_get(ctx->streams, i);
+		for (j=0; j<st->nb_ranges; j++) {
+			if ((st->ranges[j].ipid==pid) || (st->ranges[j].opid==pid)) {
+				*range_idx = j;
+				return st;
+			}
+		}
+	}
+	return NULL;
+}
+
+static void psplit_send_play(PSplitStream *st, u32 idx, const GF_FilterEvent *evt)
+{
+	GF_FilterEvent anevt;
+	PSplitRange *r = &st->ranges[idx];
+	if (!r->ipid || r->done) return;
+	if (evt) {
+		anevt = *evt;
+	} else {
+		GF_FEVT_INIT(anevt, GF_FEVT_PLAY, NULL);
+		anevt.play.speed = 1.0;
+	}
+	anevt.base.on_pid = r->ipid;
+	//seek range sources to their start
+	if (idx && (anevt.base.type==GF_FEVT_PLAY))
+		anevt.play.start_range = r->start;
+	gf_filter_pid_send_event(r->ipid, &anevt);
+}
+
+static GF_Err psplit_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remove)
+{
+	u32 i, idx=0, stype;
+	const GF_PropertyValue *p;
+	PSplitStream *st;
+	PSplitCtx *ctx = (PSplitCtx *) gf_filter_get_udta(filter);
+
+	st = psplit_get_stream(ctx, pid, &idx);
+	if (is_remove) {
+		if (!st) return GF_OK;
+		st->ranges[idx].ipid = NULL;
+		if (st->ranges[idx].opid && !st->ranges[idx].done)
+			gf_filter_pid_set_eos(st->ranges[idx].opid);
+		st->ranges[idx].done = GF_TRUE;
+		return GF_OK;
+	}
+	if (!gf_filter_pid_check_caps(pid))
+		return GF_NOT_SUPPORTED;
+
+	//reconfig
+	if (st) {
+		if (!idx) {
+			for (i=0; i<st->nb_ranges; i++)
+				psplit_set_props(st, i, pid);
+		}
+		return GF_OK;
+	}
+
+	//PID from a range source
+	for (i=1; i<ctx->nb_ranges; i++) {
+		u32 j, id;
+		if (!ctx->sources[i] || !gf_filter_pid_is_filter_in_parents(pid, ctx->sources[i])) continue;
+
+		p = gf_filter_pid_get_property(pid, GF_PROP_PID_ID);
+		id = p ? p->value.uint : 0;
+		for (j=0; j<gf_list_count(ctx->streams); j++) {
+			st = gf_list_get(ctx->streams, j);
+			if ((st->nb_ranges>i) && (st->id==id) && !st->ranges[i].ipid) break;
+			st = NULL;
+		}
+		//not a split stream, ignore
+		if (!st) {
+			gf_filter_pid_set_discard(pid, GF_TRUE);
+			return GF_OK;
+		}
+		st->ranges[i].ipid = pid;
+		if (st->ranges[i].is_playing)
+			psplit_send_play(st, i, NULL);
+		return GF_OK;
+	}
+
+	p = gf_filter_pid_get_property(pid, GF_PROP_PID_STREAM_TYPE);
+	stype = p ? p->value.uint : 0;
+	if (!ctx->setup_done && (stype==GF_STREAM_VISUAL))
+		psplit_setup_ranges(filter, ctx, pid);
+
+	GF_SAFEALLOC(st, PSplitStream);
+	if (!st) return GF_OUT_OF_MEM;
+	p = gf_filter_pid_get_property(pid, GF_PROP_PID_ID);
+	st->id = p ? p->value.uint : 0;
+	//only split visual streams, other streams are forwarded as is
+	st->nb_ranges = ((stype==GF_STREAM_VISUAL) && ctx->setup_done) ? ctx->nb_ranges : 1;
+	st->ranges = gf_malloc(sizeof(PSplitRange) * st->nb_ranges);
+	if (!st->ranges) {
+		gf_free(st);
+		return GF_OUT_OF_MEM;
+	}
+	memset(st->ranges, 0, sizeof(PSplitRange) * st->nb_ranges);
+	gf_list_add(ctx->streams, st);
+
+	st->ranges[0].ipid = pid;
+	p = gf_filter_pid_get_property(pid, GF_PROP_PID_DURATION);
+	for (i=0; i<st->nb_ranges; i++) {
+		if (i && p && p->value.lfrac.den)
+			st->ranges[i].start = ((Double) p->value.lfrac.num) * i / st->nb_ranges / p->value.lfrac.den;
+		st->ranges[i].src = i ? ctx->sources[i] : NULL;
+		st->ranges[i].opid = gf_filter_pid_new(filter);
+		psplit_set_props(st, i, pid);
+	}
+	return GF_OK;
+}
+
+static Bool psplit_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
+{
+	u32 idx=0;
+	GF_FilterEvent anevt;
+	PSplitCtx *ctx = (PSplitCtx *) gf_filter_get_udta(filter);
+	PSplitStream *st = psplit_get_stream(ctx, evt->base.on_pid, &idx);
+	if (!st || (st->ranges[idx].opid != evt->base.on_pid)) return GF_FALSE;
+
+	switch (evt->base.type) {
+	case GF_FEVT_PLAY:
+		st->ranges[idx].is_playing = GF_TRUE;
+		psplit_send_play(st, idx, evt);
+		return GF_TRUE;
+	case GF_FEVT_STOP:
+		st->ranges[idx].is_playing = GF_FALSE;
+		break;
+	default:
+		break;
+	}
+	if (!st->ranges[idx].ipid || st->ranges[idx].done) return GF_TRUE;
+	anevt = *evt;
+	anevt.base.on_pid = st->ranges[idx].ipid;
+	gf_filter_pid_send_event(st->ranges[idx].ipid, &anevt);
+	return GF_TRUE;
+}
+
+static void psplit_range_done(PSplitRange *r)
+{
+	GF_FilterEvent evt;
+	r->done = GF_TRUE;
+	gf_filter_pid_set_eos(r->opid);
+	GF_FEVT_INIT(evt, GF_FEVT_STOP, r->ipid);
+	gf_filter_pid_send_event(r->ipid, &evt);
+	gf_filter_pid_set_discard(r->ipid, GF_TRUE);
+}
+
+static GF_Err psplit_process(GF_Filter *filter)
+{
+	u32 i, j, count, nb_done=0, nb_ranges=0;
+	PSplitCtx *ctx = (PSplitCtx *) gf_filter_get_udta(filter);
+
+	count = gf_list_count(ctx->streams);
+	for (i=0; i<count; i++) {
+		PSplitStream *st = gf_list_get(ctx->streams, i);
+		nb_ranges += st->nb_ranges;
+		for (j=0; j<st->nb_ranges; j++) {
+			PSplitRange *r = &st->ranges[j];
+			PSplitRange *next = (j+1<st->nb_ranges) ? &st->ranges[j+1] : NULL;
+			if (r->done) {
+				nb_done++;
+				continue;
+			}
+			if (!r->ipid) continue;
+
+			while (1) {
+				u64 cts;
+				Bool is_sap;
+				GF_FilterPacket *dst;
+				GF_FilterPacket *pck = gf_filter_pid_get_packet(r->ipid);
+				if (!pck) {
+					if (gf_filter_pid_is_eos(r->ipid)) {
+						r->done = GF_TRUE;
+						gf_filter_pid_set_eos(r->opid);
+					}
+					break;
+				}
+				cts = gf_filter_pck_get_cts(pck);
+				is_sap = (gf_filter_pck_get_sap(pck) != GF_FILTER_SAP_NONE) ? GF_TRUE : GF_FALSE;
+				//seeked range: start at first SAP after seek point, timestamps of packets flagged as seek are not reliable
+				if (j && !r->start_cts_plus_one) {
+					if (!is_sap || (cts==GF_FILTER_NO_TS) || gf_filter_pck_get_seek_flag(pck)) {
+						gf_filter_pid_drop_packet(r->ipid);
+						continue;
+					}
+					r->start_cts_plus_one = cts + 1;
+					GF_LOG(GF_LOG_DEBUG, GF_LOG_MEDIA, ("[PSplit] Stream %d range %d starts at CTS "LLU"\n", st->id, j+1, cts));
+				}
+				//range end: the first SAP of next range, wait until known
+				if (next && (next->start_cts_plus_one || !next->done)) {
+					if (!next->start_cts_plus_one) break;
+					if (is_sap && (cts != GF_FILTER_NO_TS) && (cts + 1 >= next->start_cts_plus_one)) {
+						GF_LOG(GF_LOG_DEBUG, GF_LOG_MEDIA, ("[PSplit] Stream %d range %d done at CTS "LLU"\n", st->id, j+1, cts));
+						psplit_range_done(r);
+						break;
+					}
+				}
+				if (gf_filter_pid_would_block(r->opid))
+					break;
+
+				dst = gf_filter_pck_new_ref(r->opid, 0, 0, pck);
+				if (!dst) return GF_OUT_OF_MEM;
+				gf_filter_pck_merge_properties(pck, dst);
+				gf_filter_pck_send(dst);
+				gf_filter_pid_drop_packet(r->ipid);
+			}
+			if (r->done) nb_done++;
+		}
+	}
+	if (nb_ranges && (nb_done==nb_ranges)) return GF_EOS;
+	return GF_OK;
+}
+
+static GF_Err psplit_initialize(GF_Filter *filter)
+{
+	PSplitCtx *ctx = (PSplitCtx *) gf_filter_get_udta(filter);
+	ctx->streams = gf_list_new();
+	if (!ctx->streams) return GF_OUT_OF_MEM;
+	return GF_OK;
+}
+
+static void psplit_finalize(GF_Filter *filter)
+{
+	PSplitCtx *ctx = (PSplitCtx *) gf_filter_get_udta(filter);
+	while (gf_list_count(ctx->streams)) {
+		PSplitStream *st = gf_list_pop_back(ctx->streams);
+		gf_free(st->ranges);
+		gf_free(st);
+	}
+	gf_list_del(ctx->streams);
+	if (ctx->sources) gf_free(ctx->sources);
+}
+
+static const GF_FilterCapability PSplitCaps[] =
+{
+	CAP_UINT(GF_CAPS_INPUT_EXCLUDED, GF_PROP_PID_STREAM_TYPE, GF_STREAM_FILE),
+	CAP_UINT(GF_CAPS_INPUT_EXCLUDED, GF_PROP_PID_CODECID, GF_CODECID_NONE),
+	CAP_BOOL(GF_CAPS_INPUT_EXCLUDED, GF_PROP_PID_UNFRAMED, GF_TRUE),
+	CAP_UINT(GF_CAPS_OUTPUT_EXCLUDED, GF_PROP_PID_STREAM_TYPE, GF_STREAM_FILE),
+};
+
+#define OFFS(_n)	#_n, offsetof(PSplitCtx, _n)
+static GF_FilterArgs PSplitArgs[] =
+{
+	{ OFFS(n), "number of ranges to split the source into, 0 means number of cores", GF_PROP_UINT, "0", NULL, 0},
+	{ OFFS(mdur), "minimum duration in seconds of a range", GF_PROP_DOUBLE, "10", NULL, 0},
+	{0}
+};
+
+GF_FilterRegister PSplitRegister = {
+	.name = "psplit",
+	GF_FS_SET_DESCRIPTION("Parallel range splitter")
+	GF_FS_SET_HELP("This filter splits visual streams of a source into time ranges processed in parallel, and is used together with [pmerge](pmerge).\n"
+	"\n"
+	"The source duration is split in [-n]() ranges of equal duration, with a minimum of [-mdur]() seconds per range. "
+	"For each range other than the first one, a new instance of the source is loaded and seeked to the range start time.\n"
+	"Each range is delivered on its own output PID, starting at the first sync sample at or after the range start time and ending before the first sync sample of the next range. "
+	"Each output PID is then processed by its own filter chain (typically decoder and encoder), and the [pmerge](pmerge) filter concatenates the results in order.\n"
+	"Timestamps are not modified, so the merged stream timeline is the one of the source.\n"
+	"\n"
+	"Non-visual streams are forwarded as is from the first source, and must also be connected to [pmerge](pmerge).\n"
+	"\n"
+	"EX gpac -i src.mp4 psplit:n=4 enc:c=avc pmerge -o dst.mp4 -threads=4\n"
+	"This will transcode the video of `src.mp4` using 4 encoder instances running in parallel.\n"
+	"\n"
+	"Note: The source must be seekable and have a known duration, otherwise no split is performed.\n"
+	"Note: Open-GOP sources are not supported, leading pictures of a range start would not be decodable.\n"
+	)
+	.private_size = sizeof(PSplitCtx),
+	.max_extra_pids = 0xFFFFFFFF,
+	.flags = GF_FS_REG_EXPLICIT_ONLY,
+	.args = PSplitArgs,
+	SETCAPS(PSplitCaps),
+	.initialize = psplit_initialize,
+	.finalize = psplit_finalize,
+	.configure_pid = psplit_configure_pid,
+	.process = psplit_process,
+	.process_event = psplit_process_event,
+};
+
+const GF_FilterRegister *psplit_register(GF_FilterSession *session)
+{
+	return &PSplitRegister;
+}
+
+
+typedef struct
+{
+	GF_FilterPid *ipid;
+	Bool is_eos;
+	//packets received while a previous range is being forwarded
+	GF_List *packets;
+} PMergeInput;
+
+typedef struct
+{
+	u32 id;
+	GF_FilterPid *opid;
+	u32 nb_inputs, cur;
+	PMergeInput *inputs;
+	Bool is_playing, eos_sent;
+} PMergeStream;
+
+typedef struct
+{
+	GF_List *streams;
+} PMergeCtx;
+
+static PMergeStream *pmerge_get_stream(PMergeCtx *ctx, GF_FilterPid *pid, u32 *input_idx)
+{
+	u32 i, j, count = gf_list_count(ctx->streams);
+	for (i=0; i<count; i++) {
+		PMergeStream *st = gf_list_get(ctx->streams, i);
+		if (st->opid==pid) return st;
+		for (j=0; j<st->nb_inputs; j++) {
+			if (st->inputs[j].ipid==pid) {
+				if (input_idx) *input_idx = j;
+				return st;
+			}
+		}
+	}
+	return NULL;
+}
+
+static void pmerge_set_props(PMergeStream *st, GF_FilterPid *pid)
+{
+	gf_filter_pid_copy_properties(st->opid, pid);
+	gf_filter_pid_set_property_str(st->opid, "psplit_id", NULL);
+	gf_filter_pid_set_property_str(st->opid, "psplit_idx", NULL);
+	gf_filter_pid_set_property_str(st->opid, "psplit_cnt", NULL);
+}
+
+static GF_Err pmerge_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remove)
+{
+	u32 i, count, idx=0, cnt=1, id=0;
+	const GF_PropertyValue *p;
+	PMergeCtx *ctx = (PMergeCtx *) gf_filter_get_udta(filter);
+	PMergeStream *st = pmerge_get_stream(ctx, pid, &idx);
+
+	if (is_remove) {
+		if (!st) return GF_OK;
+		st->inputs[idx].ipid = NULL;
+		st->inputs[idx].is_eos = GF_TRUE;
+		gf_filter_post_process_task(filter);
+		return GF_OK;
+	}
+	if (!gf_filter_pid_check_caps(pid))
+		return GF_NOT_SUPPORTED;
+
+	if (st) {
+		//only reconfigure output for the range being forwarded
+		if (idx==st->cur)
+			pmerge_set_props(st, pid);
+		return GF_OK;
+	}
+
+	p = gf_filter_pid_get_property_str(pid, "psplit_cnt");
+	if (p) {
+		cnt = p->value.uint;
+		p = gf_filter_pid_get_property_str(pid, "psplit_idx");
+		idx = p ? p->value.uint : 0;
+		p = gf_filter_pid_get_property_str(pid, "psplit_id");
+		id = p ? p->value.uint : 0;
+		if (!cnt || (idx>=cnt)) return GF_BAD_PARAM;
+
+		count = gf_list_count(ctx->streams);
+		for (i=0; i<count; i++) {
+			st = gf_list_get(ctx->streams, i);
+			if (st->nb_inputs && (st->id==id) && (st->nb_inputs==cnt)) break;
+			st = NULL;
+		}
+	} else {
+		idx = 0;
+	}
+
+	if (!st) {
+		GF_SAFEALLOC(st, PMergeStream);
+		if (!st) return GF_OUT_OF_MEM;
+		st->id = id;
+		st->nb_inputs = cnt;
+		st->inputs = gf_malloc(sizeof(PMergeInput) * cnt);
+		if (!st->inputs) {
+			gf_free(st);
+			return GF_OUT_OF_MEM;
+		}
+		memset(st->inputs, 0, sizeof(PMergeInput) * cnt);
+		gf_list_add(ctx->streams, st);
+		st->opid = gf_filter_pid_new(filter);
+		pmerge_set_props(st, pid);
+	}
+	if (st->inputs[idx].ipid) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_MEDIA, ("[PMerge] Range %d of stream %d already connected\n", idx+1, id));
+		return GF_BAD_PARAM;
+	}
+	st->inputs[idx].ipid = pid;
+	if (!st->inputs[idx].packets)
+		st->inputs[idx].packets = gf_list_new();
+	if (idx==st->cur)
+		pmerge_set_props(st, pid);
+
+	if (st->is_playing) {
+		GF_FilterEvent evt;
+		GF_FEVT_INIT(evt, GF_FEVT_PLAY, pid);
+		evt.play.speed = 1.0;
+		gf_filter_pid_send_event(pid, &evt);
+	}
+	return GF_OK;
+}
+
+static Bool pmerge_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
+{
+	u32 i;
+	PMergeCtx *ctx = (PMergeCtx *) gf_filter_get_udta(filter);
+	PMergeStream *st = pmerge_get_stream(ctx, evt->base.on_pid, NULL);
+	if (!st || (st->opid != evt->base.on_pid)) return GF_FALSE;
+
+	if (evt->base.type==GF_FEVT_PLAY) st->is_playing = GF_TRUE;
+	else if (evt->base.type==GF_FEVT_STOP) st->is_playing = GF_FALSE;
+
+	//all ranges run in parallel, forward to all inputs
+	for (i=0; i<st->nb_inputs; i++) {
+		GF_FilterEvent anevt;
+		if (!st->inputs[i].ipid) continue;
+		anevt = *evt;
+		anevt.base.on_pid = st->inputs[i].ipid;
+		gf_filter_pid_send_event(st->inputs[i].ipid, &anevt);
+	}
+	return GF_TRUE;
+}
+
+static void pmerge_switch_input(PMergeStream *st)
+{
+	const GF_PropertyValue *p1, *p2;
+	PMergeInput *in;
+	st->cur++;
+	if (st->cur>=st->nb_inputs) return;
+	in = &st->inputs[st->cur];
+	if (!in->ipid) return;
+	//reconfigure output if decoder config changed
+	p1 = gf_filter_pid_get_property(in->ipid, GF_PROP_PID_DECODER_CONFIG);
+	p2 = gf_filter_pid_get_property(st->opid, GF_PROP_PID_DECODER_CONFIG);
+	if ((p1 || p2) && (!p1 || !p2 || !gf_props_equal(p1, p2))) {
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_MEDIA, ("[PMerge] Decoder config change for range %d of stream %d\n", st->cur+1, st->id));
+		pmerge_set_props(st, in->ipid);
+	}
+}
+
+static GF_Err pmerge_process(GF_Filter *filter)
+{
+	u32 i, j, count, nb_eos=0;
+	PMergeCtx *ctx = (PMergeCtx *) gf_filter_get_udta(filter);
+
+	count = gf_list_count(ctx->streams);
+	for (i=0; i<count; i++) {
+		PMergeStream *st = gf_list_get(ctx->streams, i);
+		if (st->eos_sent) {
+			nb_eos++;
+			continue;
+		}
+
+		for (j=st->cur; j<st->nb_inputs; j++) {
+			PMergeInput *in = &st->inputs[j];
+			if (!in->ipid) continue;
+			while (1) {
+				GF_FilterPacket *pck = gf_filter_pid_get_packet(in->ipid);
+				if (!pck) {
+					if (gf_filter_pid_is_eos(in->ipid))
+						in->is_eos = GF_TRUE;
+					break;
+				}
+				//current range, forward
+				if ((j==st->cur) && !gf_list_count(in->packets)) {
+					if (gf_filter_pid_would_block(st->opid))
+						break;
+					gf_filter_pck_forward(pck, st->opid);
+				}
+				//keep packets of next ranges so that their chains are not blocked
+				else {
+					gf_filter_pck_ref(&pck);
+					gf_list_add(in->packets, pck);
+				}
+				gf_filter_pid_drop_packet(in->ipid);
+			}
+		}
+
+		while (st->cur < st->nb_inputs) {
+			PMergeInput *in = &st->inputs[st->cur];
+			while (gf_list_count(in->packets)) {
+				GF_FilterPacket *pck;
+				if (gf_filter_pid_would_block(st->opid))
+					break;
+				pck = gf_list_pop_front(in->packets);
+				gf_filter_pck_forward(pck, st->opid);
+				gf_filter_pck_unref(pck);
+			}
+			if (gf_list_count(in->packets) || !in->is_eos)
+				break;
+			pmerge_switch_input(st);
+		}
+		if (st->cur >= st->nb_inputs) {
+			gf_filter_pid_set_eos(st->opid);
+			st->eos_sent = GF_TRUE;
+			nb_eos++;
+		}
+	}
+	if (count && (nb_eos==count)) return GF_EOS;
+	return GF_OK;
+}
+
+static GF_Err pmerge_initialize(GF_Filter *filter)
+{
+	PMergeCtx *ctx = (PMergeCtx *) gf_filter_get_udta(filter);
+	ctx->streams = gf_list_new();
+	if (!ctx->streams) return GF_OUT_OF_MEM;
+	return GF_OK;
+}
+
+static void pmerge_finalize(GF_Filter *filter)
+{
+	u32 i;
+	PMergeCtx *ctx = (PMergeCtx *) gf_filter_get_udta(filter);
+	while (gf_list_count(ctx->streams)) {
+		PMergeStream *st = gf_list_pop_back(ctx->streams);
+		for (i=0; i<st->nb_inputs; i++) {
+			if (!st->inputs[i].packets) continue;
+			while (gf_list_count(st->inputs[i].packets)) {
+				GF_FilterPacket *pck = gf_list_pop_back(st->inputs[i].packets);
+				gf_filter_pck_unref(pck);
+			}
+			gf_list_del(st->inputs[i].packets);
+		}
+		gf_free(st->inputs);
+		gf_free(st);
+	}
+	gf_list_del(ctx->streams);
+}
+
+GF_FilterRegister PMergeRegister = {
+	.name = "pmerge",
+	GF_FS_SET_DESCRIPTION("Parallel range merger")
+	GF_FS_SET_HELP("This filter concatenates in order the ranges produced by [psplit](psplit) and processed in parallel.\n"
+	"\n"
+	"Ranges of a given stream are identified through the `psplit_id`, `psplit_idx` and `psplit_cnt` PID properties set by [psplit](psplit). "
+	"Packets of a range are forwarded once all packets of the previous ranges have been forwarded. "
+	"Packets of ranges not yet forwarded are kept in memory so that their processing chains are never blocked.\n"
+	"If the decoder configuration of a range differs from the previous one, the output PID is reconfigured.\n"
+	"\n"
+	"PIDs without range information are forwarded as is.\n"
+	"\n"
+	"See [psplit](psplit) for examples.\n"
+	)
+	.private_size = sizeof(PMergeCtx),
+	.max_extra_pids = 0xFFFFFFFF,
+	.flags = GF_FS_REG_EXPLICIT_ONLY,
+	SETCAPS(PSplitCaps),
+	.initialize = pmerge_initialize,
+	.finalize = pmerge_finalize,
+	.configure_pid = pmerge_configure_pid,
+	.process = pmerge_process,
+	.process_event = pmerge_process_event,
+};
+
+const GF_FilterRegister *pmerge_register(GF_FilterSession *session)
+{
+	return &PMergeRegister;
+}
+
+#else
+
+const GF_FilterRegister *psplit_register(GF_FilterSession *session)
+{
+	return NULL;
+}
+const GF_FilterRegister *pmerge_register(GF_FilterSession *session)
+{
+	return NULL;
+}
+#endif //GPAC_DISABLE_PSPLIT
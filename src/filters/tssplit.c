@@ -107,7 +107,7 @@ void m2tssplit_flush(GF_M2TSSplitCtx *ctx)
 	for (i=0; i<gf_list_count(ctx->streams); i++ ) {
 		GF_M2TSSplit_SPTS *stream = gf_list_get(ctx->streams, i);
 		if (stream->opid && stream->nb_pck)
-			m2tssplit_send_packet(ctx, stream, NULL, 0);
+			m2tssplit_send_packet(ctx, stream, NULL, ctx->dmx->prefix_present ? 192 : 188);
 	}
 
 }
@@ -149,6 +149,10 @@ static Bool m2tssplit_process_event(GF_Filter *filter, const GF_FilterEvent *evt
 	case GF_FEVT_SET_SPEED:
 		//cancel event
 		return GF_TRUE;
+
+	case GF_FEVT_SOURCE_SEEK:
+		//input is shared by all programs, a demuxer on one output shall not rewind it
+		return GF_TRUE;
 	default:
 		break;
 	}
@@ -164,8 +168,16 @@ GF_Err m2tssplit_process(GF_Filter *filter)
 	u32 data_size;
 	pck = gf_filter_pid_get_packet(ctx->ipid);
 	if (!pck) {
-		if (gf_filter_pid_is_eos(ctx->ipid))
+		if (gf_filter_pid_is_eos(ctx->ipid)) {
+			u32 i;
 			m2tssplit_flush(ctx);
+			//signal end of stream on all programs so that their demultiplexers flush pending PES
+			for (i=0; i<gf_list_count(ctx->streams); i++ ) {
+				GF_M2TSSplit_SPTS *stream = gf_list_get(ctx->streams, i);
+				if (stream->opid) gf_filter_pid_set_eos(stream->opid);
+			}
+			return GF_EOS;
+		}
 		return GF_OK;
 	}
 	data = gf_filter_pck_get_data(pck, &data_size);
@@ -356,6 +368,11 @@ void m2tssplit_on_event(struct tag_m2ts_demux *ts, u32 evt_type, void *par)
 			gf_filter_pid_set_property(stream->opid, GF_PROP_PID_MIME, &PROP_STRING("video/mpeg-2"));
 			gf_filter_pid_set_property(stream->opid, GF_PROP_PID_FILE_EXT, &PROP_STRING("ts"));
 			gf_filter_pid_set_property(stream->opid, GF_PROP_PID_SERVICE_ID, &PROP_UINT(prog->number));
+			//remove source file info inherited from input: the output is a subset of the source file and cannot be probed or seeked
+			//by the demultiplexer of the program, which can then run independently (and in parallel) of other programs
+			gf_filter_pid_set_property(stream->opid, GF_PROP_PID_FILEPATH, NULL);
+			gf_filter_pid_set_property(stream->opid, GF_PROP_PID_URL, NULL);
+			gf_filter_pid_set_property(stream->opid, GF_PROP_PID_DOWN_SIZE, NULL);
 
 			GF_FilterPacket *pck = gf_filter_pck_new_alloc(stream->opid, stream->pat_pck_size, &buffer);
 			if (pck) {
@@ -476,7 +493,12 @@ GF_FilterRegister M2TSSplitRegister = {
 	GF_FS_SET_DESCRIPTION("MPEG Transport Stream splitter")
 	GF_FS_SET_HELP("This filter splits an MPEG-2 transport stream into several single program transport streams.\n"
 	"Only the PAT table is rewritten, other tables (PAT, PMT) and streams (PES) are forwarded as is.\n"
-	"If [-dvb]() is set, global DVB tables of the input multiplex are forwarded to each output mux; otherwise these tables are discarded.")
+	"If [-dvb]() is set, global DVB tables of the input multiplex are forwarded to each output mux; otherwise these tables are discarded.\n"
+	"\n"
+	"The filter can be used to demultiplex large multi-program streams in parallel: each output program is handled by its own demultiplexer instance, and these instances are scheduled independently.\n"
+	"EX gpac -threads=-1 -i mpts.ts tssplit inspect:deep\n"
+	"This will split the input in single program streams and demultiplex each program in a dedicated filter.\n"
+	"Output programs do not carry the source file information, and seek requests from downstream filters are ignored.\n")
 	.flags = GF_FS_REG_EXPLICIT_ONLY,
 	.private_size = sizeof(GF_M2TSSplitCtx),
 	.initialize = m2tssplit_initialize,
@@ -29,6 +29,10 @@
 
 #define MAX_RTP_SN	0x10000
 
+//batch slots are sized for MTU-bound datagrams, larger datagrams switch the channel to unbatched reception
+#define RTP_RECV_SLOT_SIZE	2048
+#define RTP_RECV_BATCH	16
+
 
 GF_EXPORT
 GF_RTPChannel *gf_rtp_new_ex(const char *netcap_id)
@@ -62,6 +66,8 @@ void gf_rtp_del(GF_RTPChannel *ch)
 	if (ch->net_info.Profile) gf_free(ch->net_info.Profile);
 	if (ch->po) gf_rtp_reorderer_del(ch->po);
 	if (ch->send_buffer) gf_free(ch->send_buffer);
+	if (ch->rcv_batch) gf_free(ch->rcv_batch);
+	if (ch->rcv_sizes) gf_free(ch->rcv_sizes);
 
 	if (ch->CName) gf_free(ch->CName);
 	if (ch->s_name) gf_free(ch->s_name);
@@ -413,10 +419,49 @@ u32 gf_rtp_read_rtp(GF_RTPChannel *ch, u8 *buffer, u32 buffer_size)
 	//only if the socket exist (otherwise RTSP interleaved channel)
 	if (!ch || !ch->rtp) return 0;
 
-	if (ch->no_select) {
-		e = gf_sk_receive_no_select(ch->rtp, buffer, buffer_size, &res);
+	e = GF_OK;
+	res = 0;
+	//datagrams larger than batch slots were received, read them one at a time once pending ones are processed
+	if (ch->rcv_no_batch && (ch->rcv_idx >= ch->rcv_nb)) {
+		if (ch->rcv_batch) {
+			gf_free(ch->rcv_batch);
+			ch->rcv_batch = NULL;
+		}
+		if (ch->no_select) {
+			e = gf_sk_receive_no_select(ch->rtp, buffer, buffer_size, &res);
+		} else {
+			e = gf_sk_receive(ch->rtp, buffer, buffer_size, &res);
+		}
 	} else {
-		e = gf_sk_receive(ch->rtp, buffer, buffer_size, &res);
+		//fetch datagrams by batch and serve them one at a time
+		if (ch->rcv_idx >= ch->rcv_nb) {
+			ch->rcv_idx = ch->rcv_nb = 0;
+			if (!ch->rcv_batch) {
+				ch->rcv_batch = gf_malloc(sizeof(u8) * RTP_RECV_SLOT_SIZE * RTP_RECV_BATCH);
+				if (!ch->rcv_sizes) ch->rcv_sizes = gf_malloc(sizeof(u32) * RTP_RECV_BATCH);
+				if (!ch->rcv_batch || !ch->rcv_sizes) return 0;
+			}
+			//as done by gf_sk_receive, wait for the socket to be ready unless disabled
+			if (!ch->no_select)
+				e = gf_sk_select(ch->rtp, GF_SK_SELECT_READ);
+			if (!e)
+				e = gf_sk_receive_batch(ch->rtp, ch->rcv_batch, RTP_RECV_SLOT_SIZE, RTP_RECV_BATCH, ch->rcv_sizes, &ch->rcv_nb);
+		}
+		if (!e && (ch->rcv_idx < ch->rcv_nb)) {
+			res = ch->rcv_sizes[ch->rcv_idx];
+			//datagram may be truncated, drop it
+			if (res >= RTP_RECV_SLOT_SIZE) {
+				if (!ch->rcv_no_batch) {
+					GF_LOG(GF_LOG_WARNING, GF_LOG_RTP, ("[RTP] Datagram larger than %d bytes received, disabling batch reception\n", RTP_RECV_SLOT_SIZE));
+				}
+				ch->rcv_no_batch = GF_TRUE;
+				res = 0;
+			} else {
+				if (res > buffer_size) res = buffer_size;
+				memcpy(buffer, ch->rcv_batch + ch->rcv_idx * RTP_RECV_SLOT_SIZE, res);
+			}
+			ch->rcv_idx++;
+		}
 	}
 	if (!res || e || (res < 12)) {
 		res = 0;
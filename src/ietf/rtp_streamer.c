@@ -52,6 +52,9 @@ struct __rtp_streamer
 
 	const char *netcap_id;
 	GF_Err last_err;
+
+	void (*on_packet)(void *udta, GF_RTPHeader *hdr, u8 *payload, u32 size);
+	void *on_packet_udta;
 };
 
 
@@ -63,8 +66,14 @@ static void rtp_stream_on_new_packet(void *cbk, GF_RTPHeader *header)
 
 static void rtp_stream_on_packet_done(void *cbk, GF_RTPHeader *header)
 {
+	GF_Err e;
 	GF_RTPStreamer *rtp = (GF_RTPStreamer*)cbk;
-	GF_Err e = gf_rtp_send_packet(rtp->channel, header, rtp->buffer+12, rtp->payload_len, GF_TRUE);
+	if (rtp->on_packet) {
+		rtp->on_packet(rtp->on_packet_udta, header, rtp->buffer+12, rtp->payload_len);
+		rtp->payload_len = 0;
+		return;
+	}
+	e = gf_rtp_send_packet(rtp->channel, header, rtp->buffer+12, rtp->payload_len, GF_TRUE);
 
 #ifndef GPAC_DISABLE_LOG
 	if (e) {
@@ -926,6 +935,22 @@ u16 gf_rtp_streamer_get_next_rtp_sn(GF_RTPStreamer *streamer)
 	return streamer->packetizer->rtp_header.SequenceNumber+1;
 }
 
+GF_EXPORT
+GF_Err gf_rtp_streamer_set_pacing(GF_RTPStreamer *streamer, u32 rate, u32 burst, u32 flags)
+{
+	if (!streamer || !streamer->channel) return GF_BAD_PARAM;
+	//interleaved RTP, nothing to pace
+	if (!streamer->channel->rtp) return GF_OK;
+	return gf_sk_set_pacing(streamer->channel->rtp, rate, burst, flags);
+}
+
+GF_EXPORT
+u32 gf_rtp_streamer_get_pacing_delay(GF_RTPStreamer *streamer, u32 size)
+{
+	if (!streamer || !streamer->channel || !streamer->channel->rtp) return 0;
+	return gf_sk_pacing_delay(streamer->channel->rtp, size);
+}
+
 GF_EXPORT
 GF_Err gf_rtp_streamer_set_interleave_callbacks(GF_RTPStreamer *streamer, gf_rtp_tcp_callback RTP_TCPCallback, void *cbk1, void *cbk2)
 {
@@ -933,6 +958,27 @@ GF_Err gf_rtp_streamer_set_interleave_callbacks(GF_RTPStreamer *streamer, gf_rtp
  	return gf_rtp_set_interleave_callbacks(streamer->channel, RTP_TCPCallback, cbk1, cbk2);
 }
 
+GF_EXPORT
+void gf_rtp_streamer_set_packet_callback(GF_RTPStreamer *streamer, void (*on_packet)(void *udta, GF_RTPHeader *hdr, u8 *payload, u32 size), void *udta)
+{
+	if (!streamer) return;
+	streamer->on_packet = on_packet;
+	streamer->on_packet_udta = udta;
+}
+
+GF_EXPORT
+GF_Err gf_rtp_streamer_send_packet(GF_RTPStreamer *streamer, GF_RTPHeader *hdr, u8 *payload, u32 size)
+{
+	GF_Err e;
+	if (!streamer || !streamer->channel) return GF_BAD_PARAM;
+	e = gf_rtp_send_packet(streamer->channel, hdr, payload, size, GF_TRUE);
+	if (e) {
+		streamer->last_err = e;
+		GF_LOG(GF_LOG_ERROR, GF_LOG_RTP, ("[RTP] Error %s sending RTP packet SN %u - TS %u\n", gf_error_to_string(e), hdr->SequenceNumber, hdr->TimeStamp));
+	}
+	return e;
+}
+
 GF_EXPORT
 GF_Err gf_rtp_streamer_read_rtcp(GF_RTPStreamer *streamer, gf_rtcp_rr_callback rtcp_cbk, void *udta)
 {
@@ -168,6 +168,8 @@ struct __dash_client
 	u32 preroll_state;
 
 	u32 llhls_single_range;
+	//number of segments resolved ahead of the one being played, for parallel fetching by the user
+	u32 prefetch_depth;
 	Bool m3u8_reload_master;
 	u32 hls_reload_time;
 
@@ -5433,7 +5435,7 @@ GF_Err gf_dash_setup_groups(GF_DashClient *dash)
 		if (group->cache_duration < dash->mpd->min_buffer_time)
 			group->cache_duration = dash->mpd->min_buffer_time;
 
-		group->max_cached_segments = (nb_dependent_rep+1);
+		group->max_cached_segments = (nb_dependent_rep+1) * (1 + dash->prefetch_depth);
 
 		if (!has_dependent_representations)
 			group->base_rep_index_plus_one = 0; // all representations in this group are independent
@@ -8861,6 +8863,12 @@ void gf_dash_enable_single_range_llhls(GF_DashClient *dash, Bool enable)
 	dash->llhls_single_range = enable ? 1 : 0;
 }
 
+GF_EXPORT
+void gf_dash_set_prefetch_depth(GF_DashClient *dash, u32 nb_segments)
+{
+	if (dash) dash->prefetch_depth = nb_segments;
+}
+
 GF_EXPORT
 void gf_dash_enable_group_selection(GF_DashClient *dash, Bool enable)
 {
@@ -9733,6 +9741,26 @@ GF_Err gf_dash_group_get_next_segment_location(GF_DashClient *dash, u32 idx, u32
 	return GF_OK;
 }
 
+GF_EXPORT
+GF_Err gf_dash_group_get_queued_segment_location(GF_DashClient *dash, u32 idx, u32 queue_idx, const char **url, u64 *start_range, u64 *end_range)
+{
+	GF_DASH_Group *group;
+	*url = NULL;
+	if (start_range) *start_range = 0;
+	if (end_range) *end_range = 0;
+
+	group = gf_list_get(dash->groups, idx);
+	if (!group) return GF_BAD_PARAM;
+	if (queue_idx >= group->nb_cached_segments) return GF_BUFFER_TOO_SMALL;
+
+	*url = group->cached[queue_idx].url;
+	if (start_range) *start_range = group->cached[queue_idx].start_range;
+	if (end_range) *end_range = group->cached[queue_idx].end_range;
+	if (group->cached[queue_idx].flags & SEG_FLAG_DISABLED)
+		return GF_URL_REMOVED;
+	return GF_OK;
+}
+
 
 GF_EXPORT
 void gf_dash_seek(GF_DashClient *dash, Double start_range)
@@ -447,13 +447,14 @@ void gf_m2ts_mux_table_update_mpeg4(GF_M2TS_Mux_Stream *stream, u8 table_id, u16
 	/*MPEG-4 tables are input streams for the mux, the bitrate is updated when fetching AUs*/
 }
 
-static u32 gf_m2ts_add_adaptation(GF_M2TS_Mux_Program *prog, GF_BitStream *bs, u16 pid,
+/*writes adaptation field directly in the packet buffer, returns number of bytes written*/
+static u32 gf_m2ts_add_adaptation(GF_M2TS_Mux_Program *prog, u8 *ptr, u16 pid,
                                   Bool has_pcr, u64 pcr_time,
                                   Bool is_rap,
                                   u32 padding_length,
-                                  char *af_descriptors, u32 af_descriptors_size, Bool set_discontinuity)
+                                  u8 *af_descriptors, u32 af_descriptors_size, Bool set_discontinuity)
 {
-	u32 adaptation_length;
+	u32 adaptation_length, pos;
 
 	adaptation_length = ADAPTATION_FLAGS_LENGTH + (has_pcr?PCR_LENGTH:0) + padding_length;
 
@@ -462,22 +463,22 @@ static u32 gf_m2ts_add_adaptation(GF_M2TS_Mux_Program *prog, GF_BitStream *bs, u
 		adaptation_length += ADAPTATION_EXTENSION_LENGTH_LENGTH + ADAPTATION_EXTENSION_FLAGS_LENGTH + af_descriptors_size;
 	}
 
-	gf_bs_write_int(bs,	adaptation_length, 8);
-	gf_bs_write_int(bs,	set_discontinuity ? 1 : 0, 1);			// discontinuity indicator
-	gf_bs_write_int(bs,	is_rap, 1);		// random access indicator
-	gf_bs_write_int(bs,	0, 1);			// es priority indicator
-	gf_bs_write_int(bs,	has_pcr, 1);	// PCR_flag
-	gf_bs_write_int(bs,	0, 1);			// OPCR flag
-	gf_bs_write_int(bs,	0, 1);			// splicing point flag
-	gf_bs_write_int(bs,	0, 1);			// transport private data flag
-	gf_bs_write_int(bs,	af_descriptors_size ? 1 : 0, 1);			// adaptation field extension flag
+	ptr[0] = (u8) adaptation_length;
+	//discontinuity, random access, es priority (0), PCR, OPCR (0), splicing point (0), private data (0), AF extension
+	ptr[1] = (set_discontinuity ? 0x80 : 0) | (is_rap ? 0x40 : 0) | (has_pcr ? 0x10 : 0) | (af_descriptors_size ? 0x01 : 0);
+	pos = 2;
 	if (has_pcr) {
 		u64 PCR_base, PCR_ext;
 		PCR_base = pcr_time/300;
-		gf_bs_write_long_int(bs, PCR_base, 33);
-		gf_bs_write_int(bs,	0, 6); // reserved
 		PCR_ext = pcr_time - PCR_base*300;
-		gf_bs_write_long_int(bs, PCR_ext, 9);
+		//33 bits base, 6 bits reserved, 9 bits extension
+		ptr[2] = (u8) (PCR_base >> 25);
+		ptr[3] = (u8) (PCR_base >> 17);
+		ptr[4] = (u8) (PCR_base >> 9);
+		ptr[5] = (u8) (PCR_base >> 1);
+		ptr[6] = (u8) ( ((PCR_base & 0x1) << 7) | ((PCR_ext >> 8) & 0x1) );
+		ptr[7] = (u8) PCR_ext;
+		pos += PCR_LENGTH;
 		if (prog->last_pcr > pcr_time) {
 			GF_LOG(GF_LOG_INFO, GF_LOG_CONTAINER, ("[MPEG-2 TS Muxer] PID %d: Sending PCR "LLD" earlier than previous PCR "LLD" - drift %f sec - discontinuity set\n", pid, pcr_time, prog->last_pcr, (prog->last_pcr - pcr_time) /27000000.0 ));
 		}
@@ -492,18 +493,17 @@ static u32 gf_m2ts_add_adaptation(GF_M2TS_Mux_Program *prog, GF_BitStream *bs, u
 	}
 
 	if (af_descriptors_size) {
-		gf_bs_write_int(bs,	ADAPTATION_EXTENSION_FLAGS_LENGTH + af_descriptors_size, 8);
-
-		gf_bs_write_int(bs,	0, 1);			// ltw_flag
-		gf_bs_write_int(bs,	0, 1);			// piecewise_rate_flag
-		gf_bs_write_int(bs,	0, 1);			// seamless_splice_flag
-		gf_bs_write_int(bs,	0, 1);			// af_descriptor_not_present_flag
-		gf_bs_write_int(bs,	0xF, 4);			// reserved
-
-		gf_bs_write_data(bs, af_descriptors, af_descriptors_size);
+		ptr[pos] = (u8) (ADAPTATION_EXTENSION_FLAGS_LENGTH + af_descriptors_size);
+		//ltw, piecewise_rate, seamless_splice, af_descriptor_not_present flags all 0, 4 bits reserved
+		ptr[pos+1] = 0x0F;
+		pos += 2;
+		memcpy(ptr+pos, af_descriptors, af_descriptors_size);
+		pos += af_descriptors_size;
 	}
 
-	gf_bs_write_byte(bs, 0xFF, padding_length); // stuffing byte
+	if (padding_length) {
+		memset(ptr+pos, 0xFF, padding_length); // stuffing byte
+	}
 
 	return adaptation_length + ADAPTATION_LENGTH_LENGTH;
 }
@@ -512,10 +512,10 @@ static u32 gf_m2ts_add_adaptation(GF_M2TS_Mux_Program *prog, GF_BitStream *bs, u
 
 void gf_m2ts_mux_table_get_next_packet(GF_M2TS_Mux *mux, GF_M2TS_Mux_Stream *stream, char *packet)
 {
-	GF_BitStream *bs;
 	GF_M2TS_Mux_Table *table;
 	GF_M2TS_Mux_Section *section;
-	u32 payload_length, payload_start;
+	u8 *pck = (u8 *) packet;
+	u32 payload_length, payload_start, pos;
 	u8 adaptation_field_control = GF_M2TS_ADAPTATION_NONE;
 #ifndef USE_AF_STUFFING
 	u32 padded_bytes=0;
@@ -533,8 +533,6 @@ void gf_m2ts_mux_table_get_next_packet(GF_M2TS_Mux *mux, GF_M2TS_Mux_Stream *str
 	section = stream->current_section;
 	gf_assert(section);
 
-	bs = mux->pck_bs;
-
 	if (!stream->current_section_offset) payload_length = 183;
 	else payload_length = 184;
 
@@ -570,33 +568,27 @@ void gf_m2ts_mux_table_get_next_packet(GF_M2TS_Mux *mux, GF_M2TS_Mux_Stream *str
 		else stream->continuity_counter--;
 	}
 
-	gf_bs_reassign_buffer(bs, packet, 188);
-	gf_bs_write_int(bs,	0x47, 8); // sync
-	gf_bs_write_int(bs,	0, 1);    // error indicator
-	if (stream->current_section_offset == 0) {
-		gf_bs_write_int(bs,	1, 1);    // payload start indicator
-	} else {
-		/* No section concatenation yet!!!*/
-		gf_bs_write_int(bs,	0, 1);    // payload start indicator
-	}
-	gf_bs_write_int(bs,	0, 1);    /*priority indicator*/
-	gf_bs_write_int(bs,	stream->pid, 13); /*pid*/
-	gf_bs_write_int(bs,	0, 2);    /*scrambling indicator*/
-	gf_bs_write_int(bs,	adaptation_field_control, 2);    /*we do not use adaptation field for sections */
-	gf_bs_write_int(bs,	stream->continuity_counter, 4);   /*continuity counter*/
+	//TS header from stream template, no error indicator, no priority, no scrambling
+	pck[0] = stream->ts_hdr_tpl[0];
+	pck[1] = stream->ts_hdr_tpl[1];
+	/* No section concatenation yet!!!*/
+	if (stream->current_section_offset == 0) pck[1] |= 0x40; // payload start indicator
+	pck[2] = stream->ts_hdr_tpl[2];
+	pck[3] = (adaptation_field_control<<4) | (stream->continuity_counter & 0xF);
+	pos = 4;
 
 	if (stream->continuity_counter < 15) stream->continuity_counter++;
 	else stream->continuity_counter=0;
 
 #ifdef USE_AF_STUFFING
 	if (adaptation_field_control != GF_M2TS_ADAPTATION_NONE)
-		gf_m2ts_add_adaptation(stream->program, bs, stream->pid, 0, 0, 0, padding_length, NULL, 0, GF_FALSE);
+		pos += gf_m2ts_add_adaptation(stream->program, pck+pos, stream->pid, 0, 0, 0, padding_length, NULL, 0, GF_FALSE);
 #endif
 
 	/*pointer field*/
 	if (!stream->current_section_offset) {
 		/* no concatenations of sections in ts packets, so start address is 0 */
-		gf_bs_write_u8(bs, 0);
+		pck[pos] = 0;
 	}
 
 	memcpy(packet+188-payload_start, section->data + stream->current_section_offset, payload_length);
@@ -1929,14 +1921,28 @@ static u32 gf_m2ts_stream_get_pes_header_length(GF_M2TS_Mux_Stream *stream)
 	return hdr_len;
 }
 
-u32 gf_m2ts_stream_add_pes_header(GF_BitStream *bs, GF_M2TS_Mux_Stream *stream)
+/*writes a 33 bit timestamp with its 4 bit prefix and marker bits*/
+static GFINLINE void gf_m2ts_write_pes_ts(u8 *ptr, u8 prefix, u64 ts)
+{
+	ptr[0] = (u8) ( (prefix<<4) | (((ts >> 30) & 0x7) << 1) | 1);
+	ptr[1] = (u8) (ts >> 22);
+	ptr[2] = (u8) ( (((ts >> 15) & 0x7f) << 1) | 1);
+	ptr[3] = (u8) (ts >> 7);
+	ptr[4] = (u8) ( ((ts & 0x7f) << 1) | 1);
+}
+
+/*writes PES header directly in the packet buffer, returns number of bytes written*/
+static u32 gf_m2ts_stream_add_pes_header(u8 *ptr, GF_M2TS_Mux_Stream *stream)
 {
-	u64 t, dts, cts;
-	u32 pes_len;
+	u64 dts, cts;
+	u32 pes_len, pos;
 	Bool use_pts, use_dts;
 
-	gf_bs_write_int(bs,	0x1, 24);//packet start code
-	gf_bs_write_u8(bs,	stream->mpeg2_stream_id);// stream id
+	//packet start code and stream id
+	ptr[0] = 0;
+	ptr[1] = 0;
+	ptr[2] = 1;
+	ptr[3] = (u8) stream->mpeg2_stream_id;
 
 	/*next AU start in current PES and current AU began in previous PES, use next AU timing*/
 	if (stream->pck_offset && stream->copy_from_next_packets) {
@@ -1963,54 +1969,33 @@ u32 gf_m2ts_stream_add_pes_header(GF_BitStream *bs, GF_M2TS_Mux_Stream *stream)
 	if (use_dts) pes_len += 5;
 
 	if (pes_len>0xFFFF) pes_len = 0;
-	gf_bs_write_int(bs, pes_len, 16); // pes packet length
+	ptr[4] = (u8) (pes_len >> 8); // pes packet length
+	ptr[5] = (u8) pes_len;
 
-	gf_bs_write_int(bs, 0x2, 2); // reserved
-	gf_bs_write_int(bs, 0x0, 2); // scrambling
-	gf_bs_write_int(bs, 0x0, 1); // priority
-	gf_bs_write_int(bs, stream->pck_offset ? 0 : 1, 1); // alignment indicator - we could also check start codes to see if we are aligned at slice/video packet level
-	gf_bs_write_int(bs, 0x0, 1); // copyright
-	gf_bs_write_int(bs, 0x0, 1); // original or copy
-
-	gf_bs_write_int(bs, use_pts, 1);
-	gf_bs_write_int(bs, use_dts, 1);
-	gf_bs_write_int(bs, 0x0, 6); //6 flags = 0 (ESCR, ES_rate, DSM_trick, additional_copy, PES_CRC, PES_extension)
-
-	gf_bs_write_int(bs, use_dts*5+use_pts*5, 8);
+	//'10', no scrambling, no priority, alignment indicator, no copyright, copy
+	//alignment: we could also check start codes to see if we are aligned at slice/video packet level
+	ptr[6] = stream->pck_offset ? 0x80 : 0x84;
+	//PTS and DTS flags, other 6 flags = 0 (ESCR, ES_rate, DSM_trick, additional_copy, PES_CRC, PES_extension)
+	ptr[7] = (use_pts ? 0x80 : 0) | (use_dts ? 0x40 : 0);
+	ptr[8] = (u8) (use_dts*5+use_pts*5);
+	pos = 9;
 
 	if (use_pts) {
-		gf_bs_write_int(bs, use_dts ? 0x3 : 0x2, 4); // reserved '0011' || '0010'
-		t = ((cts >> 30) & 0x7);
-		gf_bs_write_long_int(bs, t, 3);
-		gf_bs_write_int(bs, 1, 1); // marker bit
-		t = ((cts >> 15) & 0x7fff);
-		gf_bs_write_long_int(bs, t, 15);
-		gf_bs_write_int(bs, 1, 1); // marker bit
-		t = cts & 0x7fff;
-		gf_bs_write_long_int(bs, t, 15);
-		gf_bs_write_int(bs, 1, 1); // marker bit
+		gf_m2ts_write_pes_ts(ptr+pos, use_dts ? 0x3 : 0x2, cts); // reserved '0011' || '0010'
+		pos += 5;
 	}
-
 	if (use_dts) {
-		gf_bs_write_int(bs, 0x1, 4); // reserved '0001'
-		t = ((dts >> 30) & 0x7);
-		gf_bs_write_long_int(bs, t, 3);
-		gf_bs_write_int(bs, 1, 1); // marker bit
-		t = ((dts >> 15) & 0x7fff);
-		gf_bs_write_long_int(bs, t, 15);
-		gf_bs_write_int(bs, 1, 1); // marker bit
-		t = dts & 0x7fff;
-		gf_bs_write_long_int(bs, t, 15);
-		gf_bs_write_int(bs, 1, 1); // marker bit
+		gf_m2ts_write_pes_ts(ptr+pos, 0x1, dts); // reserved '0001'
+		pos += 5;
 	}
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[MPEG-2 TS Muxer] PID %d: Adding PES header at PCR "LLD" - has PTS %d ("LLU") - has DTS %d ("LLU") - Payload length %d\n", stream->pid, gf_m2ts_get_pcr(stream)/300, use_pts, cts, use_dts, dts, pes_len));
 
-	return pes_len+4; // 4 = start code + stream_id
+	return pos;
 }
 
 void gf_m2ts_mux_pes_get_next_packet(GF_M2TS_Mux_Stream *stream, char *packet)
 {
-	GF_BitStream *bs;
+	u8 *pck = (u8 *) packet;
 	Bool needs_pcr, first_pass;
 	u32 adaptation_field_control, payload_length, payload_to_copy, padding_length, hdr_len, pos, copy_next;
 
@@ -2155,27 +2140,13 @@ void gf_m2ts_mux_pes_get_next_packet(GF_M2TS_Mux_Stream *stream, char *packet)
 		else stream->continuity_counter--;
 	}
 
-	bs = stream->program->mux->pck_bs;
-	gf_bs_reassign_buffer(bs, packet, 188);
-
-	//small opt for formatting TS header for PES, don't use bitstream for header, slightly faster
-#if 0
-	gf_bs_write_int(bs,	0x47, 8); // sync byte
-	gf_bs_write_int(bs,	0, 1);    // error indicator
-	gf_bs_write_int(bs,	hdr_len ? 1 : 0, 1); // start ind
-	gf_bs_write_int(bs,	0, 1);	  // transport priority
-	gf_bs_write_int(bs,	stream->pid, 13); // pid
-	gf_bs_write_int(bs,	0, 2);    // scrambling
-	gf_bs_write_int(bs,	adaptation_field_control, 2);    // we do not use adaptation field for sections
-	gf_bs_write_int(bs,	stream->continuity_counter, 4);   // continuity counter
-#else
-	packet[0] = 0x47; // sync byte
-	packet[1] = (stream->pid>>8) & 0x1F; //high bits of PID
-	if (hdr_len) packet[1] |= 0x40; // start ind
-	packet[2] = stream->pid & 0xFF; //low bits of PID
-	packet[3] = (adaptation_field_control<<4) | (stream->continuity_counter & 0xF); //AF + CC
-	gf_bs_seek(bs, 4);
-#endif
+	//TS header from stream template, no error indicator, no priority, no scrambling
+	pck[0] = stream->ts_hdr_tpl[0];
+	pck[1] = stream->ts_hdr_tpl[1];
+	if (hdr_len) pck[1] |= 0x40; // start ind
+	pck[2] = stream->ts_hdr_tpl[2];
+	pck[3] = (adaptation_field_control<<4) | (stream->continuity_counter & 0xF); //AF + CC
+	pos = 4;
 
 	if (stream->continuity_counter < 15) stream->continuity_counter++;
 	else stream->continuity_counter=0;
@@ -2216,7 +2187,7 @@ void gf_m2ts_mux_pes_get_next_packet(GF_M2TS_Mux_Stream *stream, char *packet)
 			stream->program->nb_pck_last_pcr = stream->program->mux->tot_pck_sent;
 		}
 		is_rap = (hdr_len && (stream->curr_pck.sap_type) ) ? GF_TRUE : GF_FALSE;
-		gf_m2ts_add_adaptation(stream->program, bs, stream->pid, needs_pcr, pcr, is_rap, padding_length, hdr_len ? stream->curr_pck.mpeg2_af_descriptors : NULL, hdr_len ? stream->curr_pck.mpeg2_af_descriptors_size : 0, stream->set_initial_disc);
+		pos += gf_m2ts_add_adaptation(stream->program, pck+pos, stream->pid, needs_pcr, pcr, is_rap, padding_length, hdr_len ? stream->curr_pck.mpeg2_af_descriptors : NULL, hdr_len ? stream->curr_pck.mpeg2_af_descriptors_size : 0, stream->set_initial_disc);
 		stream->set_initial_disc = GF_FALSE;
 
 		if (stream->curr_pck.mpeg2_af_descriptors) {
@@ -2231,15 +2202,13 @@ void gf_m2ts_mux_pes_get_next_packet(GF_M2TS_Mux_Stream *stream, char *packet)
 	stream->pck_sap_type = 0;
 	stream->pck_sap_time = 0;
 	if (hdr_len) {
-		gf_m2ts_stream_add_pes_header(bs, stream);
+		pos += gf_m2ts_stream_add_pes_header(pck+pos, stream);
 		if (stream->curr_pck.sap_type) {
 			stream->pck_sap_type = 1;
 			stream->pck_sap_time = stream->curr_pck.cts;
 		}
 	}
 
-	pos = (u32) gf_bs_get_position(bs);
-
 	if (adaptation_field_control == GF_M2TS_ADAPTATION_ONLY) {
 		return;
 	}
@@ -2374,6 +2343,9 @@ GF_M2TS_Mux_Stream *gf_m2ts_stream_new(u32 pid) {
 		return NULL;
 	}
 	stream->pid = pid;
+	stream->ts_hdr_tpl[0] = 0x47; // sync byte
+	stream->ts_hdr_tpl[1] = (pid>>8) & 0x1F; //high bits of PID
+	stream->ts_hdr_tpl[2] = pid & 0xFF; //low bits of PID
 	stream->process = gf_m2ts_stream_process_pes;
 
 	return stream;
@@ -28,6 +28,7 @@
 #include <gpac/internal/m3u8.h>
 #include <gpac/network.h>
 #include <gpac/maths.h>
+#include <gpac/thread.h>
 
 #ifndef GPAC_DISABLE_MPD
 
@@ -1309,6 +1310,7 @@ void gf_mpd_representation_free(void *_item)
 	}
 	if (ptr->m3u8_var_name) gf_free(ptr->m3u8_var_name);
 	if (ptr->m3u8_var_file) gf_fclose(ptr->m3u8_var_file);
+	if (ptr->m3u8_seg_cache) gf_free(ptr->m3u8_seg_cache);
 	if (ptr->res_url) gf_free(ptr->res_url);
 	gf_free(ptr);
 }
@@ -1353,6 +1355,8 @@ void gf_mpd_period_free(void *_item)
 	gf_free(ptr);
 }
 
+static void gf_mpd_m3u8_pool_del(void *_pool);
+
 GF_EXPORT
 void gf_mpd_del(GF_MPD *mpd)
 {
@@ -1374,6 +1378,7 @@ void gf_mpd_del(GF_MPD *mpd)
 	gf_mpd_del_list(mpd->utc_timings, gf_mpd_descriptor_free, 0);
 	gf_mpd_del_list(mpd->essential_properties, gf_mpd_descriptor_free, 0);
 	gf_mpd_del_list(mpd->supplemental_properties, gf_mpd_descriptor_free, 0);
+	if (mpd->m3u8_pool) gf_mpd_m3u8_pool_del(mpd->m3u8_pool);
 	MPD_FREE_EXTENSION_NODE(mpd);
 	gf_free(mpd);
 }
@@ -3707,25 +3712,89 @@ static const char *gf_mpd_m3u8_get_init_seg(const GF_MPD_Period *period, const G
 	return url;
 }
 
-static GF_Err gf_mpd_write_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period *period, const GF_MPD_AdaptationSet *as, GF_MPD_Representation *rep, char *m3u8_name, u32 hls_version, Double max_part_dur_session, const char *force_base_url)
+/*HLS media playlists are fully rewritten at each update of a live session, but the EXTINF and URI lines of completed segments never change:
+we keep these serialized per representation, append new completed segments and drop the head as the timeshift buffer moves
+This only applies to HLS, the DASH SegmentTimeline is serialized from its run-length compacted entries*/
+static u32 gf_mpd_m3u8_seg_cache_get(GF_MPD_Representation *rep, u32 count, u32 *cache_start)
+{
+	u32 idx;
+	u64 start;
+	GF_DASH_SegmentContext *first = gf_list_get(rep->state_seg_list, rep->tsb_first_entry);
+
+	*cache_start = 0;
+	if (!first || !rep->m3u8_seg_cache_size || !rep->m3u8_seg_cache_sctx) goto reset;
+	if ((first->seg_num < rep->m3u8_seg_cache_first) || (first->seg_num > rep->m3u8_seg_cache_last)) goto reset;
+	if ((first->m3u8_cache_pos < rep->m3u8_seg_cache_base) || (first->m3u8_cache_pos >= rep->m3u8_seg_cache_base + rep->m3u8_seg_cache_size)) goto reset;
+	//segment numbers are contiguous in the cache, check the last cached entry is where we expect it
+	idx = rep->tsb_first_entry + rep->m3u8_seg_cache_last - first->seg_num;
+	if ((idx >= count) || (gf_list_get(rep->state_seg_list, idx) != rep->m3u8_seg_cache_sctx)) goto reset;
+
+	start = first->m3u8_cache_pos - rep->m3u8_seg_cache_base;
+	//drop purged entries once they use more than half of the cache
+	if (start > rep->m3u8_seg_cache_size/2) {
+		memmove(rep->m3u8_seg_cache, rep->m3u8_seg_cache + start, (size_t) (rep->m3u8_seg_cache_size - start));
+		rep->m3u8_seg_cache_size -= (u32) start;
+		rep->m3u8_seg_cache_base += start;
+		rep->m3u8_seg_cache_first = first->seg_num;
+		start = 0;
+	}
+	*cache_start = (u32) start;
+	return idx+1;
+
+reset:
+	rep->m3u8_seg_cache_base += rep->m3u8_seg_cache_size;
+	rep->m3u8_seg_cache_size = 0;
+	rep->m3u8_seg_cache_sctx = NULL;
+	return rep->tsb_first_entry;
+}
+
+static GF_Err gf_mpd_m3u8_seg_cache_append(GF_MPD_Representation *rep, GF_DASH_SegmentContext *sctx, Double dur)
+{
+	char szInf[100];
+	u32 len_inf, len_name, size;
+
+	snprintf(szInf, 100, "#EXTINF:%g,\n", dur);
+	szInf[99] = 0;
+	len_inf = (u32) strlen(szInf);
+	len_name = (u32) strlen(sctx->filename);
+	size = rep->m3u8_seg_cache_size + len_inf + len_name + 1;
+	if (size > rep->m3u8_seg_cache_alloc) {
+		u32 alloc = MAX(size, 2*rep->m3u8_seg_cache_alloc);
+		char *cache = gf_realloc(rep->m3u8_seg_cache, alloc);
+		if (!cache) return GF_OUT_OF_MEM;
+		rep->m3u8_seg_cache = cache;
+		rep->m3u8_seg_cache_alloc = alloc;
+	}
+	if (!rep->m3u8_seg_cache_size) rep->m3u8_seg_cache_first = sctx->seg_num;
+	sctx->m3u8_cache_pos = rep->m3u8_seg_cache_base + rep->m3u8_seg_cache_size;
+	memcpy(rep->m3u8_seg_cache + rep->m3u8_seg_cache_size, szInf, len_inf);
+	memcpy(rep->m3u8_seg_cache + rep->m3u8_seg_cache_size + len_inf, sctx->filename, len_name);
+	rep->m3u8_seg_cache[size-1] = '\n';
+	rep->m3u8_seg_cache_size = size;
+	rep->m3u8_seg_cache_last = sctx->seg_num;
+	rep->m3u8_seg_cache_sctx = sctx;
+	return GF_OK;
+}
+
+static FILE *gf_mpd_open_m3u8_playlist(const GF_MPD *mpd, GF_MPD_Representation *rep, char *m3u8_name)
+{
+	FILE *out;
+	if (!strcmp(m3u8_name, "std")) return stdout;
+	if (mpd->create_m3u8_files) return gf_fopen(m3u8_name, "wb");
+
+	out = gf_file_temp(NULL);
+	if (rep->m3u8_var_file) gf_fclose(rep->m3u8_var_file);
+	rep->m3u8_var_file = out;
+	return out;
+}
+
+//date_mx is set when several playlists are printed in parallel, to protect the non-reentrant date formatting
+static void gf_mpd_print_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period *period, const GF_MPD_AdaptationSet *as, GF_MPD_Representation *rep, FILE *out, char *m3u8_name, u32 hls_version, Double max_part_dur_session, const char *force_base_url, GF_Mutex *date_mx)
 {
 	u32 i, count;
 	GF_DASH_SegmentContext *sctx;
-	FILE *out;
 	char *force_url=NULL;
 	const char *last_kms = NULL;
-	Bool close_file = GF_FALSE;
-
-	if (!strcmp(m3u8_name, "std")) out = stdout;
-	else if (mpd->create_m3u8_files) {
-		out = gf_fopen(m3u8_name, "wb");
-		if (!out) return GF_IO_ERR;
-		close_file = GF_TRUE;
-	} else {
-		out = gf_file_temp(NULL);
-		if (rep->m3u8_var_file) gf_fclose(rep->m3u8_var_file);
-		rep->m3u8_var_file = out;
-	}
 
 	count = gf_list_count(rep->state_seg_list);
 	sctx = gf_list_get(rep->state_seg_list, rep->tsb_first_entry);
@@ -3755,12 +3824,17 @@ static GF_Err gf_mpd_write_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period
 		u64 seg_ast = mpd->availabilityStartTime;
 		seg_ast += (sctx->time * 1000) / rep->timescale_mpd;
 		gf_fprintf(out, "#EXT-X-PROGRAM-DATE-TIME:");
+		if (date_mx) gf_mx_p(date_mx);
 		gf_mpd_print_date(out, NULL, seg_ast);
+		if (date_mx) gf_mx_v(date_mx);
 		gf_fprintf(out, "\n");
 	}
 
 
 	if (sctx && sctx->filename) {
+		//cache is only used for plain segment lines
+		Bool use_cache = (!rep->crypto_type && !force_base_url) ? GF_TRUE : GF_FALSE;
+
 		if (as->intra_only) {
 			gf_fprintf(out,"#EXT-X-I-FRAMES-ONLY\n");
 		}
@@ -3776,7 +3850,15 @@ static GF_Err gf_mpd_write_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period
 			}
 		}
 
-		for (i=rep->tsb_first_entry; i<count; i++) {
+		i = rep->tsb_first_entry;
+		if (use_cache) {
+			u32 cache_start;
+			i = gf_mpd_m3u8_seg_cache_get(rep, count, &cache_start);
+			if (rep->m3u8_seg_cache_size)
+				gf_fwrite(rep->m3u8_seg_cache + cache_start, rep->m3u8_seg_cache_size - cache_start, out);
+		}
+
+		for (; i<count; i++) {
 			Double dur;
 			sctx = gf_list_get(rep->state_seg_list, i);
 			gf_assert(sctx->filename);
@@ -3856,11 +3938,8 @@ static GF_Err gf_mpd_write_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period
 					gf_fprintf(out, "\n");
 				}
 				//live edge not done yet
-				if (!sctx->llhls_mode) {
-					if (close_file)
-						gf_fclose(out);
-					return GF_OK;
-				}
+				if (!sctx->llhls_mode)
+					return;
 			}
 
 			//live edge seg not done yet, do not write EXTINF and stop writing
@@ -3926,12 +4005,21 @@ static GF_Err gf_mpd_write_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period
 					}
 				}
 
-				if (close_file)
-					gf_fclose(out);
-				return GF_OK;
+				return;
 			}
 			dur = (Double) sctx->dur;
 			dur /= rep->timescale;
+
+			//segment is done and no longer has parts listed, it will not change anymore
+			if (use_cache && (i+1<count) && (!sctx->llhls_mode || (mpd->type != GF_MPD_TYPE_DYNAMIC) || (i+4<count))) {
+				u32 pos = rep->m3u8_seg_cache_size;
+				if (gf_mpd_m3u8_seg_cache_append(rep, sctx, dur) == GF_OK) {
+					gf_fwrite(rep->m3u8_seg_cache + pos, rep->m3u8_seg_cache_size - pos, out);
+					continue;
+				}
+			}
+			use_cache = GF_FALSE;
+
 			gf_fprintf(out,"#EXTINF:%g,\n", dur);
 
 			if (force_base_url)
@@ -3999,14 +4087,199 @@ static GF_Err gf_mpd_write_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period
 
 	if (mpd->type != GF_MPD_TYPE_DYNAMIC)
 		gf_fprintf(out,"\n#EXT-X-ENDLIST\n");
+}
 
-	if (close_file)
-		gf_fclose(out);
+static GF_Err gf_mpd_write_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period *period, const GF_MPD_AdaptationSet *as, GF_MPD_Representation *rep, char *m3u8_name, u32 hls_version, Double max_part_dur_session, const char *force_base_url)
+{
+	FILE *out = gf_mpd_open_m3u8_playlist(mpd, rep, m3u8_name);
+	if (!out) return GF_IO_ERR;
+
+	gf_mpd_print_m3u8_playlist(mpd, period, as, rep, out, m3u8_name, hls_version, max_part_dur_session, force_base_url, NULL);
 
+	if (mpd->create_m3u8_files && (out != stdout))
+		gf_fclose(out);
 	return GF_OK;
 }
 
 
+typedef struct
+{
+	const GF_MPD_AdaptationSet *as;
+	GF_MPD_Representation *rep;
+	char *name;
+	FILE *out;
+} M3U8PlaylistJob;
+
+typedef struct
+{
+	const GF_MPD *mpd;
+	const GF_MPD_Period *period;
+	u32 hls_version;
+	Double max_part_dur_session;
+	const char *force_base_url;
+	M3U8PlaylistJob *jobs;
+	u32 nb_jobs, next_job;
+	GF_Mutex *mx;
+} M3U8PlaylistWriter;
+
+static u32 gf_mpd_m3u8_playlist_worker(void *par)
+{
+	M3U8PlaylistWriter *w = (M3U8PlaylistWriter *)par;
+	while (1) {
+		M3U8PlaylistJob *job;
+		gf_mx_p(w->mx);
+		job = (w->next_job < w->nb_jobs) ? &w->jobs[w->next_job] : NULL;
+		w->next_job++;
+		gf_mx_v(w->mx);
+		if (!job) break;
+
+		gf_mpd_print_m3u8_playlist(w->mpd, w->period, job->as, job->rep, job->out, job->name, w->hls_version, w->max_part_dur_session, w->force_base_url, w->mx);
+	}
+	return 0;
+}
+
+//threads writing variant playlists, kept for the lifetime of the MPD and woken up at each playlist update
+typedef struct
+{
+	GF_Thread **threads;
+	u32 nb_threads;
+	//one start token per thread to use for an update, one done token per thread when finished
+	GF_Semaphore *start, *done;
+	M3U8PlaylistWriter *w;
+	Bool run;
+} M3U8WriterPool;
+
+static u32 gf_mpd_m3u8_pool_thread(void *par)
+{
+	M3U8WriterPool *pool = (M3U8WriterPool *)par;
+	while (1) {
+		gf_sema_wait(pool->start);
+		if (!pool->run) break;
+		gf_mpd_m3u8_playlist_worker(pool->w);
+		gf_sema_notify(pool->done, 1);
+	}
+	return 0;
+}
+
+static void gf_mpd_m3u8_pool_del(void *_pool)
+{
+	u32 i;
+	M3U8WriterPool *pool = (M3U8WriterPool *)_pool;
+	pool->run = GF_FALSE;
+	if (pool->nb_threads) gf_sema_notify(pool->start, pool->nb_threads);
+	for (i=0; i<pool->nb_threads; i++) {
+		gf_th_stop(pool->threads[i]);
+		gf_th_del(pool->threads[i]);
+	}
+	if (pool->threads) gf_free(pool->threads);
+	if (pool->start) gf_sema_del(pool->start);
+	if (pool->done) gf_sema_del(pool->done);
+	gf_free(pool);
+}
+
+static M3U8WriterPool *gf_mpd_m3u8_pool_new(u32 nb_threads)
+{
+	u32 i;
+	M3U8WriterPool *pool;
+	GF_SAFEALLOC(pool, M3U8WriterPool);
+	if (!pool) return NULL;
+	pool->start = gf_sema_new(GF_INT_MAX, 0);
+	pool->done = gf_sema_new(GF_INT_MAX, 0);
+	pool->threads = gf_malloc(sizeof(GF_Thread *) * nb_threads);
+	if (!pool->start || !pool->done || !pool->threads) {
+		gf_mpd_m3u8_pool_del(pool);
+		return NULL;
+	}
+	pool->run = GF_TRUE;
+	for (i=0; i<nb_threads; i++) {
+		GF_Thread *th = gf_th_new("M3U8Writer");
+		if (th && (gf_th_run(th, gf_mpd_m3u8_pool_thread, pool) != GF_OK)) {
+			gf_th_del(th);
+			th = NULL;
+		}
+		if (th) pool->threads[pool->nb_threads++] = th;
+	}
+	return pool;
+}
+
+/*media playlists of different representations only depend on their own segment states: print them in parallel, temp files being opened
+and closed by the calling thread. Returns GF_NOT_SUPPORTED if playlists shall be written by the calling thread*/
+static GF_Err gf_mpd_write_m3u8_playlists_threaded(const GF_MPD *mpd, const GF_MPD_Period *period, u32 hls_version, Double max_part_dur_session, const char *force_base_url)
+{
+	u32 i, j, nb_th;
+	GF_MPD_AdaptationSet *as;
+	GF_MPD_Representation *rep;
+	M3U8WriterPool *pool;
+	M3U8PlaylistWriter w;
+
+	if ((mpd->m3u8_threads<=1) || mpd->create_m3u8_files) return GF_NOT_SUPPORTED;
+
+	memset(&w, 0, sizeof(M3U8PlaylistWriter));
+	i=0;
+	while ( (as = (GF_MPD_AdaptationSet *) gf_list_enum(period->adaptation_sets, &i))) {
+		j=0;
+		while ( (rep = (GF_MPD_Representation *) gf_list_enum(as->representations, &j))) {
+			if (!mpd->allow_empty_reps && (!rep->state_seg_list || !gf_list_count(rep->state_seg_list) ))
+				continue;
+			if (rep->m3u8_name && !strcmp(rep->m3u8_name, "std")) return GF_NOT_SUPPORTED;
+			w.nb_jobs++;
+		}
+	}
+	if (w.nb_jobs<2) return GF_NOT_SUPPORTED;
+
+	w.jobs = gf_malloc(sizeof(M3U8PlaylistJob) * w.nb_jobs);
+	if (!w.jobs) return GF_OUT_OF_MEM;
+	w.nb_jobs = 0;
+	i=0;
+	while ( (as = (GF_MPD_AdaptationSet *) gf_list_enum(period->adaptation_sets, &i))) {
+		j=0;
+		while ( (rep = (GF_MPD_Representation *) gf_list_enum(as->representations, &j))) {
+			M3U8PlaylistJob *job;
+			if (!mpd->allow_empty_reps && (!rep->state_seg_list || !gf_list_count(rep->state_seg_list) )) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[M3U8] No segment state in representation, MPD cannot be translated to M3U8, ignoring representation\n"));
+				continue;
+			}
+			job = &w.jobs[w.nb_jobs];
+			job->as = as;
+			job->rep = rep;
+			job->name = (char *) rep->m3u8_name;
+			if (!job->name) job->name = gf_file_basename(rep->m3u8_var_name);
+			job->out = gf_mpd_open_m3u8_playlist(mpd, rep, job->name);
+			if (!job->out) {
+				gf_free(w.jobs);
+				return GF_IO_ERR;
+			}
+			w.nb_jobs++;
+		}
+	}
+	w.mpd = mpd;
+	w.period = period;
+	w.hls_version = hls_version;
+	w.max_part_dur_session = max_part_dur_session;
+	w.force_base_url = force_base_url;
+	w.mx = gf_mx_new("M3U8Writer");
+
+	//threads are created at first update, calling thread is one of the workers
+	pool = (M3U8WriterPool *) mpd->m3u8_pool;
+	if (!pool) {
+		pool = gf_mpd_m3u8_pool_new(mpd->m3u8_threads - 1);
+		((GF_MPD *) mpd)->m3u8_pool = pool;
+	}
+	nb_th = pool ? MIN(pool->nb_threads, w.nb_jobs - 1) : 0;
+	if (nb_th) {
+		pool->w = &w;
+		gf_sema_notify(pool->start, nb_th);
+	}
+	gf_mpd_m3u8_playlist_worker(&w);
+
+	//wait for workers to be done with this update
+	for (i=0; i<nb_th; i++)
+		gf_sema_wait(pool->done);
+	gf_mx_del(w.mx);
+	gf_free(w.jobs);
+	return GF_OK;
+}
+
 GF_Err gf_mpd_write_m3u8_master_playlist(GF_MPD const * const mpd, FILE *out, const char* m3u8_name, GF_MPD_Period *period, GF_M3U8WriteMode mode)
 {
 	u32 i, j, hls_version;
@@ -4175,7 +4448,15 @@ GF_Err gf_mpd_write_m3u8_master_playlist(GF_MPD const * const mpd, FILE *out, co
 	}
 
 	//second pass, generate all subplaylists
-	i=0;
+	e = GF_NOT_SUPPORTED;
+	if (mode!=GF_M3U8_WRITE_MASTER)
+		e = gf_mpd_write_m3u8_playlists_threaded(mpd, period, hls_version, max_part_dur_session,
+			((mpd->hls_abs_url==1) || (mpd->hls_abs_url==3)) ? force_base_url : NULL);
+	if (e && (e!=GF_NOT_SUPPORTED)) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[M3U8] IO error while opening m3u8 files\n"));
+		return GF_IO_ERR;
+	}
+	i = (e==GF_OK) ? gf_list_count(period->adaptation_sets) : 0;
 	while ( (as = (GF_MPD_AdaptationSet *) gf_list_enum(period->adaptation_sets, &i))) {
 		j=0;
 		while ( (rep = (GF_MPD_Representation *) gf_list_enum(as->representations, &j))) {
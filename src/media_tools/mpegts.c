@@ -2757,11 +2757,39 @@ static GF_Err gf_m2ts_process_packet(GF_M2TS_Demuxer *ts, unsigned char *data)
 	return GF_OK;
 }
 
+/*checks if a packet can be dropped without parsing its header and adaptation field, i.e. packets with no side effect on demuxer state:
+- null packets
+- packets of PES streams not being reframed (skipped programs / stopped PIDs)
+- packets of undeclared PIDs outside the PSI/SI range
+Packets carrying a PCR are never dropped
+*/
+static GFINLINE Bool gf_m2ts_packet_discardable(GF_M2TS_Demuxer *ts, const u8 *data)
+{
+	GF_M2TS_ES *es;
+	u32 pid;
+	//transport error, use regular path for logs
+	if (data[1] & 0x80) return GF_FALSE;
+	pid = ((data[1]&0x1f) << 8) | data[2];
+	if (pid == 0x1FFF) return GF_TRUE;
+	//adaptation field with PCR
+	if ((data[3] & 0x20) && data[4] && (data[5] & 0x10)) return GF_FALSE;
+
+	es = ts->ess[pid];
+	if (!es) {
+		//PSI/SI PIDs
+		if (pid < 0x20) return GF_FALSE;
+		return GF_TRUE;
+	}
+	if (!(es->flags & GF_M2TS_ES_IS_PES)) return GF_FALSE;
+	if (((GF_M2TS_PES *)es)->reframe) return GF_FALSE;
+	return GF_TRUE;
+}
+
 GF_EXPORT
 GF_Err gf_m2ts_process_data(GF_M2TS_Demuxer *ts, u8 *data, u32 data_size)
 {
 	GF_Err e=GF_OK;
-	u32 pos, pck_size;
+	u32 pos, pck_size, i, nb_pck, nb_sync;
 	Bool is_align = 1;
 
 	if (ts->buffer_size) {
@@ -2838,12 +2866,32 @@ GF_Err gf_m2ts_process_data(GF_M2TS_Demuxer *ts, u8 *data, u32 data_size)
 			}
 			return e;
 		}
-		/*process*/
-		GF_Err pck_e = gf_m2ts_process_packet(ts, (unsigned char *)data + pos);
-		if (pck_e==GF_NOT_SUPPORTED) pck_e = GF_OK;
-		e |= pck_e;
+		/*validate sync bytes of all complete packets in the block first, so that the classification loop below runs on a known-good run*/
+		nb_pck = (data_size - pos) / pck_size;
+		for (nb_sync=0; nb_sync<nb_pck; nb_sync++) {
+			if (data[pos + nb_sync*pck_size] != 0x47) break;
+		}
+		/*sync lost, process packet through regular path for error reporting*/
+		if (!nb_sync) {
+			GF_Err pck_e = gf_m2ts_process_packet(ts, (unsigned char *)data + pos);
+			if (pck_e==GF_NOT_SUPPORTED) pck_e = GF_OK;
+			e |= pck_e;
+			pos += pck_size;
+			continue;
+		}
 
-		pos += pck_size;
+		/*process run, dropping packets of unused PIDs before any parsing*/
+		for (i=0; i<nb_sync; i++) {
+			u8 *pck = data + pos;
+			pos += pck_size;
+			if (!ts->split_mode && gf_m2ts_packet_discardable(ts, pck)) {
+				ts->pck_number++;
+				continue;
+			}
+			GF_Err pck_e = gf_m2ts_process_packet(ts, (unsigned char *)pck);
+			if (pck_e==GF_NOT_SUPPORTED) pck_e = GF_OK;
+			e |= pck_e;
+		}
 	}
 	return e;
 }
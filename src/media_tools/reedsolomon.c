@@ -16,8 +16,6 @@
 #include <gpac/tools.h>
 #include <gpac/internal/reedsolomon.h>
 
-#ifdef GPAC_ENABLE_MPE
-
 
 /* This is one of 14 irreducible polynomials
  * of degree 8 and cycle length 255. (Ch 5, pp. 275, Magnetic Recording)
@@ -94,6 +92,7 @@ int ginv (int elt)
 	return (gexp[255-glog[elt]]);
 }
 
+#ifdef GPAC_ENABLE_MPE
 
 
 /***********************************************************************
@@ -575,3 +574,159 @@ encode_data (unsigned char msg[], int nbytes, unsigned char dst[])
 }
 
 #endif //GPAC_ENABLE_MPE
+
+
+/***********************************************************************
+ * Systematic erasure code over GF(256) for application-layer FEC
+ *
+ * Repair symbol of encoding symbol ID esi (k <= esi < 255) is sum(C[esi][j] * src_j) for the k source symbols
+ * of the block, with C[x][y] = 1/(x+y) a Cauchy matrix. Any square sub-matrix of a Cauchy matrix is invertible,
+ * so any k symbols among the source and repair symbols of a block recover the block.
+ *
+ * Multiplication tables are computed on first use and never modified afterwards.
+ */
+
+static u8 fec_mul[256][256];
+static u8 fec_inv[256];
+static Bool fec_init_done = GF_FALSE;
+
+static void gf_rs_fec_init()
+{
+	u32 a, b;
+	if (fec_init_done) return;
+	init_galois_tables();
+	for (a=0; a<256; a++) {
+		for (b=0; b<256; b++) {
+			fec_mul[a][b] = (u8) gmult(a, b);
+		}
+		fec_inv[a] = a ? (u8) ginv(a) : 0;
+	}
+	fec_init_done = GF_TRUE;
+}
+
+//dst += c*src
+static void gf_rs_fec_addmul(u8 *dst, const u8 *src, u8 c, u32 size)
+{
+	u32 i;
+	const u8 *mul;
+	if (!c) return;
+	if (c==1) {
+		for (i=0; i<size; i++) dst[i] ^= src[i];
+		return;
+	}
+	mul = fec_mul[c];
+	for (i=0; i<size; i++) dst[i] ^= mul[src[i]];
+}
+
+//dst *= c
+static void gf_rs_fec_scale(u8 *dst, u8 c, u32 size)
+{
+	u32 i;
+	const u8 *mul;
+	if (c==1) return;
+	mul = fec_mul[c];
+	for (i=0; i<size; i++) dst[i] = mul[dst[i]];
+}
+
+void gf_rs_fec_encode(u8 **src, u32 k, u32 esi, u8 *repair, u32 symbol_size)
+{
+	u32 j;
+	gf_rs_fec_init();
+	memset(repair, 0, symbol_size);
+	if ((esi<k) || (esi>=255)) return;
+	for (j=0; j<k; j++) {
+		gf_rs_fec_addmul(repair, src[j], fec_inv[esi ^ j], symbol_size);
+	}
+}
+
+GF_Err gf_rs_fec_decode(u8 **src, Bool *present, u32 k, u8 **repair, u32 *esi, u32 nb_repair, u32 symbol_size)
+{
+	u32 i, j, l, nb_miss=0;
+	u8 *mx, **rows;
+	u32 *miss;
+
+	if (!k || (k>=255)) return GF_BAD_PARAM;
+	for (j=0; j<k; j++) {
+		if (!present[j]) nb_miss++;
+	}
+	if (!nb_miss) return GF_OK;
+	if (nb_repair < nb_miss) return GF_NOT_READY;
+
+	gf_rs_fec_init();
+	mx = gf_malloc(sizeof(u8) * nb_miss * nb_miss);
+	rows = gf_malloc(sizeof(u8 *) * nb_miss);
+	miss = gf_malloc(sizeof(u32) * nb_miss);
+	if (!mx || !rows || !miss) {
+		if (mx) gf_free(mx);
+		if (rows) gf_free(rows);
+		if (miss) gf_free(miss);
+		return GF_OUT_OF_MEM;
+	}
+	l=0;
+	for (j=0; j<k; j++) {
+		if (!present[j]) miss[l++] = j;
+	}
+
+	//remove known source symbols from the repair symbols, leaving a system in missing symbols only
+	for (i=0; i<nb_miss; i++) {
+		if ((esi[i]<k) || (esi[i]>=255)) {
+			gf_free(mx);
+			gf_free(rows);
+			gf_free(miss);
+			return GF_NON_COMPLIANT_BITSTREAM;
+		}
+		rows[i] = repair[i];
+		for (j=0; j<k; j++) {
+			if (present[j])
+				gf_rs_fec_addmul(rows[i], src[j], fec_inv[esi[i] ^ j], symbol_size);
+		}
+		for (l=0; l<nb_miss; l++) {
+			mx[i*nb_miss + l] = fec_inv[esi[i] ^ miss[l]];
+		}
+	}
+
+	//Gauss-Jordan elimination, the matrix is a Cauchy matrix and always invertible
+	for (l=0; l<nb_miss; l++) {
+		u8 *pivot = &mx[l*nb_miss];
+		u8 c;
+		for (i=l; i<nb_miss; i++) {
+			if (mx[i*nb_miss + l]) break;
+		}
+		if (i==nb_miss) {
+			gf_free(mx);
+			gf_free(rows);
+			gf_free(miss);
+			return GF_CORRUPTED_DATA;
+		}
+		if (i != l) {
+			u8 *tmp = rows[i];
+			rows[i] = rows[l];
+			rows[l] = tmp;
+			for (j=0; j<nb_miss; j++) {
+				c = mx[i*nb_miss + j];
+				mx[i*nb_miss + j] = pivot[j];
+				pivot[j] = c;
+			}
+		}
+		c = fec_inv[pivot[l]];
+		for (j=0; j<nb_miss; j++) pivot[j] = fec_mul[c][pivot[j]];
+		gf_rs_fec_scale(rows[l], c, symbol_size);
+
+		for (i=0; i<nb_miss; i++) {
+			u8 *row;
+			if (i==l) continue;
+			row = &mx[i*nb_miss];
+			c = row[l];
+			if (!c) continue;
+			for (j=0; j<nb_miss; j++) row[j] ^= fec_mul[c][pivot[j]];
+			gf_rs_fec_addmul(rows[i], rows[l], c, symbol_size);
+		}
+	}
+	for (l=0; l<nb_miss; l++) {
+		memcpy(src[miss[l]], rows[l], symbol_size);
+	}
+	gf_free(mx);
+	gf_free(rows);
+	gf_free(miss);
+	return GF_OK;
+}
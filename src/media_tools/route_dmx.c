@@ -31,8 +31,13 @@
 #include <gpac/bitstream.h>
 #include <gpac/xml.h>
 #include <gpac/thread.h>
+#include <gpac/internal/reedsolomon.h>
 
 #define GF_ROUTE_SOCK_SIZE	0x80000
+//max UDP payload size
+#define GF_ROUTE_PCK_SLOT_SIZE	65536
+//number of LCT packets fetched at once
+#define GF_ROUTE_RECV_BATCH	16
 
 typedef struct
 {
@@ -60,6 +65,8 @@ typedef struct
 	u32 nb_cps;
 	u32 last_dispatched_tsi, last_dispatched_toi;
 	Bool tsi_init;
+	//FEC encoding ID of repair packets sent on this TSI, 0 if none
+	u32 fec_id;
 } GF_ROUTELCTChannel;
 
 typedef enum
@@ -95,6 +102,13 @@ typedef struct
     
     GF_Blob blob;
 	void *udta;
+
+	//AL-FEC: symbol size and max source block length from EXT_FTI, received repair symbols and their (SBN<<8)|ESI
+	u32 fec_sym_size, fec_max_k;
+	u8 *fec_data;
+	u32 *fec_ids;
+	u32 fec_nb_syms, fec_alloc_syms;
+	Bool fec_recovered;
 } GF_LCTObject;
 
 
@@ -141,6 +155,9 @@ struct __gf_routedmx {
 	u32 buffer_size;
 	u8 *unz_buffer;
 	u32 unz_buffer_size;
+	//batch reception of LCT packets
+	u8 *pck_buffer;
+	u32 pck_sizes[GF_ROUTE_RECV_BATCH];
 
 	u32 reorder_timeout;
 	Bool force_reorder;
@@ -167,6 +184,9 @@ struct __gf_routedmx {
 	u64 nb_packets;
 	u64 total_bytes_recv;
 	u64 first_pck_time, last_pck_time;
+	//AL-FEC stats
+	u32 fec_nb_objs;
+	u64 fec_nb_syms, fec_nb_repair;
 
     //for now use a single mutex for all blob access
     GF_Mutex *blob_mx;
@@ -200,6 +220,8 @@ static void gf_route_lct_obj_del(GF_LCTObject *o)
 {
 	if (o->frags) gf_free(o->frags);
 	if (o->payload) gf_free(o->payload);
+	if (o->fec_data) gf_free(o->fec_data);
+	if (o->fec_ids) gf_free(o->fec_ids);
 	gf_free(o);
 }
 
@@ -230,6 +252,7 @@ void gf_route_dmx_del(GF_ROUTEDmx *routedmx)
 	if (!routedmx) return;
 
 	if (routedmx->buffer) gf_free(routedmx->buffer);
+	if (routedmx->pck_buffer) gf_free(routedmx->pck_buffer);
 	if (routedmx->unz_buffer) gf_free(routedmx->unz_buffer);
 	if (routedmx->atsc_sock) gf_sk_del(routedmx->atsc_sock);
     if (routedmx->dom) gf_xml_dom_del(routedmx->dom);
@@ -307,6 +330,13 @@ static GF_ROUTEDmx *gf_route_dmx_new_internal(const char *ifce, u32 sock_buffer_
 		gf_route_dmx_del(routedmx);
 		return NULL;
 	}
+	//only touched pages are used, typical LCT packets use a single page per slot
+	routedmx->pck_buffer = gf_malloc(GF_ROUTE_PCK_SLOT_SIZE * GF_ROUTE_RECV_BATCH);
+	if (!routedmx->pck_buffer) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_ROUTE, ("[ROUTE] Failed to allocate socket buffer\n"));
+		gf_route_dmx_del(routedmx);
+		return NULL;
+	}
 
 	routedmx->active_sockets = gf_sk_group_new();
 	if (!routedmx->active_sockets) {
@@ -627,6 +657,9 @@ static void gf_route_obj_to_reservoir(GF_ROUTEDmx *routedmx, GF_ROUTEService *s,
 	obj->prev_start_offset = 0;
 	obj->download_time_ms = 0;
 	obj->last_gather_time = 0;
+	obj->fec_sym_size = 0;
+	obj->fec_nb_syms = 0;
+	obj->fec_recovered = GF_FALSE;
 	obj->status = GF_LCT_OBJ_INIT;
 	gf_list_del_item(s->objects, obj);
 	gf_list_add(routedmx->object_reservoir, obj);
@@ -727,6 +760,8 @@ static GF_Err gf_route_dmx_process_object(GF_ROUTEDmx *routedmx, GF_ROUTEService
 	}
 	obj->rlct->tsi_init = GF_TRUE;
 	if (obj->status == GF_LCT_OBJ_DISPATCHED) return GF_OK;
+	if (obj->fec_recovered && (obj->status == GF_LCT_OBJ_DONE))
+		routedmx->fec_nb_objs++;
 	obj->status = GF_LCT_OBJ_DISPATCHED;
 
 	if (obj->rlct_file) {
@@ -1038,6 +1073,179 @@ check_done:
 	return gf_route_service_flush_object(s, obj);
 }
 
+//check if the given byte range of the object is received
+static Bool gf_route_obj_has_range(GF_LCTObject *obj, u32 start, u32 end)
+{
+	u32 i;
+	for (i=0; i<obj->nb_frags; i++) {
+		if (obj->frags[i].offset > start) return GF_FALSE;
+		if (obj->frags[i].offset + obj->frags[i].size > start) {
+			start = obj->frags[i].offset + obj->frags[i].size;
+			if (start >= end) return GF_TRUE;
+		}
+	}
+	return GF_FALSE;
+}
+
+//get first source symbol and number of source symbols of a source block, using RFC 5052 partitioning
+static u32 gf_route_fec_block(u32 total_length, u32 sym_size, u32 max_k, u32 sbn, u32 *first_sym)
+{
+	u32 nb_syms = (total_length + sym_size - 1) / sym_size;
+	u32 nb_blocks = (nb_syms + max_k - 1) / max_k;
+	u32 a_large = (nb_syms + nb_blocks - 1) / nb_blocks;
+	u32 a_small = nb_syms / nb_blocks;
+	u32 nb_large = nb_syms - a_small * nb_blocks;
+
+	if (sbn >= nb_blocks) return 0;
+	if (sbn < nb_large) {
+		*first_sym = sbn * a_large;
+		return a_large;
+	}
+	*first_sym = nb_large * a_large + (sbn - nb_large) * a_small;
+	return a_small;
+}
+
+//insert recovered data in the object for the parts of the byte range not yet received
+static GF_Err gf_route_fec_fill(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, GF_LCTObject *obj, u32 start, u32 end, u8 *data, Bool in_order)
+{
+	u32 pos = start;
+	GF_Err e = GF_OK;
+	GF_LCTObject *gather_obj = NULL;
+
+	while (pos < end) {
+		u32 i, gap_end = end;
+		Bool covered = GF_FALSE;
+		for (i=0; i<obj->nb_frags; i++) {
+			u32 f_start = obj->frags[i].offset;
+			u32 f_end = f_start + obj->frags[i].size;
+			if (f_end <= pos) continue;
+			if (f_start <= pos) {
+				pos = f_end;
+				covered = GF_TRUE;
+			} else if (f_start < end) {
+				gap_end = f_start;
+			}
+			break;
+		}
+		if (covered) continue;
+
+		e = gf_route_service_gather_object(routedmx, s, obj->tsi, obj->toi, pos, (char *) data + pos - start, gap_end - pos, obj->total_length, GF_FALSE, in_order, obj->rlct, &gather_obj);
+		if (e) break;
+		pos = gap_end;
+	}
+	return e;
+}
+
+static GF_Err gf_route_service_gather_repair(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, GF_ROUTELCTChannel *rlct, u32 tsi, u32 toi, u32 total_len, u32 sym_size, u32 max_k, u32 sbn, u32 esi, u8 *data, u32 size, Bool in_order)
+{
+	GF_Err e;
+	u8 *block, *src[255], *repair[255];
+	Bool present[255];
+	u32 esis[255];
+	u32 i, k, first_sym=0, nb_miss, nb_repair, fec_id;
+	GF_LCTObject *obj = NULL;
+
+	routedmx->fec_nb_repair++;
+	if (!total_len || !sym_size || !max_k || (max_k>=255) || (size != sym_size)) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_ROUTE, ("[ROUTE] Service %d TSI %u TOI %u invalid FEC repair packet (transfer length %u symbol size %u max block length %u, %u bytes)\n", s->service_id, tsi, toi, total_len, sym_size, max_k, size));
+		return GF_NON_COMPLIANT_BITSTREAM;
+	}
+	//get the object, creating it if no source packet was received yet
+	e = gf_route_service_gather_object(routedmx, s, tsi, toi, 0, NULL, 0, total_len, GF_FALSE, in_order, rlct, &obj);
+	if (e==GF_EOS)
+		return gf_route_dmx_process_object(routedmx, s, obj);
+	if (e || !obj) return e;
+
+	if (!obj->fec_sym_size) {
+		obj->fec_sym_size = sym_size;
+		obj->fec_max_k = max_k;
+	} else if ((obj->fec_sym_size != sym_size) || (obj->fec_max_k != max_k)) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_ROUTE, ("[ROUTE] Service %d TSI %u TOI %u FEC parameters changed, ignoring repair packet\n", s->service_id, tsi, toi));
+		return GF_NON_COMPLIANT_BITSTREAM;
+	}
+	k = gf_route_fec_block(obj->total_length, sym_size, max_k, sbn, &first_sym);
+	if (!k || (esi<k)) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_ROUTE, ("[ROUTE] Service %d TSI %u TOI %u invalid FEC payload ID SBN %u ESI %u\n", s->service_id, tsi, toi, sbn, esi));
+		return GF_NON_COMPLIANT_BITSTREAM;
+	}
+
+	fec_id = (sbn<<8) | esi;
+	for (i=0; i<obj->fec_nb_syms; i++) {
+		if (obj->fec_ids[i] == fec_id) return GF_OK;
+	}
+
+	//check missing source symbols in the block
+	nb_miss = 0;
+	for (i=0; i<k; i++) {
+		u32 start = (first_sym + i) * sym_size;
+		u32 end = MIN(start + sym_size, obj->total_length);
+		present[i] = gf_route_obj_has_range(obj, start, end);
+		if (!present[i]) nb_miss++;
+	}
+	//block complete, repair not needed
+	if (!nb_miss) return GF_OK;
+
+	if (obj->fec_nb_syms == obj->fec_alloc_syms) {
+		obj->fec_alloc_syms = obj->fec_alloc_syms ? 2*obj->fec_alloc_syms : 16;
+		obj->fec_data = gf_realloc(obj->fec_data, obj->fec_alloc_syms * sym_size);
+		obj->fec_ids = gf_realloc(obj->fec_ids, obj->fec_alloc_syms * sizeof(u32));
+		if (!obj->fec_data || !obj->fec_ids) {
+			obj->fec_nb_syms = obj->fec_alloc_syms = 0;
+			return GF_OUT_OF_MEM;
+		}
+	}
+	memcpy(obj->fec_data + obj->fec_nb_syms * sym_size, data, sym_size);
+	obj->fec_ids[obj->fec_nb_syms] = fec_id;
+	obj->fec_nb_syms++;
+
+	nb_repair = 0;
+	for (i=0; i<obj->fec_nb_syms; i++) {
+		if ((obj->fec_ids[i]>>8) != sbn) continue;
+		repair[nb_repair] = obj->fec_data + i * sym_size;
+		esis[nb_repair] = obj->fec_ids[i] & 0xFF;
+		nb_repair++;
+	}
+	if (nb_repair < nb_miss) return GF_OK;
+
+	//enough repair symbols, recover the block
+	block = gf_malloc(k * sym_size);
+	if (!block) return GF_OUT_OF_MEM;
+	for (i=0; i<k; i++) {
+		u32 start = (first_sym + i) * sym_size;
+		src[i] = block + i * sym_size;
+		if (!present[i]) continue;
+		if (start + sym_size > obj->total_length) {
+			memset(src[i], 0, sym_size);
+			memcpy(src[i], obj->payload + start, obj->total_length - start);
+		} else {
+			memcpy(src[i], obj->payload + start, sym_size);
+		}
+	}
+	e = gf_rs_fec_decode(src, present, k, repair, esis, nb_repair, sym_size);
+	if (e) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_ROUTE, ("[ROUTE] Service %d TSI %u TOI %u failed to recover source block %u: %s\n", s->service_id, tsi, toi, sbn, gf_error_to_string(e) ));
+		gf_free(block);
+		return e;
+	}
+	GF_LOG(GF_LOG_INFO, GF_LOG_ROUTE, ("[ROUTE] Service %d TSI %u TOI %u recovered %u symbols in source block %u using %u repair symbols\n", s->service_id, tsi, toi, nb_miss, sbn, nb_repair));
+	routedmx->fec_nb_syms += nb_miss;
+	obj->fec_recovered = GF_TRUE;
+
+	for (i=0; i<k; i++) {
+		u32 start, end;
+		if (present[i]) continue;
+		start = (first_sym + i) * sym_size;
+		end = MIN(start + sym_size, obj->total_length);
+		e = gf_route_fec_fill(routedmx, s, obj, start, end, src[i], in_order);
+		if (e) break;
+	}
+	gf_free(block);
+
+	if (e==GF_EOS)
+		return gf_route_dmx_process_object(routedmx, s, obj);
+	return e;
+}
+
 static GF_Err gf_route_service_setup_dash(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, char *content, char *content_location)
 {
 	u32 len = (u32) strlen(content);
@@ -1355,6 +1563,41 @@ static GF_Err gf_route_service_setup_stsid(GF_ROUTEDmx *routedmx, GF_ROUTEServic
 				}
 			}
 
+			//repair flow, only repair packets sent on the protected TSI are supported
+			k=0;
+			while ((node = gf_list_enum(ls->content, &k))) {
+				u32 l=0;
+				GF_XMLNode *fec;
+				if (node->type != GF_XML_NODE_TYPE) continue;
+				if (strcmp(node->name, "RprFlow")) continue;
+				while ((fec = gf_list_enum(node->content, &l))) {
+					u32 n=0, fec_id=0;
+					Bool is_protected = GF_FALSE;
+					GF_XMLNode *po;
+					if (fec->type != GF_XML_NODE_TYPE) continue;
+					if (strcmp(fec->name, "FECParameters")) continue;
+					while ((att = gf_list_enum(fec->attributes, &n))) {
+						if (!strcmp(att->name, "fecEncodingId")) fec_id = atoi(att->value);
+					}
+					n=0;
+					while ((po = gf_list_enum(fec->content, &n))) {
+						u32 m=0, po_tsi=0;
+						if (po->type != GF_XML_NODE_TYPE) continue;
+						if (strcmp(po->name, "ProtectedObject")) continue;
+						while ((att = gf_list_enum(po->attributes, &m))) {
+							if (!strcmp(att->name, "tsi")) sscanf(att->value, "%u", &po_tsi);
+						}
+						if (po_tsi == tsi) is_protected = GF_TRUE;
+					}
+					if (!is_protected) continue;
+					if (fec_id != GF_RS_FEC_ENCODING_ID) {
+						GF_LOG(GF_LOG_WARNING, GF_LOG_ROUTE, ("[ROUTE] Service %d FEC encoding ID %d not supported for TSI %u, ignoring repair flow\n", s->service_id, fec_id, tsi));
+						continue;
+					}
+					rlct->fec_id = fec_id;
+				}
+			}
+
 			gf_list_add(rsess->channels, rlct);
 		}
 	}
@@ -1506,32 +1749,21 @@ static GF_Err gf_route_dmx_process_service_signaling(GF_ROUTEDmx *routedmx, GF_R
 }
 
 
-static GF_Err gf_route_dmx_process_service(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, GF_ROUTESession *route_sess)
+static GF_Err gf_route_dmx_process_lct(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, u8 *buffer, u32 nb_read)
 {
 	GF_Err e;
-	u32 nb_read, v, C, psi, S, O, H, /*Res, A,*/ B, hdr_len, cp, cc, tsi, toi, pos;
+	u32 v, C, psi, S, O, H, /*Res, A,*/ B, hdr_len, cp, cc, tsi, toi, pos;
 	u32 /*a_G=0, a_U=0,*/ a_S=0, a_M=0/*, a_A=0, a_H=0, a_D=0*/;
 	u64 tol_size=0;
 	Bool in_order = GF_TRUE;
 	u32 start_offset;
+	u64 fti_size=0;
+	u32 fti_m=0, fti_e=0, fti_b=0;
+	Bool is_repair;
 	GF_ROUTELCTChannel *rlct=NULL;
 	GF_LCTObject *gather_object=NULL;
 
-	if (route_sess) {
-		e = gf_sk_receive_no_select(route_sess->sock, routedmx->buffer, routedmx->buffer_size, &nb_read);
-	} else {
-		e = gf_sk_receive_no_select(s->sock, routedmx->buffer, routedmx->buffer_size, &nb_read);
-	}
-
-	if (e != GF_OK) return e;
-	gf_assert(nb_read);
-
-	routedmx->nb_packets++;
-	routedmx->total_bytes_recv += nb_read;
-	routedmx->last_pck_time = gf_sys_clock_high_res();
-	if (!routedmx->first_pck_time) routedmx->first_pck_time = routedmx->last_pck_time;
-
-	e = gf_bs_reassign_buffer(routedmx->bs, routedmx->buffer, nb_read);
+	e = gf_bs_reassign_buffer(routedmx->bs, buffer, nb_read);
 	if (e != GF_OK) return e;
 
 	//parse LCT header
@@ -1576,10 +1808,8 @@ static GF_Err gf_route_dmx_process_service(GF_ROUTEDmx *routedmx, GF_ROUTEServic
 		return GF_NON_COMPLIANT_BITSTREAM;
 	}
 
-	if (psi==0) {
-		GF_LOG(GF_LOG_WARNING, GF_LOG_ROUTE, ("[ROUTE] Service %d : FEC ROUTE not implemented\n", s->service_id));
-		return GF_NOT_SUPPORTED;
-	}
+	//PSI b00 signals a repair packet
+	is_repair = (psi==0) ? GF_TRUE : GF_FALSE;
 
 	cc = gf_bs_read_u32(routedmx->bs);
 	tsi = gf_bs_read_u32(routedmx->bs);
@@ -1589,6 +1819,11 @@ static GF_Err gf_route_dmx_process_service(GF_ROUTEDmx *routedmx, GF_ROUTEServic
 	//filter TSI if not 0 (service TSI) and debug mode set
 	if (routedmx->debug_tsi && tsi && (tsi!=routedmx->debug_tsi)) return GF_OK;
 
+	if (is_repair && !tsi) {
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_ROUTE, ("[ROUTE] Service %d : FEC repair packet on signaling TSI, skipping\n", s->service_id));
+		return GF_OK;
+	}
+
 	//look for TSI 0 first
 	if (tsi!=0) {
 		Bool cp_found = GF_FALSE;
@@ -1618,7 +1853,15 @@ static GF_Err gf_route_dmx_process_service(GF_ROUTEDmx *routedmx, GF_ROUTEServic
 			GF_LOG(GF_LOG_DEBUG, GF_LOG_ROUTE, ("[ROUTE] Service %d : no session with TSI %u defined, skipping packet (TOI %u)\n", s->service_id, tsi, toi));
 			return GF_OK;
 		}
-		for (i=0; rlct && i<rlct->nb_cps; i++) {
+		if (is_repair) {
+			if (!rlct || !rlct->fec_id) {
+				GF_LOG(GF_LOG_DEBUG, GF_LOG_ROUTE, ("[ROUTE] Service %d : FEC repair packet on TSI %u without repair flow, skipping packet (TOI %u)\n", s->service_id, tsi, toi));
+				return GF_OK;
+			}
+			if (rlct->nb_cps) in_order = rlct->CPs[0].order;
+			cp_found = GF_TRUE;
+		}
+		for (i=0; !cp_found && rlct && i<rlct->nb_cps; i++) {
 			if (rlct->CPs[i].codepoint==cp) {
 				in_order = rlct->CPs[i].order;
 				cp_found = GF_TRUE;
@@ -1681,6 +1924,20 @@ static GF_Err gf_route_dmx_process_service(GF_ROUTEDmx *routedmx, GF_ROUTEServic
 			tol_size = gf_bs_read_long_int(routedmx->bs, 48);
 			break;
 
+		case GF_LCT_EXT_FTI:
+			if (hel!=4) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_ROUTE, ("[ROUTE] Service %d : wrong HEL %d for FTI LCT extension, expecting 4\n", s->service_id, hel));
+				if (hel) gf_bs_skip_bytes(routedmx->bs, 4*hel - 2);
+				break;
+			}
+			fti_size = gf_bs_read_long_int(routedmx->bs, 48);
+			fti_m = gf_bs_read_u8(routedmx->bs);
+			/*G = */gf_bs_read_u8(routedmx->bs);
+			fti_e = gf_bs_read_u16(routedmx->bs);
+			fti_b = gf_bs_read_u16(routedmx->bs);
+			/*max_n = */gf_bs_read_u16(routedmx->bs);
+			break;
+
 		default:
 			GF_LOG(GF_LOG_DEBUG, GF_LOG_ROUTE, ("[ROUTE] Service %d : unsupported header extension HEL %d HET %d, ignoring\n", s->service_id, hel, het));
 			break;
@@ -1693,12 +1950,24 @@ static GF_Err gf_route_dmx_process_service(GF_ROUTEDmx *routedmx, GF_ROUTEServic
 		else hdr_len -= 1;
 	}
 
+	if (is_repair) {
+		u32 sbn = gf_bs_read_int(routedmx->bs, 24);
+		u32 esi = gf_bs_read_int(routedmx->bs, 8);
+		pos = (u32) gf_bs_get_position(routedmx->bs);
+		if (!fti_e || (fti_m!=8) || (fti_size>0xFFFFFFFF)) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_ROUTE, ("[ROUTE] Service %d : FEC repair packet TSI %u TOI %u without supported FTI, skipping\n", s->service_id, tsi, toi));
+			return GF_OK;
+		}
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_ROUTE, ("[ROUTE] Service %d : LCT repair packet TSI %u TOI %u size %d SBN %u ESI %u\n", s->service_id, tsi, toi, nb_read-pos, sbn, esi));
+		return gf_route_service_gather_repair(routedmx, s, rlct, tsi, toi, (u32) fti_size, fti_e, fti_b, sbn, esi, buffer + pos, nb_read-pos, in_order);
+	}
+
 	start_offset = gf_bs_read_u32(routedmx->bs);
 	pos = (u32) gf_bs_get_position(routedmx->bs);
 
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_ROUTE, ("[ROUTE] Service %d : LCT packet TSI %u TOI %u size %d startOffset %u TOL "LLU"\n", s->service_id, tsi, toi, nb_read-pos, start_offset, tol_size));
 
-	e = gf_route_service_gather_object(routedmx, s, tsi, toi, start_offset, routedmx->buffer + pos, nb_read-pos, (u32) tol_size, B, in_order, rlct, &gather_object);
+	e = gf_route_service_gather_object(routedmx, s, tsi, toi, start_offset, buffer + pos, nb_read-pos, (u32) tol_size, B, in_order, rlct, &gather_object);
 
 	if (e==GF_EOS) {
 		if (!tsi) {
@@ -1719,6 +1988,31 @@ static GF_Err gf_route_dmx_process_service(GF_ROUTEDmx *routedmx, GF_ROUTEServic
 	return GF_OK;
 }
 
+static GF_Err gf_route_dmx_process_service(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, GF_ROUTESession *route_sess)
+{
+	GF_Err e, ret = GF_OK;
+	u32 i, nb_pck;
+
+	e = gf_sk_receive_batch(route_sess ? route_sess->sock : s->sock, routedmx->pck_buffer, GF_ROUTE_PCK_SLOT_SIZE, GF_ROUTE_RECV_BATCH, routedmx->pck_sizes, &nb_pck);
+	if (e != GF_OK) return e;
+	gf_assert(nb_pck);
+
+	routedmx->last_pck_time = gf_sys_clock_high_res();
+	if (!routedmx->first_pck_time) routedmx->first_pck_time = routedmx->last_pck_time;
+
+	//process all packets, the batch is consumed from the socket
+	for (i=0; i<nb_pck; i++) {
+		u32 nb_read = routedmx->pck_sizes[i];
+		if (!nb_read) continue;
+		routedmx->nb_packets++;
+		routedmx->total_bytes_recv += nb_read;
+
+		e = gf_route_dmx_process_lct(routedmx, s, routedmx->pck_buffer + i*GF_ROUTE_PCK_SLOT_SIZE, nb_read);
+		if (e) ret = e;
+	}
+	return ret;
+}
+
 static GF_Err gf_route_dmx_process_lls(GF_ROUTEDmx *routedmx)
 {
 	u32 read;
@@ -2074,6 +2368,14 @@ u64 gf_route_dmx_get_recv_bytes(GF_ROUTEDmx *routedmx)
 	return routedmx ? routedmx->total_bytes_recv : 0;
 }
 
+GF_EXPORT
+void gf_route_dmx_get_fec_stats(GF_ROUTEDmx *routedmx, u32 *nb_recovered_objects, u64 *nb_recovered_symbols, u64 *nb_repair_packets)
+{
+	if (nb_recovered_objects) *nb_recovered_objects = routedmx ? routedmx->fec_nb_objs : 0;
+	if (nb_recovered_symbols) *nb_recovered_symbols = routedmx ? routedmx->fec_nb_syms : 0;
+	if (nb_repair_packets) *nb_repair_packets = routedmx ? routedmx->fec_nb_repair : 0;
+}
+
 GF_EXPORT
 void gf_route_dmx_debug_tsi(GF_ROUTEDmx *routedmx, u32 tsi)
 {
@@ -42,13 +42,17 @@
 #include <unistd.h>
 #endif
 
-static const char * CACHE_SECTION_NAME = "cache";
-static const char * CACHE_SECTION_NAME_URL = "url";
-static const char * CACHE_SECTION_NAME_RANGE = "range";
-static const char * CACHE_SECTION_NAME_ETAG = "ETag";
-static const char * CACHE_SECTION_NAME_MIME_TYPE = "Content-Type";
-static const char * CACHE_SECTION_NAME_CONTENT_SIZE = "Content-Length";
-static const char * CACHE_SECTION_NAME_LAST_MODIFIED = "Last-Modified";
+#define _CACHE_HASH_SIZE 20
+#define _CACHE_MAX_EXTENSION_SIZE 6
+#define _CACHE_TMP_SIZE 4096
+
+//index file name in cache directory, one line per cached resource
+static const char * cache_index_name = "gpac_cache_index.txt";
+static const char * cache_index_header = "#GPAC cache index v1";
+//number of hash buckets of the index
+#define CACHE_INDEX_BUCKETS	1024
+//min interval in ms between two index saves while running
+#define CACHE_INDEX_SAVE_INTERVAL	1000
 
 enum CacheValid
 {
@@ -59,6 +63,34 @@ enum CacheValid
     DELETED = 1<<4
 };
 
+typedef struct __cache_index_rec
+{
+	//hexadecimal SHA-1 of URL and range, also used as cache file name
+	char hash[2*_CACHE_HASH_SIZE+1];
+	char *url, *ext, *etag, *last_modified, *mime;
+	u64 range_start, range_end;
+	//content length as announced by server
+	u32 size;
+	//UTC of last access in ms
+	u64 last_access;
+	//size of file on disk accounted in index
+	u32 disk_size;
+	//cache entry currently using this record, never evicted
+	DownloadedCacheEntry entry;
+	struct __cache_index_rec *next;
+} GF_CacheIndexRecord;
+
+struct __CacheIndexStruct
+{
+	char *dir;
+	GF_CacheIndexRecord *buckets[CACHE_INDEX_BUCKETS];
+	u32 nb_records;
+	u64 disk_size, max_size;
+	Bool modified;
+	u32 last_save;
+	GF_Mutex *mx;
+};
+
 struct __CacheReaderStruct {
 	FILE * readPtr;
 	s64 readPosition;
@@ -90,9 +122,10 @@ struct __DownloadedCacheEntryStruct
 	*/
 	char * cache_filename;
 	/**
-	* Name of the cached properties filename , (can be NULL)
+	* Index and index record of the cache, NULL for memory entries
 	*/
-	GF_Config * properties;
+	GF_CacheIndex index;
+	GF_CacheIndexRecord *rec;
 	/**
 	* Theorical size of cache if any
 	*/
@@ -171,6 +204,8 @@ struct __DownloadedCacheEntryStruct
     GF_Blob cache_blob;
     GF_Blob *external_blob;
     Bool persistent;
+	/*system clock in ms of last session attach or detach, for memory eviction*/
+	u64 last_access;
 };
 
 Bool gf_cache_entry_persistent(const DownloadedCacheEntry entry)
@@ -219,6 +254,284 @@ GF_Err gf_cache_delete_all_cached_files(const char * directory) {
 	return gf_enum_directory( directory, GF_FALSE, delete_cache_files, (void*)cache_file_prefix, NULL);
 }
 
+static u32 cache_index_bucket(const char *hash)
+{
+	u32 i, h=0;
+	for (i=0; i<4; i++) {
+		char c = hash[i];
+		h <<= 4;
+		if ((c>='0') && (c<='9')) h |= (u32) (c-'0');
+		else if ((c>='A') && (c<='F')) h |= (u32) (c-'A'+10);
+	}
+	return h % CACHE_INDEX_BUCKETS;
+}
+
+static GF_CacheIndexRecord *cache_index_find(GF_CacheIndex index, const char *hash)
+{
+	GF_CacheIndexRecord *rec = index->buckets[cache_index_bucket(hash)];
+	while (rec) {
+		if (!strcmp(rec->hash, hash)) return rec;
+		rec = rec->next;
+	}
+	return NULL;
+}
+
+static void cache_index_rec_del(GF_CacheIndexRecord *rec)
+{
+	if (rec->url) gf_free(rec->url);
+	if (rec->ext) gf_free(rec->ext);
+	if (rec->etag) gf_free(rec->etag);
+	if (rec->last_modified) gf_free(rec->last_modified);
+	if (rec->mime) gf_free(rec->mime);
+	gf_free(rec);
+}
+
+static void cache_index_add(GF_CacheIndex index, GF_CacheIndexRecord *rec)
+{
+	u32 b = cache_index_bucket(rec->hash);
+	rec->next = index->buckets[b];
+	index->buckets[b] = rec;
+	index->nb_records++;
+	index->disk_size += rec->disk_size;
+	index->modified = GF_TRUE;
+}
+
+static void cache_index_remove(GF_CacheIndex index, GF_CacheIndexRecord *rec)
+{
+	u32 b = cache_index_bucket(rec->hash);
+	GF_CacheIndexRecord *prev = index->buckets[b];
+	if (prev == rec) {
+		index->buckets[b] = rec->next;
+	} else {
+		while (prev && (prev->next != rec)) prev = prev->next;
+		if (!prev) return;
+		prev->next = rec->next;
+	}
+	index->nb_records--;
+	if (index->disk_size > rec->disk_size) index->disk_size -= rec->disk_size;
+	else index->disk_size = 0;
+	index->modified = GF_TRUE;
+	cache_index_rec_del(rec);
+}
+
+static void cache_index_set_str(char **str, const char *val)
+{
+	if (*str) gf_free(*str);
+	*str = (val && val[0]) ? gf_strdup(val) : NULL;
+}
+
+//get next tab-separated field of an index line
+static char *cache_index_next_field(char **line)
+{
+	char *res = *line;
+	char *sep;
+	if (!res) return "";
+	sep = strchr(res, '\t');
+	if (sep) {
+		sep[0] = 0;
+		*line = sep+1;
+	} else {
+		sep = strchr(res, '\n');
+		if (sep) sep[0] = 0;
+		sep = strchr(res, '\r');
+		if (sep) sep[0] = 0;
+		*line = NULL;
+	}
+	return res;
+}
+
+GF_Err gf_cache_index_save(GF_CacheIndex index)
+{
+	u32 i;
+	FILE *f;
+	GF_Err e;
+	char szPath[GF_MAX_PATH], szTmp[GF_MAX_PATH+5];
+	if (!index) return GF_BAD_PARAM;
+
+	gf_mx_p(index->mx);
+	if (!index->modified) {
+		gf_mx_v(index->mx);
+		return GF_OK;
+	}
+	snprintf(szPath, GF_MAX_PATH, "%s%s", index->dir, cache_index_name);
+	snprintf(szTmp, GF_MAX_PATH+5, "%s.tmp", szPath);
+	f = gf_fopen(szTmp, "wb");
+	if (!f) {
+		gf_mx_v(index->mx);
+		GF_LOG(GF_LOG_ERROR, GF_LOG_CACHE, ("[CACHE] Failed to open cache index %s for write\n", szTmp));
+		return GF_IO_ERR;
+	}
+	gf_fprintf(f, "%s\n", cache_index_header);
+	for (i=0; i<CACHE_INDEX_BUCKETS; i++) {
+		GF_CacheIndexRecord *rec = index->buckets[i];
+		while (rec) {
+			gf_fprintf(f, "%s\t%s\t%u\t%u\t"LLU"\t"LLU"-"LLU"\t%s\t%s\t%s\t%s\n", rec->hash, rec->ext ? rec->ext : "",
+				rec->size, rec->disk_size, rec->last_access, rec->range_start, rec->range_end,
+				rec->etag ? rec->etag : "", rec->last_modified ? rec->last_modified : "", rec->mime ? rec->mime : "", rec->url);
+			rec = rec->next;
+		}
+	}
+	gf_fclose(f);
+	e = gf_file_move(szTmp, szPath);
+	if (!e) index->modified = GF_FALSE;
+	index->last_save = gf_sys_clock();
+	gf_mx_v(index->mx);
+	if (e) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_CACHE, ("[CACHE] Failed to save cache index %s: %s\n", szPath, gf_error_to_string(e) ));
+	}
+	return e;
+}
+
+static int cache_index_lru_cmp(const void *a, const void *b)
+{
+	const GF_CacheIndexRecord *r1 = *(const GF_CacheIndexRecord **)a;
+	const GF_CacheIndexRecord *r2 = *(const GF_CacheIndexRecord **)b;
+	if (r1->last_access < r2->last_access) return -1;
+	if (r1->last_access > r2->last_access) return 1;
+	return 0;
+}
+
+//evict least recently used records not in use until index is below 90% of its max size - index mutex must be grabbed
+static void cache_index_evict(GF_CacheIndex index)
+{
+	u32 i, nb_cands=0;
+	u64 target;
+	GF_CacheIndexRecord **cands;
+	if (!index->max_size || (index->disk_size <= index->max_size)) return;
+
+	cands = gf_malloc(sizeof(GF_CacheIndexRecord *) * index->nb_records);
+	if (!cands) return;
+	for (i=0; i<CACHE_INDEX_BUCKETS; i++) {
+		GF_CacheIndexRecord *rec = index->buckets[i];
+		while (rec) {
+			if (!rec->entry) cands[nb_cands++] = rec;
+			rec = rec->next;
+		}
+	}
+	qsort(cands, nb_cands, sizeof(GF_CacheIndexRecord *), cache_index_lru_cmp);
+
+	target = index->max_size / 10 * 9;
+	for (i=0; (i<nb_cands) && (index->disk_size > target); i++) {
+		char szPath[GF_MAX_PATH];
+		GF_CacheIndexRecord *rec = cands[i];
+		snprintf(szPath, GF_MAX_PATH, "%s%s%s%s", index->dir, cache_file_prefix, rec->hash, rec->ext ? rec->ext : "");
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_CACHE, ("[CACHE] Evicting %s (%u bytes) from cache\n", rec->url, rec->disk_size));
+		if (gf_file_exists(szPath) && (gf_file_delete(szPath) != GF_OK)) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_CACHE, ("[CACHE] Failed to delete evicted file %s\n", szPath));
+		}
+		cache_index_remove(index, rec);
+	}
+	gf_free(cands);
+	if (index->disk_size > index->max_size) {
+		GF_LOG(GF_LOG_INFO, GF_LOG_CACHE, ("[CACHE] Cache size "LLU" still above max allowed "LLU", all remaining entries in use\n", index->disk_size, index->max_size));
+	}
+}
+
+GF_CacheIndex gf_cache_index_new(const char *directory, u64 max_size)
+{
+	FILE *f;
+	GF_CacheIndex index;
+	char szPath[GF_MAX_PATH];
+	if (!directory) return NULL;
+
+	GF_SAFEALLOC(index, struct __CacheIndexStruct);
+	if (!index) return NULL;
+	index->dir = gf_strdup(directory);
+	index->mx = gf_mx_new("CacheIndex");
+	index->max_size = max_size;
+
+	snprintf(szPath, GF_MAX_PATH, "%s%s", directory, cache_index_name);
+	f = gf_fopen(szPath, "rb");
+	if (!f) {
+		//no index, files from previous cache versions would never be evicted - purge them
+		if (gf_cache_get_size(directory)) {
+			GF_LOG(GF_LOG_INFO, GF_LOG_CACHE, ("[CACHE] No cache index found in %s, purging cache\n", directory));
+			gf_cache_delete_all_cached_files(directory);
+		}
+		return index;
+	}
+
+	while (1) {
+		char *line, *field;
+		char szLine[2*_CACHE_TMP_SIZE];
+		GF_CacheIndexRecord *rec;
+		if (!gf_fgets(szLine, 2*_CACHE_TMP_SIZE, f)) break;
+		if (szLine[0] == '#') continue;
+		line = szLine;
+		field = cache_index_next_field(&line);
+		if (strlen(field) != 2*_CACHE_HASH_SIZE) continue;
+		GF_SAFEALLOC(rec, GF_CacheIndexRecord);
+		if (!rec) break;
+		strcpy(rec->hash, field);
+		cache_index_set_str(&rec->ext, cache_index_next_field(&line));
+		rec->size = (u32) strtoul(cache_index_next_field(&line), NULL, 10);
+		rec->disk_size = (u32) strtoul(cache_index_next_field(&line), NULL, 10);
+		sscanf(cache_index_next_field(&line), LLU, &rec->last_access);
+		sscanf(cache_index_next_field(&line), LLU"-"LLU, &rec->range_start, &rec->range_end);
+		cache_index_set_str(&rec->etag, cache_index_next_field(&line));
+		cache_index_set_str(&rec->last_modified, cache_index_next_field(&line));
+		cache_index_set_str(&rec->mime, cache_index_next_field(&line));
+		cache_index_set_str(&rec->url, cache_index_next_field(&line));
+		if (!rec->url || cache_index_find(index, rec->hash)) {
+			cache_index_rec_del(rec);
+			continue;
+		}
+		cache_index_add(index, rec);
+	}
+	gf_fclose(f);
+	index->modified = GF_FALSE;
+	GF_LOG(GF_LOG_INFO, GF_LOG_CACHE, ("[CACHE] Loaded cache index with %u entries - "LLU" bytes\n", index->nb_records, index->disk_size));
+
+	gf_mx_p(index->mx);
+	cache_index_evict(index);
+	gf_mx_v(index->mx);
+	return index;
+}
+
+void gf_cache_index_del(GF_CacheIndex index)
+{
+	u32 i;
+	if (!index) return;
+	gf_cache_index_save(index);
+	for (i=0; i<CACHE_INDEX_BUCKETS; i++) {
+		while (index->buckets[i]) {
+			GF_CacheIndexRecord *rec = index->buckets[i];
+			index->buckets[i] = rec->next;
+			cache_index_rec_del(rec);
+		}
+	}
+	gf_mx_del(index->mx);
+	gf_free(index->dir);
+	gf_free(index);
+}
+
+u64 gf_cache_index_get_size(GF_CacheIndex index)
+{
+	return index ? index->disk_size : 0;
+}
+
+static void cache_entry_touch(DownloadedCacheEntry entry)
+{
+	entry->last_access = gf_sys_clock_high_res() / 1000;
+	if (entry->rec) {
+		gf_mx_p(entry->index->mx);
+		entry->rec->last_access = gf_net_get_utc();
+		entry->index->modified = GF_TRUE;
+		gf_mx_v(entry->index->mx);
+	}
+}
+
+u32 gf_cache_get_mem_usage(const DownloadedCacheEntry entry)
+{
+	if (!entry || !entry->memory_stored || entry->external_blob) return 0;
+	return entry->mem_allocated;
+}
+
+u64 gf_cache_get_last_access(const DownloadedCacheEntry entry)
+{
+	return entry ? entry->last_access : 0;
+}
+
 void gf_cache_entry_set_delete_files_when_deleted(const DownloadedCacheEntry entry) {
 	if (entry && !entry->persistent)
 		entry->deletableFilesOnDelete = GF_TRUE;
@@ -328,31 +641,24 @@ GF_Err gf_cache_set_last_modified_on_disk ( const DownloadedCacheEntry entry, co
 	return GF_OK;
 }
 
-#define _CACHE_TMP_SIZE 4096
-
 GF_Err gf_cache_flush_disk_cache ( const DownloadedCacheEntry entry )
 {
-	char buff[100];
+	GF_CacheIndexRecord *rec;
 	CHECK_ENTRY;
-	if ( !entry->properties)
+	if ( !entry->rec)
 		return GF_OK;
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_CACHE, ("[CACHE] gf_cache_flush_disk_cache:%d for entry=%p\n", __LINE__, entry));
-	gf_cfg_set_key(entry->properties, CACHE_SECTION_NAME, CACHE_SECTION_NAME_URL, entry->url);
-
-	sprintf(buff, LLD"-"LLD, entry->range_start, entry->range_end);
-	gf_cfg_set_key(entry->properties, CACHE_SECTION_NAME, CACHE_SECTION_NAME_RANGE, buff);
-
-	if (entry->mimeType)
-		gf_cfg_set_key(entry->properties, CACHE_SECTION_NAME, CACHE_SECTION_NAME_MIME_TYPE, entry->mimeType);
-	if (entry->diskETag)
-		gf_cfg_set_key(entry->properties, CACHE_SECTION_NAME, CACHE_SECTION_NAME_ETAG, entry->diskETag);
-	if (entry->diskLastModified)
-		gf_cfg_set_key(entry->properties, CACHE_SECTION_NAME, CACHE_SECTION_NAME_LAST_MODIFIED, entry->diskLastModified);
-	{
-		snprintf(buff, 16, "%d", entry->contentLength);
-		gf_cfg_set_key(entry->properties, CACHE_SECTION_NAME, CACHE_SECTION_NAME_CONTENT_SIZE, buff);
-	}
-	return gf_cfg_save ( entry->properties );
+	rec = entry->rec;
+	gf_mx_p(entry->index->mx);
+	rec->range_start = entry->range_start;
+	rec->range_end = entry->range_end;
+	cache_index_set_str(&rec->mime, entry->mimeType);
+	cache_index_set_str(&rec->etag, entry->diskETag);
+	cache_index_set_str(&rec->last_modified, entry->diskLastModified);
+	rec->size = entry->contentLength;
+	entry->index->modified = GF_TRUE;
+	gf_mx_v(entry->index->mx);
+	return GF_OK;
 }
 
 u32 gf_cache_get_cache_filesize ( const DownloadedCacheEntry entry )
@@ -385,12 +691,9 @@ GF_Err gf_cache_get_http_headers(const DownloadedCacheEntry entry, const char **
 	return GF_OK;
 }
 
-#define _CACHE_HASH_SIZE 20
-#define _CACHE_MAX_EXTENSION_SIZE 6
 static const char * default_cache_file_suffix = ".dat";
-static const char * cache_file_info_suffix = ".txt";
 
-DownloadedCacheEntry gf_cache_create_entry ( GF_DownloadManager * dm, const char * cache_directory, const char * url , u64 start_range, u64 end_range, Bool mem_storage, GF_Mutex *mx)
+DownloadedCacheEntry gf_cache_create_entry ( GF_DownloadManager * dm, const char * cache_directory, GF_CacheIndex index, const char * url , u64 start_range, u64 end_range, Bool mem_storage, GF_Mutex *mx)
 {
 	char tmp[_CACHE_TMP_SIZE];
 	u8 hash[_CACHE_HASH_SIZE];
@@ -496,6 +799,7 @@ DownloadedCacheEntry gf_cache_create_entry ( GF_DownloadManager * dm, const char
 			strcpy(entry->cache_filename, burl);
 			gf_free(burl);
 		}
+		entry->last_access = gf_sys_clock_high_res() / 1000;
 		return entry;
 	}
 
@@ -522,41 +826,46 @@ DownloadedCacheEntry gf_cache_create_entry ( GF_DownloadManager * dm, const char
 		assert (strlen(ext));
 		strcat( entry->cache_filename, ext);
 	}
-	tmp[0] = '\0';
-	strcpy( tmp, cache_file_prefix);
-	strcat( tmp, entry->hash );
-	strcat( tmp , ext);
-	strcat ( tmp, cache_file_info_suffix );
-	entry->properties = gf_cfg_force_new ( cache_directory, tmp );
-	if ( !entry->properties )
-	{
-		GF_Err err;
-		/* out of memory ? */
-		GF_LOG(GF_LOG_WARNING, GF_LOG_CACHE, ("[CACHE] gf_cache_create_entry:%d, aborting due to OUT of MEMORY !\n", __LINE__));
-		err = gf_cache_delete_entry ( entry );
-		if ( err != GF_OK ) {
-			GF_LOG(GF_LOG_WARNING, GF_LOG_CACHE, ("[CACHE] gf_cache_create_entry:%d, failed to delete cache entry!\n", __LINE__));
-		}
-		return NULL;
-	}
-	gf_cache_set_etag_on_disk(entry, gf_cfg_get_key(entry->properties, CACHE_SECTION_NAME, CACHE_SECTION_NAME_ETAG));
-	gf_cache_set_etag_on_server(entry, gf_cfg_get_key(entry->properties, CACHE_SECTION_NAME, CACHE_SECTION_NAME_ETAG));
-	gf_cache_set_mime_type(entry, gf_cfg_get_key(entry->properties, CACHE_SECTION_NAME, CACHE_SECTION_NAME_MIME_TYPE));
-	gf_cache_set_last_modified_on_disk(entry, gf_cfg_get_key(entry->properties, CACHE_SECTION_NAME, CACHE_SECTION_NAME_LAST_MODIFIED));
-	gf_cache_set_last_modified_on_server(entry, gf_cfg_get_key(entry->properties, CACHE_SECTION_NAME, CACHE_SECTION_NAME_LAST_MODIFIED));
-	{
-		const char * keyValue = gf_cfg_get_key ( entry->properties, CACHE_SECTION_NAME, CACHE_SECTION_NAME_URL );
-		if ( keyValue == NULL || stricmp ( url, keyValue ) )
-			entry->flags |= CORRUPTED;
-
-		keyValue = gf_cfg_get_key(entry->properties, CACHE_SECTION_NAME, CACHE_SECTION_NAME_RANGE);
-		if (keyValue) {
-			u64 s, e;
-			sscanf(keyValue, LLD"-"LLD, &s, &e);
+	entry->index = index;
+	if (index) {
+		GF_CacheIndexRecord *rec;
+		gf_mx_p(index->mx);
+		rec = cache_index_find(index, entry->hash);
+		if (rec && !rec->entry && !strcmp(rec->url, url)
 			/*mark as corrupted if not same range (we don't support this for the time being ...*/
-			if ((s!=entry->range_start) || (e!=entry->range_end))
-				entry->flags |= CORRUPTED;
+			&& (rec->range_start==entry->range_start) && (rec->range_end==entry->range_end)
+		) {
+			gf_cache_set_etag_on_disk(entry, rec->etag);
+			gf_cache_set_etag_on_server(entry, rec->etag);
+			gf_cache_set_mime_type(entry, rec->mime);
+			gf_cache_set_last_modified_on_disk(entry, rec->last_modified);
+			gf_cache_set_last_modified_on_server(entry, rec->last_modified);
+		} else {
+			entry->flags |= CORRUPTED;
+			if (!rec) {
+				GF_SAFEALLOC(rec, GF_CacheIndexRecord);
+				if (rec) {
+					strcpy(rec->hash, entry->hash);
+					rec->url = gf_strdup(url);
+					rec->ext = gf_strdup(ext);
+					rec->range_start = entry->range_start;
+					rec->range_end = entry->range_end;
+					cache_index_add(index, rec);
+				}
+			}
+			//record used by another entry or for another URL
+			else if (rec->entry || strcmp(rec->url, url)) {
+				rec = NULL;
+			}
+		}
+		if (rec) {
+			rec->entry = entry;
+			entry->rec = rec;
 		}
+		gf_mx_v(index->mx);
+		cache_entry_touch(entry);
+	} else {
+		entry->flags |= CORRUPTED;
 	}
 	gf_cache_check_if_cache_file_is_corrupted(entry);
 
@@ -627,6 +936,19 @@ GF_Err gf_cache_close_write_cache( const DownloadedCacheEntry entry, const GF_Do
 		sync();
 #endif
 		entry->writeFilePtr = NULL;
+		if (!e && entry->rec) {
+			GF_CacheIndex index = entry->index;
+			Bool do_save;
+			gf_mx_p(index->mx);
+			index->disk_size -= entry->rec->disk_size;
+			entry->rec->disk_size = entry->written_in_cache;
+			index->disk_size += entry->rec->disk_size;
+			entry->rec->last_access = gf_net_get_utc();
+			cache_index_evict(index);
+			do_save = (gf_sys_clock() - index->last_save > CACHE_INDEX_SAVE_INTERVAL) ? GF_TRUE : GF_FALSE;
+			gf_mx_v(index->mx);
+			if (do_save) gf_cache_index_save(index);
+		}
 		if (GF_OK != e) {
 			GF_LOG(GF_LOG_ERROR, GF_LOG_CACHE, ("[CACHE] Failed to fully write file on cache, e=%d\n", e));
 		}
@@ -829,19 +1151,15 @@ GF_Err gf_cache_delete_entry ( const DownloadedCacheEntry entry )
 		entry->external_blob = NULL;
 	}
 
-	if ( entry->properties ) {
-		const char * propfile = NULL;
+	if ( entry->rec ) {
+		gf_mx_p(entry->index->mx);
 		if (entry->deletableFilesOnDelete)
-			propfile = gf_cfg_get_filename(entry->properties);
-
-		if (propfile) {
-			//this may fail because the prop file is not yet flushed to disk
-			gf_file_delete( propfile );
-		}
-
-        gf_cfg_del ( entry->properties );
-        entry->properties = NULL;
-    }
+			cache_index_remove(entry->index, entry->rec);
+		else
+			entry->rec->entry = NULL;
+		gf_mx_v(entry->index->mx);
+		entry->rec = NULL;
+	}
 	entry->dm = NULL;
 	if (entry->sessions) {
 		gf_assert( gf_list_count(entry->sessions) == 0);
@@ -860,14 +1178,11 @@ Bool gf_cache_check_if_cache_file_is_corrupted(const DownloadedCacheEntry entry)
 		the_cache = gf_fopen ( entry->cache_filename, "rb" );
 
 	if ( the_cache ) {
-		char * endPtr;
-		const char * keyValue = gf_cfg_get_key ( entry->properties, CACHE_SECTION_NAME, CACHE_SECTION_NAME_CONTENT_SIZE );
-
 		entry->cacheSize = ( u32 ) gf_fsize(the_cache);
 		gf_fclose ( the_cache );
-		if (keyValue) {
-			entry->contentLength = (u32) strtoul( keyValue, &endPtr, 10);
-			if (*endPtr!='\0' || entry->contentLength != entry->cacheSize) {
+		if (entry->rec) {
+			entry->contentLength = entry->rec->size;
+			if (entry->contentLength != entry->cacheSize) {
 				entry->flags |= CORRUPTED;
 				GF_LOG(GF_LOG_INFO, GF_LOG_CACHE, ("[CACHE] gf_cache_create_entry:%d, Cache corrupted: file and cache info size mismatch.\n", __LINE__));
 			}
@@ -910,6 +1225,7 @@ s32 gf_cache_remove_session_from_cache_entry(DownloadedCacheEntry entry, GF_Down
 		gf_mx_v(entry->write_mutex);
 #endif
 	}
+	entry->last_access = gf_sys_clock_high_res() / 1000;
 	return count;
 }
 
@@ -934,6 +1250,7 @@ s32 gf_cache_add_session_to_cache_entry(DownloadedCacheEntry entry, GF_DownloadS
 		}
 	}
 	gf_list_add(entry->sessions, sess);
+	cache_entry_touch(entry);
 	return count + 1;
 }
 
@@ -258,6 +258,10 @@ struct __gf_download_session
 	Double cumulated_chunk_rate;
 
 	u32 connection_timeout_ms;
+	//request priority (higher first) when connections per origin are limited, also used as HTTP/2 stream weight
+	u32 priority;
+	//set while waiting for a connection slot on the origin
+	Bool conn_wait;
 
 	u8 *async_req_reply;
 	u32 async_req_reply_size;
@@ -299,10 +303,32 @@ void dm_sess_sk_del(GF_DownloadSession *sess)
 	}
 }
 
+//idle keep-alive connection parked in the manager for reuse by any session to the same origin
+typedef struct
+{
+	char *server_name;
+	u16 port;
+	Bool use_ssl;
+	char *netcap_id;
+	GF_Socket *sock;
+#ifdef GPAC_HAS_SSL
+	SSL *ssl;
+#endif
+	u32 h2_upgrade_state;
+	u32 keep_alive_ms;
+	u64 last_fetch_time, expire_time;
+} GF_DMIdleConnection;
+
+//max number of idle connections kept in the pool
+#define DM_POOL_MAX_IDLE	16
+
 struct __gf_download_manager
 {
 	GF_Mutex *cache_mx;
 	char *cache_directory;
+	GF_CacheIndex cache_index;
+	//memory budget of idle memory cache entries, 0 means unlimited
+	u64 max_mem_cache;
 
 	gf_dm_get_usr_pass get_user_password;
 	void *usr_cbk;
@@ -327,6 +353,10 @@ struct __gf_download_manager
 #ifdef GPAC_HAS_HTTP2
 	Bool disable_http2;
 #endif
+	//idle connections pool, protected by cache_mx
+	GF_List *idle_conns;
+	//max number of active connections per origin (0: unlimited), idle connection timeout in ms (0: no pooling)
+	u32 max_conn, pool_idle;
 
 	Bool (*local_cache_url_provider_cbk)(void *udta, char *url, Bool cache_destroy);
 	void *lc_udta;
@@ -959,7 +989,13 @@ static GF_Err h2_submit_request(GF_DownloadSession *sess, char *req_name, const
 
 	sess->h2_data_done = 0;
 	sess->h2_headers_seen = 0;
-	sess->h2_stream_id = nghttp2_submit_request(sess->h2_sess->ng_sess, NULL, hdrs, nb_hdrs+4, has_body ? &sess->data_io : NULL, sess);
+	if (sess->priority) {
+		nghttp2_priority_spec pri_spec;
+		nghttp2_priority_spec_init(&pri_spec, 0, MIN(NGHTTP2_MAX_WEIGHT, NGHTTP2_DEFAULT_WEIGHT * (1 + sess->priority)), 0);
+		sess->h2_stream_id = nghttp2_submit_request(sess->h2_sess->ng_sess, &pri_spec, hdrs, nb_hdrs+4, has_body ? &sess->data_io : NULL, sess);
+	} else {
+		sess->h2_stream_id = nghttp2_submit_request(sess->h2_sess->ng_sess, NULL, hdrs, nb_hdrs+4, has_body ? &sess->data_io : NULL, sess);
+	}
 	sess->h2_ready_to_send = 0;
 
 #ifndef GPAC_DISABLE_LOG
@@ -1778,7 +1814,7 @@ DownloadedCacheEntry gf_dm_find_cached_entry_by_url(GF_DownloadSession * sess)
 /**
  * Creates a new cache entry
  */
-DownloadedCacheEntry gf_cache_create_entry( GF_DownloadManager * dm, const char * cache_directory, const char * url, u64 start_range, u64 end_range, Bool mem_storage, GF_Mutex *mx);
+DownloadedCacheEntry gf_cache_create_entry( GF_DownloadManager * dm, const char * cache_directory, GF_CacheIndex index, const char * url, u64 start_range, u64 end_range, Bool mem_storage, GF_Mutex *mx);
 
 /*!
  * Removes a session for a DownloadedCacheEntry
@@ -1837,6 +1873,38 @@ static void gf_dm_remove_cache_entry_from_session(GF_DownloadSession * sess) {
 s32 gf_cache_add_session_to_cache_entry(DownloadedCacheEntry entry, GF_DownloadSession * sess);
 Bool gf_cache_entry_persistent(const DownloadedCacheEntry entry);
 void gf_cache_entry_set_persistent(const DownloadedCacheEntry entry);
+u32 gf_cache_get_mem_usage(const DownloadedCacheEntry entry);
+u64 gf_cache_get_last_access(const DownloadedCacheEntry entry);
+
+/*evicts least recently used idle memory entries until memory cache is below the budget - cache mutex must be grabbed*/
+static void gf_dm_evict_mem_cache(GF_DownloadManager *dm, u32 needed)
+{
+	u32 i, count;
+	u64 mem_size = needed;
+	if (!dm->max_mem_cache) return;
+
+	count = gf_list_count(dm->cache_entries);
+	for (i=0; i<count; i++) {
+		mem_size += gf_cache_get_mem_usage( gf_list_get(dm->cache_entries, i) );
+	}
+	while (mem_size > dm->max_mem_cache) {
+		DownloadedCacheEntry lru = NULL;
+		for (i=0; i<count; i++) {
+			DownloadedCacheEntry e = gf_list_get(dm->cache_entries, i);
+			if (!gf_cache_get_mem_usage(e)) continue;
+			if (gf_cache_get_sessions_count_for_cache_entry(e)) continue;
+			if (gf_cache_entry_persistent(e) || gf_cache_is_in_progress(e)) continue;
+			if (!lru || (gf_cache_get_last_access(e) < gf_cache_get_last_access(lru)))
+				lru = e;
+		}
+		if (!lru) break;
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_CACHE, ("[Cache] Evicting %s from memory cache\n", gf_cache_get_url(lru) ));
+		mem_size -= gf_cache_get_mem_usage(lru);
+		gf_list_del_item(dm->cache_entries, lru);
+		gf_cache_delete_entry(lru);
+		count--;
+	}
+}
 
 static void gf_dm_sess_notify_state(GF_DownloadSession *sess, GF_NetIOStatus dnload_status, GF_Err error);
 
@@ -1885,12 +1953,14 @@ static void gf_dm_configure_cache(GF_DownloadSession *sess)
 				}
 				sess->cache_entry = NULL;
 			}
-			entry = gf_cache_create_entry(sess->dm, sess->dm->cache_directory, sess->orig_url, sess->range_start, sess->range_end, (sess->flags&GF_NETIO_SESSION_MEMORY_CACHE) ? GF_TRUE : GF_FALSE, sess->dm->cache_mx);
+			entry = gf_cache_create_entry(sess->dm, sess->dm->cache_directory, sess->dm->cache_index, sess->orig_url, sess->range_start, sess->range_end, (sess->flags&GF_NETIO_SESSION_MEMORY_CACHE) ? GF_TRUE : GF_FALSE, sess->dm->cache_mx);
 			if (!entry) {
 				SET_LAST_ERR(GF_OUT_OF_MEM)
 				return;
 			}
 			gf_mx_p( sess->dm->cache_mx );
+			if (sess->flags & GF_NETIO_SESSION_MEMORY_CACHE)
+				gf_dm_evict_mem_cache(sess->dm, 0);
 			gf_list_add(sess->dm->cache_entries, entry);
 			gf_mx_v( sess->dm->cache_mx );
 			sess->is_range_continuation = GF_FALSE;
@@ -2186,6 +2256,199 @@ void gf_dm_sess_clear_headers(GF_DownloadSession *sess)
 	}
 }
 
+static void dm_idle_conn_del(GF_DMIdleConnection *ic)
+{
+#ifdef GPAC_HAS_SSL
+	if (ic->ssl) {
+		SSL_shutdown(ic->ssl);
+		SSL_free(ic->ssl);
+	}
+#endif
+	if (ic->sock) gf_sk_del(ic->sock);
+	if (ic->netcap_id) gf_free(ic->netcap_id);
+	gf_free(ic->server_name);
+	gf_free(ic);
+}
+
+//close expired idle connections - the manager cache mutex SHALL be grabbed before calling this
+static void dm_pool_purge(GF_DownloadManager *dm, u64 now)
+{
+	u32 i, count = gf_list_count(dm->idle_conns);
+	for (i=0; i<count; i++) {
+		GF_DMIdleConnection *ic = gf_list_get(dm->idle_conns, i);
+		if (ic->expire_time > now) continue;
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTP] Closing idle connection to %s:%d\n", ic->server_name, ic->port));
+		gf_list_rem(dm->idle_conns, i);
+		dm_idle_conn_del(ic);
+		i--;
+		count--;
+	}
+}
+
+//check if the session connection is idle, i.e. the last response has been fully read and the server keeps the connection alive
+static Bool dm_sess_connection_idle(GF_DownloadSession *sess)
+{
+	if (!sess->dm || !sess->dm->pool_idle || sess->server_mode) return GF_FALSE;
+	if (!sess->sock || !sess->server_name) return GF_FALSE;
+#ifdef GPAC_HAS_HTTP2
+	//HTTP/2 connections are shared through the H2 session
+	if (sess->h2_sess) return GF_FALSE;
+#endif
+	//proxied connections are not bound to the origin
+	if (sess->proxy_enabled==1) return GF_FALSE;
+	if (sess->put_state || sess->connection_close || sess->connect_pending || sess->async_buf_size || sess->remaining_data_size)
+		return GF_FALSE;
+	if ((sess->status != GF_NETIO_DATA_TRANSFERED) && (sess->status != GF_NETIO_DISCONNECTED))
+		return GF_FALSE;
+	if (sess->last_error && (sess->last_error != GF_EOS))
+		return GF_FALSE;
+	if (sess->total_size) {
+		if (sess->bytes_done != sess->total_size) return GF_FALSE;
+	} else if (!sess->chunked || !sess->last_chunk_found) {
+		return GF_FALSE;
+	}
+	if (sess->connection_timeout_ms && ((gf_sys_clock_high_res() - sess->last_fetch_time) / 1000 >= sess->connection_timeout_ms))
+		return GF_FALSE;
+	return GF_TRUE;
+}
+
+//move the session connection to the idle pool of the given origin
+static void dm_sess_park_connection(GF_DownloadSession *sess, const char *server_name, u16 port, Bool use_ssl)
+{
+	GF_DMIdleConnection *ic;
+	GF_DownloadManager *dm = sess->dm;
+	u64 now = gf_sys_clock_high_res();
+
+	GF_SAFEALLOC(ic, GF_DMIdleConnection);
+	if (!ic) return;
+	ic->server_name = gf_strdup(server_name);
+	ic->port = port;
+	ic->use_ssl = use_ssl;
+	if (sess->netcap_id) ic->netcap_id = gf_strdup(sess->netcap_id);
+	ic->keep_alive_ms = sess->connection_timeout_ms;
+	ic->last_fetch_time = sess->last_fetch_time;
+	ic->expire_time = now + 1000 * (u64) dm->pool_idle;
+	if (ic->keep_alive_ms && (sess->last_fetch_time + 1000 * (u64) ic->keep_alive_ms < ic->expire_time))
+		ic->expire_time = sess->last_fetch_time + 1000 * (u64) ic->keep_alive_ms;
+
+	if (sess->sock_group) gf_sk_group_unregister(sess->sock_group, sess->sock);
+	ic->sock = sess->sock;
+	sess->sock = NULL;
+#ifdef GPAC_HAS_SSL
+	ic->ssl = sess->ssl;
+	sess->ssl = NULL;
+#endif
+#ifdef GPAC_HAS_HTTP2
+	ic->h2_upgrade_state = sess->h2_upgrade_state;
+	sess->h2_upgrade_state = 0;
+#endif
+
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTP] Moving idle connection to %s:%d to pool\n", server_name, port));
+	gf_mx_p(dm->cache_mx);
+	dm_pool_purge(dm, now);
+	if (gf_list_count(dm->idle_conns) >= DM_POOL_MAX_IDLE) {
+		dm_idle_conn_del(gf_list_pop_front(dm->idle_conns));
+	}
+	gf_list_add(dm->idle_conns, ic);
+	gf_mx_v(dm->cache_mx);
+}
+
+//get an idle connection to the session origin from the pool, if any
+static Bool dm_sess_get_pooled_connection(GF_DownloadSession *sess)
+{
+	u32 i;
+	GF_DMIdleConnection *ic = NULL;
+	GF_DownloadManager *dm = sess->dm;
+	Bool use_ssl = (sess->flags & (GF_DOWNLOAD_SESSION_USE_SSL|GF_DOWNLOAD_SESSION_SSL_FORCED)) ? GF_TRUE : GF_FALSE;
+
+	if (!dm || !gf_list_count(dm->idle_conns) || !sess->server_name || sess->server_mode) return GF_FALSE;
+	if (gf_opts_get_bool("core", "proxy-on")) return GF_FALSE;
+
+	gf_mx_p(dm->cache_mx);
+	dm_pool_purge(dm, gf_sys_clock_high_res());
+	//most recently used first
+	i = gf_list_count(dm->idle_conns);
+	while (i) {
+		GF_DMIdleConnection *an_ic = gf_list_get(dm->idle_conns, i-1);
+		i--;
+		if ((an_ic->port != sess->port) || (an_ic->use_ssl != use_ssl)) continue;
+		if (strcmp(an_ic->server_name, sess->server_name)) continue;
+		if (sess->netcap_id || an_ic->netcap_id) {
+			if (!sess->netcap_id || !an_ic->netcap_id || strcmp(sess->netcap_id, an_ic->netcap_id)) continue;
+		}
+		ic = an_ic;
+		gf_list_rem(dm->idle_conns, i);
+		break;
+	}
+	gf_mx_v(dm->cache_mx);
+	if (!ic) return GF_FALSE;
+
+	sess->sock = ic->sock;
+	ic->sock = NULL;
+	gf_sk_set_block_mode(sess->sock, (sess->flags & GF_NETIO_SESSION_NO_BLOCK) ? GF_TRUE : GF_FALSE);
+	if (sess->sock_group) gf_sk_group_register(sess->sock_group, sess->sock);
+#ifdef GPAC_HAS_SSL
+	sess->ssl = ic->ssl;
+	ic->ssl = NULL;
+	if (sess->ssl && (sess->flags & GF_NETIO_SESSION_NO_BLOCK))
+		SSL_set_mode(sess->ssl, SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER|SSL_MODE_ENABLE_PARTIAL_WRITE);
+#endif
+#ifdef GPAC_HAS_HTTP2
+	sess->h2_upgrade_state = ic->h2_upgrade_state;
+#endif
+	sess->connection_timeout_ms = ic->keep_alive_ms;
+	sess->last_fetch_time = ic->last_fetch_time;
+	dm_idle_conn_del(ic);
+
+	GF_LOG(GF_LOG_INFO, GF_LOG_HTTP, ("[HTTP] Reusing idle connection to %s:%d for URL %s\n", sess->server_name, sess->port, sess->remote_path ? sess->remote_path : "undefined"));
+	return GF_TRUE;
+}
+
+//check if the session must wait for a connection slot on its origin
+//sessions waiting with a higher priority are granted the free slots first
+static Bool dm_sess_wait_connection_slot(GF_DownloadSession *sess)
+{
+	u32 i, count, nb_active=0, nb_prior=0;
+	GF_DownloadManager *dm = sess->dm;
+
+	if (!dm || !dm->max_conn || sess->server_mode || !sess->server_name) return GF_FALSE;
+	//blocking sessions cannot be delayed
+	if (!(sess->flags & GF_NETIO_SESSION_NO_BLOCK)) return GF_FALSE;
+#ifdef GPAC_HAS_HTTP2
+	if (sess->h2_sess) return GF_FALSE;
+#endif
+
+	gf_mx_p(dm->cache_mx);
+	count = gf_list_count(dm->sessions);
+	for (i=0; i<count; i++) {
+		GF_DownloadSession *a_sess = gf_list_get(dm->sessions, i);
+		if ((a_sess==sess) || a_sess->server_mode || !a_sess->server_name) continue;
+		if ((a_sess->port != sess->port) || strcmp(a_sess->server_name, sess->server_name)) continue;
+#ifdef GPAC_HAS_HTTP2
+		if (a_sess->h2_sess) continue;
+#endif
+		if (a_sess->conn_wait) {
+			if (a_sess->priority > sess->priority) nb_prior++;
+			continue;
+		}
+		if (!a_sess->sock) continue;
+		//connecting or request in progress
+		if ((a_sess->status==GF_NETIO_SETUP) || ((a_sess->status>GF_NETIO_CONNECTED) && (a_sess->status<GF_NETIO_DATA_TRANSFERED)))
+			nb_active++;
+	}
+	gf_mx_v(dm->cache_mx);
+
+	if (nb_active + nb_prior < dm->max_conn) {
+		sess->conn_wait = GF_FALSE;
+		return GF_FALSE;
+	}
+	if (!sess->conn_wait) {
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTP] %d active connections to %s:%d, delaying request %s\n", nb_active, sess->server_name, sess->port, sess->remote_path ? sess->remote_path : ""));
+	}
+	sess->conn_wait = GF_TRUE;
+	return GF_TRUE;
+}
+
 typedef enum
 {
 	HTTP_NO_CLOSE=0,
@@ -2198,6 +2461,7 @@ static void gf_dm_disconnect(GF_DownloadSession *sess, HTTPCloseType close_type)
 	gf_assert( sess );
 	if (sess->connection_close) close_type = HTTP_RESET_CONN;
 	sess->connection_close = GF_FALSE;
+	sess->conn_wait = GF_FALSE;
 	sess->remaining_data_size = 0;
 	sess->start_time = 0;
 	if (sess->async_req_reply) gf_free(sess->async_req_reply);
@@ -2268,6 +2532,10 @@ void gf_dm_sess_del(GF_DownloadSession *sess)
 		sess->destroy = GF_TRUE;
 		return;
 	}
+	//keep connection alive for other sessions to the same origin
+	if (dm_sess_connection_idle(sess))
+		dm_sess_park_connection(sess, sess->server_name, sess->port, (sess->flags & (GF_DOWNLOAD_SESSION_USE_SSL|GF_DOWNLOAD_SESSION_SSL_FORCED)) ? GF_TRUE : GF_FALSE);
+
 	gf_dm_disconnect(sess, HTTP_CLOSE);
 	gf_dm_sess_clear_headers(sess);
 
@@ -2616,13 +2884,23 @@ GF_Err gf_dm_sess_setup_from_url(GF_DownloadSession *sess, const char *url, Bool
 	GF_URL_Info info;
 	Bool free_proto = GF_FALSE;
 	char *sep_frag=NULL;
+	char *prev_server_name = NULL;
+	Bool conn_idle;
+	u16 prev_port;
+	Bool prev_ssl;
 	if (!url)
 		return GF_BAD_PARAM;
 
 	gf_dm_sess_clear_headers(sess);
 	sess->allow_direct_reuse = allow_direct_reuse;
+	sess->conn_wait = GF_FALSE;
 	gf_dm_url_info_init(&info);
 
+	//if the connection is idle and no longer usable by this session, it will be moved to the connection pool
+	conn_idle = dm_sess_connection_idle(sess);
+	prev_port = sess->port;
+	prev_ssl = (sess->flags & (GF_DOWNLOAD_SESSION_USE_SSL|GF_DOWNLOAD_SESSION_SSL_FORCED)) ? GF_TRUE : GF_FALSE;
+
 	if (!sess->sock)
 		socket_changed = GF_TRUE;
 	else if (sess->status>GF_NETIO_DISCONNECTED)
@@ -2698,7 +2976,7 @@ GF_Err gf_dm_sess_setup_from_url(GF_DownloadSession *sess, const char *url, Bool
 	if (sess->server_name && info.server_name && !strcmp(sess->server_name, info.server_name)) {
 	} else {
 		socket_changed = GF_TRUE;
-		if (sess->server_name) gf_free(sess->server_name);
+		prev_server_name = sess->server_name;
 		sess->server_name = info.server_name ? gf_strdup(info.server_name) : NULL;
 	}
 
@@ -2730,6 +3008,11 @@ GF_Err gf_dm_sess_setup_from_url(GF_DownloadSession *sess, const char *url, Bool
 	gf_dm_url_info_del(&info);
 	if (sep_frag) sep_frag[0]='#';
 
+	if (socket_changed && conn_idle) {
+		dm_sess_park_connection(sess, prev_server_name ? prev_server_name : sess->server_name, prev_port, prev_ssl);
+	}
+	if (prev_server_name) gf_free(prev_server_name);
+
 #ifdef GPAC_HAS_HTTP2
 	if (sess->h2_sess) {
 		if (sess->h2_sess->do_shutdown)
@@ -3409,6 +3692,27 @@ static void gf_dm_connect(GF_DownloadSession *sess)
 
 	Bool register_sock = GF_FALSE;
 	if (!sess->sock) {
+		if (dm_sess_get_pooled_connection(sess)) {
+			sess->connect_pending = 0;
+			sess->connect_time = 0;
+			sess->ssl_setup_time = 0;
+			SET_LAST_ERR(GF_OK)
+			if (sess->allow_direct_reuse) {
+				gf_dm_configure_cache(sess);
+				if (sess->from_cache_only) return;
+			}
+			sess->status = GF_NETIO_CONNECTED;
+			gf_dm_sess_notify_state(sess, GF_NETIO_CONNECTED, GF_OK);
+			gf_dm_configure_cache(sess);
+			return;
+		}
+		//too many connections to origin, wait
+		if (dm_sess_wait_connection_slot(sess)) {
+			sess->status = GF_NETIO_SETUP;
+			sess->connect_pending = 1;
+			SET_LAST_ERR(GF_IP_NETWORK_EMPTY)
+			return;
+		}
 		sess->sock = gf_sk_new_ex(GF_SOCK_TYPE_TCP, sess->netcap_id);
 
 		if (sess->sock && (sess->flags & GF_NETIO_SESSION_NO_BLOCK))
@@ -3948,8 +4252,8 @@ typedef struct
 static void gf_dm_clean_cache(GF_DownloadManager *dm)
 {
 	u64 out_size = gf_cache_get_size(dm->cache_directory);
-	if (out_size >= dm->max_cache_size) {
-		GF_LOG(dm->max_cache_size ? GF_LOG_WARNING : GF_LOG_INFO, GF_LOG_HTTP, ("[Cache] Cache size %d exceeds max allowed %d, deleting entire cache\n", out_size, dm->max_cache_size));
+	if (out_size) {
+		GF_LOG(GF_LOG_INFO, GF_LOG_HTTP, ("[Cache] Deleting entire cache ("LLU" bytes)\n", out_size));
 		gf_cache_delete_all_cached_files(dm->cache_directory);
 	}
 }
@@ -3978,6 +4282,10 @@ GF_DownloadManager *gf_dm_new(GF_FilterSession *fsess)
 #ifdef GPAC_HAS_HTTP2
 	dm->disable_http2 = gf_opts_get_bool("core", "no-h2");
 #endif
+	dm->idle_conns = gf_list_new();
+	dm->max_conn = gf_opts_get_int("core", "max-conn");
+	opt = gf_opts_get_key("core", "conn-pool");
+	dm->pool_idle = opt ? atoi(opt) : 5000;
 
 	opt = gf_opts_get_key("core", "cache");
 
@@ -4038,10 +4346,10 @@ retry_cache:
 		gf_dm_clean_cache(dm);
 	} else {
 		dm->max_cache_size = gf_opts_get_int("core", "cache-size");
-		if (dm->max_cache_size) {
-			gf_dm_clean_cache(dm);
-		}
 	}
+	//least recently used entries are evicted when loading the index if cache is too large
+	dm->cache_index = gf_cache_index_new(dm->cache_directory, dm->max_cache_size);
+	dm->max_mem_cache = gf_opts_get_int("core", "cache-mem");
 	dm->allow_broken_certificate = gf_opts_get_bool("core", "broken-cert");
 
 	gf_mx_v( dm->cache_mx );
@@ -4091,6 +4399,11 @@ void gf_dm_del(GF_DownloadManager *dm)
 	}
 	gf_list_del(dm->sessions);
 	dm->sessions = NULL;
+	while (gf_list_count(dm->idle_conns)) {
+		dm_idle_conn_del(gf_list_pop_back(dm->idle_conns));
+	}
+	gf_list_del(dm->idle_conns);
+	dm->idle_conns = NULL;
 	gf_assert( dm->skip_proxy_servers );
 	while (gf_list_count(dm->skip_proxy_servers)) {
 		char *serv = (char*)gf_list_get(dm->skip_proxy_servers, 0);
@@ -4121,6 +4434,8 @@ void gf_dm_del(GF_DownloadManager *dm)
 		gf_list_del( dm->cache_entries );
 		dm->cache_entries = NULL;
 	}
+	gf_cache_index_del(dm->cache_index);
+	dm->cache_index = NULL;
 
 	gf_list_del( dm->partial_downloads );
 	dm->partial_downloads = NULL;
@@ -6384,6 +6699,8 @@ void http_do_requests(GF_DownloadSession *sess)
 	case GF_NETIO_CONNECTED:
 		if (sess->server_mode) {
 			wait_for_header_and_parse(sess, sHTTP);
+		} else if (!sess->put_state && dm_sess_wait_connection_slot(sess)) {
+			SET_LAST_ERR(GF_IP_NETWORK_EMPTY)
 		} else {
 			http_send_headers(sess, sHTTP);
 		}
@@ -6922,7 +7239,7 @@ DownloadedCacheEntry gf_dm_add_cache_entry(GF_DownloadManager *dm, const char *s
 		break;
 	}
 	if (!the_entry) {
-		the_entry = gf_cache_create_entry(dm, "", szURL, 0, 0, GF_TRUE, dm->cache_mx);
+		the_entry = gf_cache_create_entry(dm, "", NULL, szURL, 0, 0, GF_TRUE, dm->cache_mx);
 		if (!the_entry) {
 			gf_mx_v(dm->cache_mx );
 			return NULL;
@@ -7200,6 +7517,12 @@ void gf_dm_sess_set_netcap_id(GF_DownloadSession *sess, const char *netcap_id)
 	if (sess) sess->netcap_id = netcap_id;
 }
 
+GF_EXPORT
+void gf_dm_sess_set_priority(GF_DownloadSession *sess, u32 priority)
+{
+	if (sess) sess->priority = priority;
+}
+
 
 //end GAPC_DISABLE_NETWORK
 #elif defined(GPAC_CONFIG_EMSCRIPTEN)
@@ -8082,6 +8405,10 @@ void gf_dm_sess_detach_async(GF_DownloadSession *sess)
 void gf_dm_sess_set_netcap_id(GF_DownloadSession *sess, const char *netcap_id)
 {
 
+}
+void gf_dm_sess_set_priority(GF_DownloadSession *sess, u32 priority)
+{
+
 }
 
 #endif // GPAC_CONFIG_EMSCRIPTEN
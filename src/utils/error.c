@@ -1031,12 +1031,47 @@ static const u32 gf_crc_table[256] = {
 	0xbcb4666d, 0xb8757bda, 0xb5365d03, 0xb1f740b4
 };
 
+/*slicing-by-8 tables, table 0 is gf_crc_table - built once at gf_sys_init time, the byte-wise loop is used until then*/
+static u32 gf_crc_slice_table[8][256];
+static Bool gf_crc_slice_ready = GF_FALSE;
+
+void gf_crc_init_tables()
+{
+	u32 i, k;
+	if (gf_crc_slice_ready) return;
+	for (i=0; i<256; i++) {
+		gf_crc_slice_table[0][i] = gf_crc_table[i];
+	}
+	for (k=1; k<8; k++) {
+		for (i=0; i<256; i++) {
+			u32 v = gf_crc_slice_table[k-1][i];
+			gf_crc_slice_table[k][i] = (v << 8) ^ gf_crc_table[v >> 24];
+		}
+	}
+	gf_crc_slice_ready = GF_TRUE;
+}
+
 GF_EXPORT
 u32 gf_crc_32(const u8 *data, u32 len)
 {
 	register u32 i;
 	u32 crc = 0xffffffff;
 	if (!data) return 0;
+
+	/*MPEG-2 CRC is MSB-first, process 8 bytes per iteration with one lookup per byte and no loop-carried shifts
+	note: SSE4.2/ARMv8 crc32 instructions implement the reflected polynomial and cannot be used here*/
+	if (gf_crc_slice_ready) {
+		while (len>=8) {
+			u32 one = crc ^ ( ((u32)data[0]<<24) | ((u32)data[1]<<16) | ((u32)data[2]<<8) | (u32)data[3]);
+			u32 two = ((u32)data[4]<<24) | ((u32)data[5]<<16) | ((u32)data[6]<<8) | (u32)data[7];
+			crc = gf_crc_slice_table[7][one>>24] ^ gf_crc_slice_table[6][(one>>16) & 0xff]
+				^ gf_crc_slice_table[5][(one>>8) & 0xff] ^ gf_crc_slice_table[4][one & 0xff]
+				^ gf_crc_slice_table[3][two>>24] ^ gf_crc_slice_table[2][(two>>16) & 0xff]
+				^ gf_crc_slice_table[1][(two>>8) & 0xff] ^ gf_crc_slice_table[0][two & 0xff];
+			data += 8;
+			len -= 8;
+		}
+	}
 	for (i=0; i<len; i++)
 		crc = (crc << 8) ^ gf_crc_table[((crc >> 24) ^ *data++) & 0xff];
 
@@ -1420,6 +1455,9 @@ static const char *gf_disabled_features()
 #ifdef GPAC_DISABLE_RFTRUEHD
 	                       "GPAC_DISABLE_RFTRUEHD "
 #endif
+#ifdef GPAC_DISABLE_PSPLIT
+	                       "GPAC_DISABLE_PSPLIT "
+#endif
 #ifdef GPAC_DISABLE_REFRAMER
 	                       "GPAC_DISABLE_REFRAMER "
 #endif
@@ -915,6 +915,7 @@ char gf_prog_lf = '\r';
 
 #ifndef GPAC_DISABLE_NETWORK
 extern Bool gpac_use_poll;
+extern Bool gpac_use_epoll;
 #endif
 
 GF_EXPORT
@@ -929,6 +930,7 @@ GF_Err gf_sys_set_args(s32 argc, const char **argv)
 
 #ifndef GPAC_DISABLE_NETWORK
 		gpac_use_poll = GF_TRUE;
+		gpac_use_epoll = GF_TRUE;
 #endif
 		for (i=1; i<argc; i++) {
 			Bool consumed;
@@ -999,7 +1001,11 @@ GF_Err gf_sys_set_args(s32 argc, const char **argv)
 				gpac_discard_config = bool_value;
 			} else if (!stricmp(arg, "-no-poll")) {
 #ifndef GPAC_DISABLE_NETWORK
-				gpac_use_poll = bool_value;
+				gpac_use_poll = !bool_value;
+#endif
+			} else if (!stricmp(arg, "-no-epoll")) {
+#ifndef GPAC_DISABLE_NETWORK
+				gpac_use_epoll = !bool_value;
 #endif
 			}
 #if !defined(GPAC_DISABLE_NETCAP)
@@ -1348,6 +1354,7 @@ GF_Blob *gf_blob_from_url(const char *blob_url)
 
 void gf_init_global_config(const char *profile);
 void gf_uninit_global_config(Bool discard_config);
+void gf_crc_init_tables();
 
 static GF_Config *gpac_lang_file = NULL;
 static const char *gpac_lang_code = NULL;
@@ -1538,6 +1545,7 @@ GF_Err gf_sys_init(GF_MemTrackerType mem_tracker_type, const char *profile)
 		logs_mx = gf_mx_new("Logs");
 #endif
 		gf_rand_init(GF_FALSE);
+		gf_crc_init_tables();
 
 		gf_init_global_config(profile);
 
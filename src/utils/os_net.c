@@ -23,6 +23,11 @@
  *
  */
 
+//for recvmmsg/sendmmsg
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include <gpac/network.h>
 
 #ifndef GPAC_DISABLE_NETWORK
@@ -153,6 +158,21 @@ typedef s32 SOCKET;
 
 #define GF_POLLFD	struct pollfd
 
+#if defined(GPAC_CONFIG_LINUX) && !defined(GPAC_DISABLE_EPOLL)
+#define GPAC_HAS_EPOLL
+#include <sys/epoll.h>
+#endif
+
+#if defined(GPAC_CONFIG_LINUX) && !defined(GPAC_DISABLE_MMSG)
+#define GPAC_HAS_MMSG
+#endif
+
+#endif
+
+#if defined(GPAC_CONFIG_LINUX) && defined(SO_TXTIME) && !defined(GPAC_DISABLE_TXTIME)
+#define GPAC_HAS_TXTIME
+#include <linux/net_tstamp.h>
+#include <time.h>
 #endif
 
 #endif /*WIN32||_WIN32_WCE*/
@@ -430,6 +450,10 @@ struct __tag_socket
 #ifndef GPAC_DISABLE_NETCAP
 	NetCapInfo *cap_info;
 #endif
+	//packet pacing: rate in bps, bucket size in bytes, tokens in 1/GF_SK_PACE_SCALE bytes, last bucket refill time in us
+	u32 pace_rate, pace_burst, pace_flags;
+	s64 pace_tokens;
+	u64 pace_last;
 };
 
 
@@ -2390,6 +2414,7 @@ GF_Err gf_sk_bind(GF_Socket *sock, const char *ifce_ip_or_name, u16 port, const
 }
 
 Bool gpac_use_poll=GF_TRUE;
+Bool gpac_use_epoll=GF_TRUE;
 
 static GF_Err poll_select(GF_Socket *sock, GF_SockSelectMode mode, u32 usec, Bool force_select)
 {
@@ -2465,6 +2490,189 @@ static GF_Err poll_select(GF_Socket *sock, GF_SockSelectMode mode, u32 usec, Boo
 #endif
 }
 
+#if defined(GPAC_HAS_MMSG) || defined(GPAC_HAS_TXTIME)
+//max number of datagrams per recvmmsg/sendmmsg call
+#define GF_SK_MAX_BATCH	64
+
+static GF_Err gf_sk_batch_error(const char *op)
+{
+	switch (LASTSOCKERROR) {
+	case EAGAIN:
+		return GF_IP_NETWORK_EMPTY;
+	case ENOTCONN:
+	case ECONNRESET:
+	case ECONNABORTED:
+	case EPIPE:
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_NETWORK, ("[socket] error %s: %s\n", op, gf_errno_str(LASTSOCKERROR)));
+		return GF_IP_CONNECTION_CLOSED;
+	case ENOBUFS:
+		GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[socket] error %s: %s\n", op, gf_errno_str(LASTSOCKERROR)));
+		return GF_BUFFER_TOO_SMALL;
+	default:
+		GF_LOG(GF_LOG_ERROR, GF_LOG_NETWORK, ("[socket] error %s: %s\n", op, gf_errno_str(LASTSOCKERROR)));
+		return GF_IP_NETWORK_FAILURE;
+	}
+}
+#endif
+
+//when launch times are set by the kernel, packets are handed over up to this many microseconds ahead of time
+#define GF_SK_TXTIME_LOOKAHEAD	2000
+//bucket tokens are expressed in 1/8000000 bytes, so that filling the bucket (rate in bps times elapsed us) has no rounding
+#define GF_SK_PACE_SCALE	8000000
+
+GF_EXPORT
+GF_Err gf_sk_set_pacing(GF_Socket *sock, u32 rate, u32 burst, u32 flags)
+{
+	if (!sock) return GF_BAD_PARAM;
+#ifdef SO_MAX_PACING_RATE
+	//kernel pacing no longer used, remove rate limit
+	if ((sock->pace_flags & GF_SK_PACING_KERNEL) && sock->socket && (!rate || !(flags & GF_SK_PACING_KERNEL))) {
+		u32 no_limit = 0xFFFFFFFF;
+		if (setsockopt(sock->socket, SOL_SOCKET, SO_MAX_PACING_RATE, (char *) &no_limit, sizeof(no_limit)) == SOCKET_ERROR) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] Cannot reset kernel pacing rate: %s\n", gf_errno_str(LASTSOCKERROR) ));
+		}
+	}
+#endif
+	sock->pace_rate = rate;
+	sock->pace_flags = 0;
+	if (!rate) return GF_OK;
+
+	//default bucket is 1 ms of data, and at least one full ethernet datagram
+	if (!burst) {
+		burst = rate / 8000;
+		if (burst < 1500) burst = 1500;
+	}
+	sock->pace_burst = burst;
+	sock->pace_tokens = (s64) burst * GF_SK_PACE_SCALE;
+	sock->pace_last = gf_sys_clock_high_res();
+	if (!sock->socket) return GF_OK;
+
+	if (flags & GF_SK_PACING_KERNEL) {
+#ifdef SO_MAX_PACING_RATE
+		u32 bytes_per_sec = rate / 8;
+		if (setsockopt(sock->socket, SOL_SOCKET, SO_MAX_PACING_RATE, (char *) &bytes_per_sec, sizeof(bytes_per_sec)) == SOCKET_ERROR) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] Cannot set kernel pacing rate: %s - using software pacing only\n", gf_errno_str(LASTSOCKERROR) ));
+		} else {
+			sock->pace_flags |= GF_SK_PACING_KERNEL;
+		}
+#else
+		GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] Kernel pacing not supported on this platform - using software pacing only\n"));
+#endif
+	}
+	if (flags & GF_SK_PACING_TXTIME) {
+#ifdef GPAC_HAS_TXTIME
+		struct sock_txtime txcfg;
+		memset(&txcfg, 0, sizeof(txcfg));
+		txcfg.clockid = CLOCK_MONOTONIC;
+		if (sock->flags & GF_SOCK_IS_TCP) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] Launch time only supported for UDP sockets - using software pacing only\n"));
+		} else if (setsockopt(sock->socket, SOL_SOCKET, SO_TXTIME, (char *) &txcfg, sizeof(txcfg)) == SOCKET_ERROR) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] Cannot enable launch time: %s - using software pacing only\n", gf_errno_str(LASTSOCKERROR) ));
+		} else {
+			sock->pace_flags |= GF_SK_PACING_TXTIME;
+		}
+#else
+		GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] Launch time not supported on this platform - using software pacing only\n"));
+#endif
+	}
+	return GF_OK;
+}
+
+static void sk_pacing_refill(GF_Socket *sock)
+{
+	u64 now = gf_sys_clock_high_res();
+	u64 elapsed = now - sock->pace_last;
+	s64 max_tokens = (s64) sock->pace_burst * GF_SK_PACE_SCALE;
+	sock->pace_last = now;
+	//avoid overflow after long idle periods
+	if (elapsed > 10000000) elapsed = 10000000;
+	sock->pace_tokens += (s64) (elapsed * sock->pace_rate);
+	if (sock->pace_tokens > max_tokens)
+		sock->pace_tokens = max_tokens;
+}
+
+GF_EXPORT
+u32 gf_sk_pacing_delay(GF_Socket *sock, u32 size)
+{
+	u64 delay;
+	if (!sock || !sock->pace_rate) return 0;
+	sk_pacing_refill(sock);
+	//datagrams larger than the bucket only wait for a full bucket
+	if (size > sock->pace_burst) size = sock->pace_burst;
+	if (sock->pace_tokens >= (s64) size * GF_SK_PACE_SCALE) return 0;
+
+	delay = ((s64) size * GF_SK_PACE_SCALE - sock->pace_tokens) / sock->pace_rate;
+	if (sock->pace_flags & GF_SK_PACING_TXTIME) {
+		if (delay <= GF_SK_TXTIME_LOOKAHEAD) return 0;
+		delay -= GF_SK_TXTIME_LOOKAHEAD;
+	}
+	return delay ? (u32) delay : 1;
+}
+
+//consumes bucket bytes for a datagram about to be sent, returns the delay in microseconds until the datagram is within rate
+static u32 sk_pacing_consume(GF_Socket *sock, u32 size)
+{
+	u32 delay = 0;
+	s64 needed = (s64) size * GF_SK_PACE_SCALE;
+	sk_pacing_refill(sock);
+	if (sock->pace_tokens < needed)
+		delay = (u32) ( (needed - sock->pace_tokens) / sock->pace_rate);
+	sock->pace_tokens -= needed;
+	return delay;
+}
+
+#ifdef GPAC_HAS_TXTIME
+static u64 sk_launch_time(u32 delay_us)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((u64) ts.tv_sec) * 1000000000 + ts.tv_nsec + ((u64) delay_us) * 1000;
+}
+
+//send a datagram with its launch time
+static GF_Err sk_send_txtime(GF_Socket *sock, const u8 *buffer, u32 length, u32 delay_us, u32 *written)
+{
+	struct msghdr msg;
+	struct iovec iov;
+	struct cmsghdr *cm;
+	char cbuf[CMSG_SPACE(sizeof(u64))];
+	u64 launch = sk_launch_time(delay_us);
+	s32 res;
+	int sflags = 0;
+
+	memset(&msg, 0, sizeof(msg));
+	memset(cbuf, 0, sizeof(cbuf));
+	iov.iov_base = (void *) buffer;
+	iov.iov_len = length;
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	if (sock->flags & GF_SOCK_HAS_PEER) {
+		msg.msg_name = &sock->dest_addr;
+		msg.msg_namelen = sock->dest_addr_len;
+	}
+#ifdef MSG_NOSIGNAL
+	else {
+		sflags = MSG_NOSIGNAL;
+	}
+#endif
+	msg.msg_control = cbuf;
+	msg.msg_controllen = sizeof(cbuf);
+	cm = CMSG_FIRSTHDR(&msg);
+	cm->cmsg_level = SOL_SOCKET;
+	cm->cmsg_type = SCM_TXTIME;
+	cm->cmsg_len = CMSG_LEN(sizeof(u64));
+	memcpy(CMSG_DATA(cm), &launch, sizeof(u64));
+
+	res = (s32) sendmsg(sock->socket, &msg, sflags);
+	if (res == SOCKET_ERROR) {
+		sock->pace_tokens += (s64) length * GF_SK_PACE_SCALE;
+		return gf_sk_batch_error("sending");
+	}
+	if (written) *written = res;
+	return GF_OK;
+}
+#endif
+
 //send length bytes of a buffer
 GF_EXPORT
 GF_Err gf_sk_send_ex(GF_Socket *sock, const u8 *buffer, u32 length, u32 *written)
@@ -2501,6 +2709,14 @@ GF_Err gf_sk_send_ex(GF_Socket *sock, const u8 *buffer, u32 length, u32 *written
 		if (e) return e;
 	}
 
+	if (sock->pace_rate) {
+#ifdef GPAC_HAS_TXTIME
+		if (sock->pace_flags & GF_SK_PACING_TXTIME)
+			return sk_send_txtime(sock, buffer, length, sk_pacing_consume(sock, length), written);
+#endif
+		sk_pacing_consume(sock, length);
+	}
+
 	//direct writing
 	count = 0;
 	while (count < length) {
@@ -2514,6 +2730,8 @@ GF_Err gf_sk_send_ex(GF_Socket *sock, const u8 *buffer, u32 length, u32 *written
 			res = (s32) send(sock->socket, (char *) buffer+count, length - count, sflags);
 		}
 		if (res == SOCKET_ERROR) {
+			//give back pacing budget, the data will be sent again
+			if (sock->pace_rate) sock->pace_tokens += (s64) (length - count) * GF_SK_PACE_SCALE;
 			switch (res = LASTSOCKERROR) {
 			case EAGAIN:
 				return GF_IP_NETWORK_EMPTY;
@@ -3239,6 +3457,17 @@ struct __tag_sock_group
 	GF_POLLFD *fds;
 #endif
 
+#ifdef GPAC_HAS_EPOLL
+	Bool use_epoll;
+	//epoll instance per select mode (both, read, write), created at first select in that mode, -1 if not created
+	int epfd[3];
+	//nb sockets registered, nb events of last wait
+	u32 nb_ep_socks, nb_ep_ready;
+	u32 alloc_ep_events;
+	//events of last wait, sorted by socket
+	struct epoll_event *ep_events;
+#endif
+
 #ifndef GPAC_DISABLE_NETCAP
 	u32 nb_nfs;
 	u32 nb_socks;
@@ -3255,6 +3484,9 @@ GF_SockGroup *gf_sk_group_new()
 
 #ifdef GPAC_HAS_POLL
 	tmp->last_mask = POLLIN;
+#endif
+#ifdef GPAC_HAS_EPOLL
+	tmp->epfd[0] = tmp->epfd[1] = tmp->epfd[2] = -1;
 #endif
 	return tmp;
 }
@@ -3264,10 +3496,50 @@ void gf_sk_group_del(GF_SockGroup *sg)
 	gf_list_del(sg->sockets);
 #ifdef GPAC_HAS_POLL
 	if (sg->fds) gf_free(sg->fds);
+#endif
+#ifdef GPAC_HAS_EPOLL
+	if (sg->epfd[GF_SK_SELECT_BOTH]>=0) close(sg->epfd[GF_SK_SELECT_BOTH]);
+	if (sg->epfd[GF_SK_SELECT_READ]>=0) close(sg->epfd[GF_SK_SELECT_READ]);
+	if (sg->epfd[GF_SK_SELECT_WRITE]>=0) close(sg->epfd[GF_SK_SELECT_WRITE]);
+	if (sg->ep_events) gf_free(sg->ep_events);
 #endif
 	gf_free(sg);
 }
 
+#ifdef GPAC_HAS_EPOLL
+//each select mode uses its own epoll set: a single EPOLLIN|EPOLLOUT set would never block when waiting for
+//data on writable sockets, and switching the mask would require one EPOLL_CTL_MOD per socket
+static void gf_sk_group_epoll_ctl(GF_SockGroup *sg, u32 mode, GF_Socket *sk, int op)
+{
+	struct epoll_event ev;
+	memset(&ev, 0, sizeof(struct epoll_event));
+	if (mode != GF_SK_SELECT_WRITE) ev.events |= EPOLLIN;
+	if (mode != GF_SK_SELECT_READ) ev.events |= EPOLLOUT;
+	ev.data.ptr = sk;
+	//on removal, socket may already be closed, in which case it was removed from the epoll set by the kernel
+	if ((epoll_ctl(sg->epfd[mode], op, sk->socket, &ev) < 0) && (op != EPOLL_CTL_DEL)) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] cannot update epoll registration: %s\n", gf_errno_str(LASTSOCKERROR) ));
+	}
+}
+
+static int gf_sk_group_epoll_cmp(const void *a, const void *b)
+{
+	uintptr_t pa = (uintptr_t) ((const struct epoll_event *)a)->data.ptr;
+	uintptr_t pb = (uintptr_t) ((const struct epoll_event *)b)->data.ptr;
+	if (pa<pb) return -1;
+	if (pa>pb) return 1;
+	return 0;
+}
+
+static struct epoll_event *gf_sk_group_epoll_find(GF_SockGroup *sg, GF_Socket *sk)
+{
+	struct epoll_event key;
+	if (!sg->nb_ep_ready) return NULL;
+	key.data.ptr = sk;
+	return bsearch(&key, sg->ep_events, sg->nb_ep_ready, sizeof(struct epoll_event), gf_sk_group_epoll_cmp);
+}
+#endif
+
 void gf_sk_group_register(GF_SockGroup *sg, GF_Socket *sk)
 {
 	if (!sg || !sk) return;
@@ -3283,6 +3555,20 @@ void gf_sk_group_register(GF_SockGroup *sg, GF_Socket *sk)
 	}
 #endif
 
+#ifdef GPAC_HAS_EPOLL
+	//sockets stay registered in the epoll sets, no per-select setup
+	if (!sg->use_epoll && !sg->fds && gpac_use_poll && gpac_use_epoll)
+		sg->use_epoll = GF_TRUE;
+	if (sg->use_epoll) {
+		u32 i;
+		for (i=0; i<3; i++) {
+			if (sg->epfd[i]>=0) gf_sk_group_epoll_ctl(sg, i, sk, EPOLL_CTL_ADD);
+		}
+		sg->nb_ep_socks++;
+		return;
+	}
+#endif
+
 #ifdef GPAC_HAS_POLL
 	if (!sg->fds && !gpac_use_poll)
 		return;
@@ -3321,6 +3607,32 @@ void gf_sk_group_unregister(GF_SockGroup *sg, GF_Socket *sk)
 	}
 #endif
 
+#ifdef GPAC_HAS_EPOLL
+	if (sg->use_epoll) {
+		if (pidx>=0) {
+			u32 i;
+			struct epoll_event *ev;
+			for (i=0; i<3; i++) {
+				if (sg->epfd[i]>=0) gf_sk_group_epoll_ctl(sg, i, sk, EPOLL_CTL_DEL);
+			}
+			//socket is no longer in the sets whether removed by us or by the kernel
+			if (sg->nb_ep_socks) sg->nb_ep_socks--;
+			//forget pending events of the socket
+			ev = gf_sk_group_epoll_find(sg, sk);
+			if (ev) {
+				u32 idx = (u32) (ev - sg->ep_events);
+				memmove(ev, ev+1, sizeof(struct epoll_event) * (sg->nb_ep_ready - idx - 1));
+				sg->nb_ep_ready--;
+			}
+		}
+		if (!gf_list_count(sg->sockets)) {
+			gf_list_del(sg->sockets);
+			sg->sockets = NULL;
+		}
+		return;
+	}
+#endif
+
 	if (!gf_list_count(sg->sockets)) {
 		gf_list_del(sg->sockets);
 		sg->sockets = NULL;
@@ -3401,6 +3713,55 @@ GF_Err gf_sk_group_select(GF_SockGroup *sg, u32 usec_wait, GF_SockSelectMode mod
 	}
 #endif
 
+#ifdef GPAC_HAS_EPOLL
+	if (sg->use_epoll) {
+		int res;
+		sg->nb_ep_ready = 0;
+		if (!sg->nb_ep_socks)
+			return GF_IP_NETWORK_EMPTY;
+		if (sg->epfd[mode]<0) {
+			sg->epfd[mode] = epoll_create1(EPOLL_CLOEXEC);
+			if (sg->epfd[mode]<0) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] cannot create epoll instance: %s\n", gf_errno_str(LASTSOCKERROR) ));
+				return GF_IP_NETWORK_FAILURE;
+			}
+			i=0;
+			while ((sock = gf_list_enum(sg->sockets, &i))) {
+#ifndef GPAC_DISABLE_NETCAP
+				if (sock->cap_info) continue;
+#endif
+				gf_sk_group_epoll_ctl(sg, mode, sock, EPOLL_CTL_ADD);
+			}
+		}
+		if (sg->alloc_ep_events < sg->nb_ep_socks) {
+			sg->alloc_ep_events = sg->nb_ep_socks;
+			sg->ep_events = gf_realloc(sg->ep_events, sizeof(struct epoll_event) * sg->alloc_ep_events);
+			if (!sg->ep_events) {
+				sg->alloc_ep_events = 0;
+				return GF_OUT_OF_MEM;
+			}
+		}
+		res = epoll_wait(sg->epfd[mode], sg->ep_events, sg->nb_ep_socks, usec_wait/1000);
+		if (res<0) {
+			switch (LASTSOCKERROR) {
+			case EAGAIN:
+			case EINTR:
+				return GF_IP_NETWORK_EMPTY;
+			default:
+				GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] cannot epoll: %s\n", gf_errno_str(LASTSOCKERROR) ));
+				return GF_IP_NETWORK_FAILURE;
+			}
+		}
+		if (!res)
+			return GF_IP_NETWORK_EMPTY;
+		//keep ready sockets sorted, so that readiness check does not depend on the number of sockets in the group
+		sg->nb_ep_ready = (u32) res;
+		if (res>1)
+			qsort(sg->ep_events, res, sizeof(struct epoll_event), gf_sk_group_epoll_cmp);
+		return GF_OK;
+	}
+#endif
+
 #ifdef GPAC_HAS_POLL
 	if (sg->fds) {
 		u32 mask = 0;
@@ -3503,6 +3864,21 @@ Bool gf_sk_group_sock_is_set(GF_SockGroup *sg, GF_Socket *sk, GF_SockSelectMode
 	}
 #endif
 
+#ifdef GPAC_HAS_EPOLL
+	if (sg->use_epoll) {
+		struct epoll_event *ev = gf_sk_group_epoll_find(sg, sk);
+		if (!ev) return GF_FALSE;
+		//disconnected, consider ready to read/write
+		if (ev->events & (EPOLLHUP|EPOLLERR))
+			return GF_TRUE;
+		if ((mode!=GF_SK_SELECT_WRITE) && (ev->events & EPOLLIN))
+			return GF_TRUE;
+		if ((mode!=GF_SK_SELECT_READ) && (ev->events & EPOLLOUT))
+			return GF_TRUE;
+		return GF_FALSE;
+	}
+#endif
+
 #ifdef GPAC_HAS_POLL
 	if (sg->fds && sk->poll_idx) {
 		GF_POLLFD *pfd = &sg->fds[sk->poll_idx-1];
@@ -3655,6 +4031,169 @@ GF_Err gf_sk_receive_no_select(GF_Socket *sock, u8 *buffer, u32 length, u32 *Byt
 	return gf_sk_receive_internal(sock, buffer, length, BytesRead, GF_FALSE);
 }
 
+
+GF_EXPORT
+GF_Err gf_sk_receive_batch(GF_Socket *sock, u8 *buffer, u32 slot_size, u32 nb_slots, u32 *sizes, u32 *nb_read)
+{
+	u32 i;
+	GF_Err e;
+	if (!nb_read) return GF_BAD_PARAM;
+	*nb_read = 0;
+	if (!sock || !buffer || !sizes || !nb_slots || !slot_size) return GF_BAD_PARAM;
+
+#ifdef GPAC_HAS_MMSG
+	//netcap needs per-packet processing, use regular path
+	if (sock->socket && !(sock->flags & GF_SOCK_IS_TCP)
+#ifndef GPAC_DISABLE_NETCAP
+		&& !sock->cap_info
+#endif
+	) {
+		struct mmsghdr msgs[GF_SK_MAX_BATCH];
+		struct iovec iovs[GF_SK_MAX_BATCH];
+		s32 res;
+		if (nb_slots > GF_SK_MAX_BATCH) nb_slots = GF_SK_MAX_BATCH;
+
+		memset(msgs, 0, sizeof(struct mmsghdr)*nb_slots);
+		for (i=0; i<nb_slots; i++) {
+			iovs[i].iov_base = buffer + i*slot_size;
+			iovs[i].iov_len = slot_size;
+			msgs[i].msg_hdr.msg_iov = &iovs[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+			//same as recvfrom, dest_addr is set to the address of the last received datagram
+			if (sock->flags & GF_SOCK_HAS_PEER) {
+				msgs[i].msg_hdr.msg_name = &sock->dest_addr;
+				msgs[i].msg_hdr.msg_namelen = sizeof(sock->dest_addr);
+			}
+		}
+		res = recvmmsg(sock->socket, msgs, nb_slots, MSG_DONTWAIT, NULL);
+		if (res == SOCKET_ERROR) {
+			if (LASTSOCKERROR == EMSGSIZE) {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_NETWORK, ("[socket] error reading: %s\n", gf_errno_str(LASTSOCKERROR)));
+				return GF_OUT_OF_MEM;
+			}
+			return gf_sk_batch_error("reading");
+		}
+		if (!res) return GF_IP_NETWORK_EMPTY;
+
+		for (i=0; i<(u32)res; i++) {
+			sizes[i] = msgs[i].msg_len;
+			if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_NETWORK, ("[socket] datagram larger than %u bytes, truncated\n", slot_size));
+			}
+		}
+		if (sock->flags & GF_SOCK_HAS_PEER)
+			sock->dest_addr_len = msgs[res-1].msg_hdr.msg_namelen;
+
+		*nb_read = (u32) res;
+		return GF_OK;
+	}
+#endif
+
+	for (i=0; i<nb_slots; i++) {
+		sizes[i] = 0;
+		e = gf_sk_receive_internal(sock, buffer + i*slot_size, slot_size, &sizes[i], GF_FALSE);
+		if (e) {
+			if (i) break;
+			return e;
+		}
+		(*nb_read)++;
+		//stream sockets, one read only
+		if (sock->flags & GF_SOCK_IS_TCP) break;
+	}
+	return GF_OK;
+}
+
+GF_EXPORT
+GF_Err gf_sk_send_batch(GF_Socket *sock, const u8 **buffers, const u32 *sizes, u32 nb_buffers, u32 *nb_sent)
+{
+	u32 i;
+	GF_Err e;
+	if (nb_sent) *nb_sent = 0;
+	if (!sock || !buffers || !sizes) return GF_BAD_PARAM;
+	if (!nb_buffers) return GF_OK;
+
+#ifdef GPAC_HAS_MMSG
+	if (sock->socket && !(sock->flags & GF_SOCK_IS_TCP)
+#ifndef GPAC_DISABLE_NETCAP
+		&& !sock->cap_info
+#endif
+	) {
+		struct mmsghdr msgs[GF_SK_MAX_BATCH];
+		struct iovec iovs[GF_SK_MAX_BATCH];
+#ifdef GPAC_HAS_TXTIME
+		char cbufs[GF_SK_MAX_BATCH][CMSG_SPACE(sizeof(u64))];
+#endif
+		u32 done = 0;
+
+		if (! (sock->flags & GF_SOCK_NON_BLOCKING)) {
+			e = poll_select(sock, GF_SK_SELECT_WRITE, sock->usec_wait, GF_FALSE);
+			if (e) return e;
+		}
+
+		while (done < nb_buffers) {
+			s32 res;
+			int sflags = 0;
+			u32 nb = nb_buffers - done;
+			if (nb > GF_SK_MAX_BATCH) nb = GF_SK_MAX_BATCH;
+
+			memset(msgs, 0, sizeof(struct mmsghdr)*nb);
+			for (i=0; i<nb; i++) {
+				iovs[i].iov_base = (void *) buffers[done+i];
+				iovs[i].iov_len = sizes[done+i];
+				msgs[i].msg_hdr.msg_iov = &iovs[i];
+				msgs[i].msg_hdr.msg_iovlen = 1;
+				if (sock->flags & GF_SOCK_HAS_PEER) {
+					msgs[i].msg_hdr.msg_name = &sock->dest_addr;
+					msgs[i].msg_hdr.msg_namelen = sock->dest_addr_len;
+				}
+				if (!sock->pace_rate) continue;
+#ifdef GPAC_HAS_TXTIME
+				if (sock->pace_flags & GF_SK_PACING_TXTIME) {
+					struct cmsghdr *cm;
+					u64 launch = sk_launch_time(sk_pacing_consume(sock, sizes[done+i]));
+					memset(cbufs[i], 0, sizeof(cbufs[i]));
+					msgs[i].msg_hdr.msg_control = cbufs[i];
+					msgs[i].msg_hdr.msg_controllen = sizeof(cbufs[i]);
+					cm = CMSG_FIRSTHDR(&msgs[i].msg_hdr);
+					cm->cmsg_level = SOL_SOCKET;
+					cm->cmsg_type = SCM_TXTIME;
+					cm->cmsg_len = CMSG_LEN(sizeof(u64));
+					memcpy(CMSG_DATA(cm), &launch, sizeof(u64));
+					continue;
+				}
+#endif
+				sk_pacing_consume(sock, sizes[done+i]);
+			}
+#ifdef MSG_NOSIGNAL
+			if (!(sock->flags & GF_SOCK_HAS_PEER))
+				sflags = MSG_NOSIGNAL;
+#endif
+			res = sendmmsg(sock->socket, msgs, nb, sflags);
+			//give back pacing budget of datagrams not sent
+			if (sock->pace_rate) {
+				for (i=(res>0) ? (u32) res : 0; i<nb; i++)
+					sock->pace_tokens += (s64) sizes[done+i] * GF_SK_PACE_SCALE;
+			}
+			if (res == SOCKET_ERROR) {
+				e = gf_sk_batch_error("sending");
+				if (nb_sent) *nb_sent = done;
+				return e;
+			}
+			done += (u32) res;
+		}
+		if (nb_sent) *nb_sent = done;
+		return GF_OK;
+	}
+#endif
+
+	for (i=0; i<nb_buffers; i++) {
+		e = gf_sk_send_ex(sock, buffers[i], sizes[i], NULL);
+		if (e) return e;
+		if (nb_sent) (*nb_sent)++;
+	}
+	return GF_OK;
+}
+
 GF_EXPORT
 GF_Err gf_sk_listen(GF_Socket *sock, u32 MaxConnection)
 {